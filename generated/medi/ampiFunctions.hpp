@@ -31,9 +31,13 @@
 #include "../../include/medi/ampi/async.hpp"
 #include "../../include/medi/ampi/message.hpp"
 #include "../../include/medi/ampi/reverseFunctions.hpp"
+#include "../../include/medi/ampi/reverseAggregation.hpp"
+#include "../../include/medi/ampi/reverseComm.hpp"
 #include "../../include/medi/ampi/forwardFunctions.hpp"
 #include "../../include/medi/ampi/primalFunctions.hpp"
+#include "../../include/medi/ampi/typeTraits.hpp"
 #include "../../include/medi/displacementTools.hpp"
+#include "../../include/medi/indexRanges.hpp"
 #include "../../include/medi/mpiTools.h"
 
 /**
@@ -45,6 +49,7 @@ namespace medi {
   struct AMPI_Bsend_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -76,7 +81,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Bsend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -92,7 +98,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Bsend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -111,7 +118,8 @@ namespace medi {
     AMPI_Bsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -120,7 +128,7 @@ namespace medi {
                  AMPI_Comm comm) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Bsend(buf, count, datatype->getMpiType(), dest, tag, comm);
     } else {
@@ -133,18 +141,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Bsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Bsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -170,7 +178,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -180,11 +188,13 @@ namespace medi {
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -200,6 +210,7 @@ namespace medi {
   struct AMPI_Ibsend_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -242,7 +253,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Ibsend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -254,7 +266,7 @@ namespace medi {
   void AMPI_Ibsend_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -267,7 +279,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Ibsend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -279,7 +292,7 @@ namespace medi {
   void AMPI_Ibsend_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -301,10 +314,11 @@ namespace medi {
   void AMPI_Ibsend_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -315,7 +329,7 @@ namespace medi {
                   AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ibsend(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -328,18 +342,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ibsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ibsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -365,7 +379,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -385,8 +399,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ibsend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Ibsend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ibsend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ibsend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -420,18 +435,21 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -468,7 +486,7 @@ namespace medi {
                       AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Bsend_init(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -481,7 +499,7 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
@@ -532,18 +550,18 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       int bufElements = 0;
 
       // recompute the total size of the buffer
       bufElements = count;
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ibsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ibsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -569,7 +587,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -577,8 +595,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ibsend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Ibsend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ibsend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ibsend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -611,13 +630,16 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
@@ -652,10 +674,10 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -671,6 +693,7 @@ namespace medi {
   struct AMPI_Imrecv_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
@@ -722,13 +745,15 @@ namespace medi {
   void AMPI_Imrecv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
 
@@ -748,10 +773,11 @@ namespace medi {
   void AMPI_Imrecv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -763,10 +789,12 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
 
     AMPI_Imrecv_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, &h->message, &h->requestReverse);
@@ -777,7 +805,7 @@ namespace medi {
   void AMPI_Imrecv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Imrecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Imrecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -789,7 +817,7 @@ namespace medi {
                   AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Imrecv(buf, count, datatype->getMpiType(), &message->message, &request->request);
     } else {
@@ -802,15 +830,15 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Imrecv_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Imrecv_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
 
@@ -825,7 +853,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
           datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
         }
@@ -843,7 +871,7 @@ namespace medi {
         h->message = *message;
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(buf, 0, count);
       }
 
@@ -861,8 +889,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Imrecv_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Imrecv_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Imrecv_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Imrecv_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -892,22 +921,25 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(buf, 0, h->bufIndices, h->bufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -923,6 +955,7 @@ namespace medi {
   struct AMPI_Irecv_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
@@ -979,13 +1012,15 @@ namespace medi {
   void AMPI_Irecv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
 
@@ -1006,10 +1041,11 @@ namespace medi {
   void AMPI_Irecv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -1021,10 +1057,12 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
 
     AMPI_Irecv_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm,
@@ -1036,7 +1074,7 @@ namespace medi {
   void AMPI_Irecv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irecv_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irecv_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1048,7 +1086,7 @@ namespace medi {
                  AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Irecv(buf, count, datatype->getMpiType(), source, tag, comm, &request->request);
     } else {
@@ -1061,15 +1099,15 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Irecv_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Irecv_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
 
@@ -1084,7 +1122,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
           datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
         }
@@ -1101,10 +1139,10 @@ namespace medi {
         h->datatype = datatype;
         h->source = source;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(buf, 0, count);
       }
 
@@ -1124,8 +1162,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Irecv_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Irecv_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Irecv_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Irecv_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -1159,22 +1198,25 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(buf, 0, h->bufIndices, h->bufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -1190,6 +1232,7 @@ namespace medi {
   struct AMPI_Irsend_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -1232,7 +1275,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Irsend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1244,7 +1288,7 @@ namespace medi {
   void AMPI_Irsend_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1257,7 +1301,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Irsend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1269,7 +1314,7 @@ namespace medi {
   void AMPI_Irsend_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1291,10 +1336,11 @@ namespace medi {
   void AMPI_Irsend_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Irsend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Irsend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -1305,7 +1351,7 @@ namespace medi {
                   AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Irsend(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -1318,18 +1364,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Irsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Irsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -1355,7 +1401,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -1375,8 +1421,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Irsend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Irsend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Irsend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Irsend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -1410,18 +1457,21 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -1437,6 +1487,7 @@ namespace medi {
   struct AMPI_Isend_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -1479,7 +1530,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Isend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1491,7 +1543,7 @@ namespace medi {
   void AMPI_Isend_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1504,7 +1556,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Isend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1516,7 +1569,7 @@ namespace medi {
   void AMPI_Isend_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1538,10 +1591,11 @@ namespace medi {
   void AMPI_Isend_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Isend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Isend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -1552,7 +1606,7 @@ namespace medi {
                  AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Isend(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -1565,18 +1619,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Isend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Isend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -1602,7 +1656,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -1622,8 +1676,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Isend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Isend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Isend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Isend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -1657,18 +1712,21 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -1684,6 +1742,7 @@ namespace medi {
   struct AMPI_Issend_AdjointHandle : public AsyncAdjointHandle {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -1726,7 +1785,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Issend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1738,7 +1798,7 @@ namespace medi {
   void AMPI_Issend_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
@@ -1751,7 +1811,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Issend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm,
@@ -1763,7 +1824,7 @@ namespace medi {
   void AMPI_Issend_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
@@ -1785,10 +1846,11 @@ namespace medi {
   void AMPI_Issend_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Issend_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Issend_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -1799,7 +1861,7 @@ namespace medi {
                   AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Issend(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -1812,18 +1874,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Issend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Issend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -1849,7 +1911,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -1869,8 +1931,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Issend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Issend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Issend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Issend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -1904,18 +1967,21 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -1931,6 +1997,7 @@ namespace medi {
   struct AMPI_Mrecv_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
@@ -1968,11 +2035,13 @@ namespace medi {
 
     AMPI_Mrecv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, &h->message, h->status);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
 
@@ -1987,7 +2056,8 @@ namespace medi {
     AMPI_Mrecv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, &h->message, h->status);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -1999,10 +2069,12 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
 
     AMPI_Mrecv_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, &h->message, h->status);
@@ -2015,7 +2087,7 @@ namespace medi {
                  AMPI_Status* status) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Mrecv(buf, count, datatype->getMpiType(), &message->message, status);
     } else {
@@ -2028,15 +2100,15 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Mrecv_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Mrecv_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
 
@@ -2051,7 +2123,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
           datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
         }
@@ -2070,25 +2142,27 @@ namespace medi {
         h->status = status;
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(buf, 0, count);
       }
 
       rStatus = MPI_Mrecv(bufMod, count, datatype->getModifiedMpiType(), &message->message, status);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(buf, 0, h->bufIndices, h->bufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -2104,6 +2178,7 @@ namespace medi {
   struct AMPI_Recv_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     typename DATATYPE::PrimalType* bufOldPrimals;
     /* required for async */ void* bufAdjoints;
@@ -2143,11 +2218,13 @@ namespace medi {
 
     AMPI_Recv_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm, &status);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufPrimals);
   }
 
@@ -2163,7 +2240,8 @@ namespace medi {
     AMPI_Recv_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm, &status);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -2176,10 +2254,12 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufIndices, h->bufOldPrimals, h->bufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufOldPrimals,
+                 h->bufTotalSize);
     }
 
     AMPI_Recv_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->source, h->tag, h->comm, &status);
@@ -2192,7 +2272,7 @@ namespace medi {
                 AMPI_Status* status) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Recv(buf, count, datatype->getMpiType(), source, tag, comm, status);
     } else {
@@ -2205,15 +2285,15 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Recv_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Recv_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
 
@@ -2228,7 +2308,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
           datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
         }
@@ -2245,28 +2325,30 @@ namespace medi {
         h->datatype = datatype;
         h->source = source;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(buf, 0, count);
       }
 
       rStatus = MPI_Recv(bufMod, count, datatype->getModifiedMpiType(), source, tag, comm, status);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(buf, 0, h->bufIndices, h->bufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -2303,7 +2385,7 @@ namespace medi {
                      AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Recv_init(buf, count, datatype->getMpiType(), source, tag, comm, &request->request);
     } else {
@@ -2316,7 +2398,7 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
@@ -2367,15 +2449,15 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       int bufElements = 0;
 
       // recompute the total size of the buffer
       bufElements = count;
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Irecv_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Irecv_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
 
@@ -2390,7 +2472,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufOldPrimals, h->bufTotalSize);
           datatype->getValues(buf, 0, h->bufOldPrimals, 0, count);
         }
@@ -2407,10 +2489,10 @@ namespace medi {
         h->datatype = datatype;
         h->source = source;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(buf, 0, count);
       }
 
@@ -2418,8 +2500,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Irecv_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Irecv_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Irecv_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Irecv_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -2452,17 +2535,20 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(buf, 0, h->bufIndices, h->bufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
@@ -2497,10 +2583,10 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -2516,6 +2602,7 @@ namespace medi {
   struct AMPI_Rsend_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -2547,7 +2634,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Rsend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -2563,7 +2651,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Rsend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -2582,7 +2671,8 @@ namespace medi {
     AMPI_Rsend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -2591,7 +2681,7 @@ namespace medi {
                  AMPI_Comm comm) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Rsend(buf, count, datatype->getMpiType(), dest, tag, comm);
     } else {
@@ -2604,18 +2694,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Rsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Rsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -2641,7 +2731,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -2651,11 +2741,13 @@ namespace medi {
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -2692,7 +2784,7 @@ namespace medi {
                       AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Rsend_init(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -2705,7 +2797,7 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
@@ -2756,18 +2848,18 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       int bufElements = 0;
 
       // recompute the total size of the buffer
       bufElements = count;
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Irsend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Irsend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -2793,7 +2885,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -2801,8 +2893,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Irsend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Irsend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Irsend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Irsend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -2835,13 +2928,16 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
@@ -2876,10 +2972,10 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -2895,6 +2991,7 @@ namespace medi {
   struct AMPI_Send_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -2926,7 +3023,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Send_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -2942,7 +3040,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Send_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -2961,7 +3060,8 @@ namespace medi {
     AMPI_Send_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -2970,7 +3070,7 @@ namespace medi {
                 AMPI_Comm comm) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Send(buf, count, datatype->getMpiType(), dest, tag, comm);
     } else {
@@ -2983,18 +3083,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Send_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Send_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -3020,7 +3120,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -3030,11 +3130,13 @@ namespace medi {
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -3071,7 +3173,7 @@ namespace medi {
                      AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Send_init(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -3084,7 +3186,7 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
@@ -3135,18 +3237,18 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       int bufElements = 0;
 
       // recompute the total size of the buffer
       bufElements = count;
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Isend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Isend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -3172,7 +3274,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -3180,8 +3282,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Isend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Isend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Isend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Isend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -3214,13 +3317,16 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
@@ -3255,10 +3361,10 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -3274,6 +3380,7 @@ namespace medi {
   struct AMPI_Sendrecv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -3284,6 +3391,7 @@ namespace medi {
     int sendtag;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -3333,18 +3441,21 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Sendrecv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype, h->dest,
                                           h->sendtag, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->source, h->recvtag, h->comm, &status);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
@@ -3361,7 +3472,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Sendrecv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype, h->dest,
@@ -3369,7 +3481,8 @@ namespace medi {
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -3383,10 +3496,12 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -3396,7 +3511,8 @@ namespace medi {
                                           h->sendtag, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->source, h->recvtag, h->comm, &status);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -3407,7 +3523,7 @@ namespace medi {
                     AMPI_Comm comm, AMPI_Status* status) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Sendrecv(sendbuf, sendcount, sendtype->getMpiType(), dest, sendtag, recvbuf, recvcount,
                              recvtype->getMpiType(), source, recvtag, comm, status);
@@ -3421,7 +3537,7 @@ namespace medi {
       // compute the total size of the buffer
       sendbufElements = sendcount;
 
-      if(sendtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(sendtype) ) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -3432,18 +3548,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = recvcount;
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Sendrecv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Sendrecv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
       }
 
@@ -3461,7 +3577,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
         }
@@ -3483,10 +3599,10 @@ namespace medi {
         h->recvtype = recvtype;
         h->source = source;
         h->recvtag = recvtag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         recvtype->clearIndices(recvbuf, 0, recvcount);
       }
 
@@ -3494,21 +3610,24 @@ namespace medi {
                              recvtype->getModifiedMpiType(), source, recvtag, comm, status);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(sendtype) ) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -3524,6 +3643,7 @@ namespace medi {
   struct AMPI_Ssend_AdjointHandle : public HandleBase {
     int bufTotalSize;
     typename DATATYPE::IndexType* bufIndices;
+    int bufIndicesRanges;
     typename DATATYPE::PrimalType* bufPrimals;
     /* required for async */ void* bufAdjoints;
     int bufCount;
@@ -3555,7 +3675,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->bufPrimals, h->bufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->bufIndices, h->bufPrimals, h->bufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufPrimals,
+               h->bufTotalSize);
 
 
     AMPI_Ssend_pri<DATATYPE>(h->bufPrimals, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -3571,7 +3692,8 @@ namespace medi {
     h->bufCountVec = adjointInterface->getVectorSize() * h->bufCount;
     adjointInterface->createAdjointTypeBuffer(h->bufAdjoints, h->bufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                h->bufTotalSize);
 
 
     AMPI_Ssend_fwd<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
@@ -3590,7 +3712,8 @@ namespace medi {
     AMPI_Ssend_adj<DATATYPE>(h->bufAdjoints, h->bufCountVec, h->count, h->datatype, h->dest, h->tag, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufIndices, h->bufAdjoints, h->bufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufAdjoints,
+                   h->bufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufAdjoints);
   }
 
@@ -3599,7 +3722,7 @@ namespace medi {
                  AMPI_Comm comm) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ssend(buf, count, datatype->getMpiType(), dest, tag, comm);
     } else {
@@ -3612,18 +3735,18 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ssend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ssend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -3649,7 +3772,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -3659,11 +3782,13 @@ namespace medi {
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -3700,7 +3825,7 @@ namespace medi {
                       AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ssend_init(buf, count, datatype->getMpiType(), dest, tag, comm, &request->request);
     } else {
@@ -3713,7 +3838,7 @@ namespace medi {
       // compute the total size of the buffer
       bufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufMod, bufElements);
       } else {
         bufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(buf));
@@ -3764,18 +3889,18 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       int bufElements = 0;
 
       // recompute the total size of the buffer
       bufElements = count;
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Issend_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Issend_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyIntoModifiedBuffer(buf, 0, bufMod, 0, count);
       }
 
@@ -3801,7 +3926,7 @@ namespace medi {
         h->datatype = datatype;
         h->dest = dest;
         h->tag = tag;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
 
@@ -3809,8 +3934,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Issend_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Issend_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Issend_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Issend_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -3843,13 +3969,16 @@ namespace medi {
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
 
       if(nullptr != h) {
         // handle the recv buffers
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufIndices, h->bufIndicesRanges, h->bufTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
@@ -3884,10 +4013,10 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufMod);
       }
 
@@ -3903,6 +4032,7 @@ namespace medi {
   struct AMPI_Allgather_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -3911,6 +4041,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -3957,18 +4088,21 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Allgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
                                            h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
@@ -3984,7 +4118,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Allgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -3992,7 +4127,8 @@ namespace medi {
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -4005,10 +4141,12 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -4019,7 +4157,8 @@ namespace medi {
 
     adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -4029,7 +4168,7 @@ namespace medi {
                      typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Allgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm);
     } else {
@@ -4046,7 +4185,7 @@ namespace medi {
         sendbufElements = recvcount;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -4057,18 +4196,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = recvcount * getCommSize(comm);
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -4095,7 +4234,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
@@ -4117,10 +4256,10 @@ namespace medi {
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
       }
 
@@ -4128,21 +4267,24 @@ namespace medi {
                               recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -4158,6 +4300,7 @@ namespace medi {
   struct AMPI_Allgatherv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -4166,6 +4309,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -4202,6 +4346,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -4212,28 +4360,29 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Allgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
                                             h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -4242,14 +4391,15 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -4257,10 +4407,9 @@ namespace medi {
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -4269,14 +4418,16 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -4287,11 +4438,10 @@ namespace medi {
 
     adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -4300,7 +4450,7 @@ namespace medi {
                       RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Allgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
                                recvtype->getMpiType(), comm);
@@ -4312,8 +4462,8 @@ namespace medi {
       int displsTotalSize = 0;
       if(nullptr != displs) {
         displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -4326,7 +4476,7 @@ namespace medi {
         sendbufElements = recvcounts[getCommRank(comm)];
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -4337,18 +4487,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = displsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -4378,7 +4528,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
@@ -4408,10 +4558,10 @@ namespace medi {
         h->recvcounts = recvcounts;
         h->displs = displs;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
         }
@@ -4421,7 +4571,7 @@ namespace medi {
                                recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
         }
@@ -4432,17 +4582,20 @@ namespace medi {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -4458,12 +4611,14 @@ namespace medi {
   struct AMPI_Allreduce_global_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
     int sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -4507,24 +4662,37 @@ namespace medi {
     (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Allreduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
                                         h->count, h->datatype, h->op, h->comm);
 
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
   }
 
   template<typename DATATYPE>
@@ -4540,15 +4708,22 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
 
     AMPI_Allreduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                         h->count, h->datatype, h->op, h->comm);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -4562,26 +4737,31 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
     convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints,
+                                              h->sendbufTotalSize * getAdjointCombineRanks(h->datatype, h->comm));
 
     AMPI_Allreduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                         h->count, h->datatype, h->op, h->comm);
 
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize,
+                                      getAdjointCombineRanks(h->datatype, h->comm));
     // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
     // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
     convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
                                 adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -4593,7 +4773,7 @@ namespace medi {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
     (void)convOp;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Allreduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm);
     } else {
@@ -4610,7 +4790,7 @@ namespace medi {
         sendbufElements = count;
       }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
@@ -4621,18 +4801,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Allreduce_global_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Allreduce_global_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
         } else {
@@ -4667,7 +4847,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
         }
@@ -4688,10 +4868,10 @@ namespace medi {
         h->count = count;
         h->datatype = datatype;
         h->op = op;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(recvbuf, 0, count);
       }
 
@@ -4699,13 +4879,16 @@ namespace medi {
                               comm);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
       // extract the primal values for the operator if required
       if(nullptr != h && convOp.requiresPrimal) {
@@ -4715,10 +4898,10 @@ namespace medi {
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -4734,6 +4917,7 @@ namespace medi {
   struct AMPI_Alltoall_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -4742,6 +4926,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -4788,18 +4973,21 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Alltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
                                           h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
@@ -4815,7 +5003,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Alltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -4823,7 +5012,8 @@ namespace medi {
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -4836,10 +5026,12 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -4849,7 +5041,8 @@ namespace medi {
                                           h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -4859,7 +5052,7 @@ namespace medi {
                     typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Alltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm);
     } else {
@@ -4876,7 +5069,7 @@ namespace medi {
         sendbufElements = recvcount * getCommSize(comm);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -4887,18 +5080,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = recvcount * getCommSize(comm);
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
         } else {
@@ -4924,7 +5117,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
@@ -4946,10 +5139,10 @@ namespace medi {
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
       }
 
@@ -4957,21 +5150,24 @@ namespace medi {
                              recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -4987,6 +5183,7 @@ namespace medi {
   struct AMPI_Alltoallv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int* sendbufCount;
@@ -4997,6 +5194,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -5021,6 +5219,10 @@ namespace medi {
         delete [] sendbufCount;
         sendbufCount = nullptr;
       }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
       if(nullptr != recvbufIndices) {
         recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
@@ -5037,6 +5239,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -5047,15 +5253,16 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
@@ -5063,16 +5270,14 @@ namespace medi {
                                            h->recvtype, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -5081,15 +5286,16 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
@@ -5097,13 +5303,10 @@ namespace medi {
                                            h->recvtype, h->comm);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -5112,17 +5315,19 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
@@ -5131,13 +5336,10 @@ namespace medi {
                                            h->recvtype, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -5146,7 +5348,7 @@ namespace medi {
                      MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Alltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts, rdispls,
                               recvtype->getMpiType(), comm);
@@ -5158,16 +5360,16 @@ namespace medi {
       int sdisplsTotalSize = 0;
       if(nullptr != sdispls) {
         sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          sdisplsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          sdisplsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
         }
       }
       MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
       int rdisplsTotalSize = 0;
       if(nullptr != rdispls) {
         rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          rdisplsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          rdisplsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -5180,7 +5382,7 @@ namespace medi {
         sendbufElements = rdisplsTotalSize;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -5191,18 +5393,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = rdisplsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
@@ -5232,7 +5434,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
@@ -5264,10 +5466,10 @@ namespace medi {
         h->recvcounts = recvcounts;
         h->rdispls = rdispls;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
         }
@@ -5277,7 +5479,7 @@ namespace medi {
                               rdisplsMod, recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
         }
@@ -5288,20 +5490,23 @@ namespace medi {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] sdisplsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(sdisplsMod);
       }
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] rdisplsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(rdisplsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -5317,12 +5522,14 @@ namespace medi {
   struct AMPI_Bcast_wrap_AdjointHandle : public HandleBase {
     int bufferSendTotalSize;
     typename DATATYPE::IndexType* bufferSendIndices;
+    int bufferSendIndicesRanges;
     typename DATATYPE::PrimalType* bufferSendPrimals;
     /* required for async */ void* bufferSendAdjoints;
     int bufferSendCount;
     int bufferSendCountVec;
     int bufferRecvTotalSize;
     typename DATATYPE::IndexType* bufferRecvIndices;
+    int bufferRecvIndicesRanges;
     typename DATATYPE::PrimalType* bufferRecvPrimals;
     typename DATATYPE::PrimalType* bufferRecvOldPrimals;
     /* required for async */ void* bufferRecvAdjoints;
@@ -5370,7 +5577,8 @@ namespace medi {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->bufferSendPrimals, h->bufferSendTotalSize );
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->bufferSendIndices, h->bufferSendPrimals, h->bufferSendTotalSize);
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                 h->bufferSendPrimals, h->bufferSendTotalSize);
 
     }
 
@@ -5380,11 +5588,13 @@ namespace medi {
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->bufferSendPrimals);
     }
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufferRecvIndices, h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                 h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufferRecvIndices, h->bufferRecvPrimals, h->bufferRecvTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+               h->bufferRecvPrimals, h->bufferRecvTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufferRecvPrimals);
   }
 
@@ -5400,7 +5610,8 @@ namespace medi {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
+      getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                  h->bufferSendAdjoints, h->bufferSendTotalSize);
 
     }
 
@@ -5411,7 +5622,8 @@ namespace medi {
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
     }
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                   h->bufferRecvAdjoints, h->bufferRecvTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufferRecvAdjoints);
   }
 
@@ -5423,24 +5635,29 @@ namespace medi {
     h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                h->bufferRecvAdjoints, h->bufferRecvTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufferRecvIndices, h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                 h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
     }
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
-      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize * getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints,
+                                                h->bufferSendTotalSize * getAdjointCombineRanks(h->datatype, h->comm));
     }
 
     AMPI_Bcast_wrap_adj<DATATYPE>(h->bufferSendAdjoints, h->bufferSendCountVec, h->bufferRecvAdjoints,
                                   h->bufferRecvCountVec, h->count, h->datatype, h->root, h->comm);
 
     if(h->root == getCommRank(h->comm)) {
-      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getCommSize(h->comm));
+      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize,
+                                        getAdjointCombineRanks(h->datatype, h->comm));
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
+      updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                     h->bufferSendAdjoints, h->bufferSendTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
     }
     adjointInterface->deleteAdjointTypeBuffer(h->bufferRecvAdjoints);
@@ -5451,7 +5668,7 @@ namespace medi {
                       DATATYPE* datatype, int root, AMPI_Comm comm) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Bcast_wrap(bufferSend, bufferRecv, count, datatype->getMpiType(), root, comm);
     } else {
@@ -5469,7 +5686,7 @@ namespace medi {
           bufferSendElements = count;
         }
 
-        if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == bufferSend)) {
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
           datatype->createModifiedTypeBuffer(bufferSendMod, bufferSendElements);
         } else {
           bufferSendMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferSend));
@@ -5481,19 +5698,19 @@ namespace medi {
       // compute the total size of the buffer
       bufferRecvElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufferRecvMod, bufferRecvElements);
       } else {
         bufferRecvMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferRecv));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Bcast_wrap_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Bcast_wrap_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(datatype)) {
           if(AMPI_IN_PLACE != bufferSend) {
             datatype->copyIntoModifiedBuffer(bufferSend, 0, bufferSendMod, 0, count);
           } else {
@@ -5522,7 +5739,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
           datatype->getValues(bufferRecv, 0, h->bufferRecvOldPrimals, 0, count);
         }
@@ -5545,33 +5762,38 @@ namespace medi {
         h->count = count;
         h->datatype = datatype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(bufferRecv, 0, count);
       }
 
       rStatus = MPI_Bcast_wrap(bufferSendMod, bufferRecvMod, count, datatype->getModifiedMpiType(), root, comm);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(bufferRecv, 0, bufferRecvMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(bufferRecv, 0, h->bufferRecvIndices, h->bufferRecvOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                        h->bufferSendTotalSize);
+        compressIndices(datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                        h->bufferRecvTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == bufferSend)) {
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
           datatype->deleteModifiedTypeBuffer(bufferSendMod);
         }
       }
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufferRecvMod);
       }
 
@@ -5587,6 +5809,7 @@ namespace medi {
   struct AMPI_Gather_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -5595,6 +5818,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -5643,21 +5867,24 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Gather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype, h->recvbufPrimals,
                                         h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     if(h->root == getCommRank(h->comm)) {
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
       adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
     }
   }
@@ -5675,7 +5902,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Gather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -5684,7 +5912,8 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
     }
   }
@@ -5698,12 +5927,14 @@ namespace medi {
       h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
 
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     h->sendbufAdjoints = nullptr;
@@ -5714,7 +5945,8 @@ namespace medi {
                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
@@ -5726,7 +5958,7 @@ namespace medi {
                   typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Gather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
                            comm);
@@ -5744,7 +5976,7 @@ namespace medi {
         sendbufElements = recvcount;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -5756,7 +5988,7 @@ namespace medi {
         // compute the total size of the buffer
         recvbufElements = recvcount * getCommSize(comm);
 
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
         } else {
           recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -5764,11 +5996,11 @@ namespace medi {
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Gather_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -5797,7 +6029,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           if(root == getCommRank(comm)) {
             recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
             if(root == getCommRank(comm)) {
@@ -5826,11 +6058,11 @@ namespace medi {
         h->recvcount = recvcount;
         h->recvtype = recvtype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
       if(root == getCommRank(comm)) {
-        if(!recvtype->isModifiedBufferRequired()) {
+        if(!isModifiedBufferRequired(recvtype)) {
           recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
         }
       }
@@ -5840,7 +6072,7 @@ namespace medi {
       recvtype->getADTool().addToolAction(h);
 
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(recvtype)) {
           recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
         }
       }
@@ -5850,15 +6082,18 @@ namespace medi {
         if(root == getCommRank(comm)) {
           recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->deleteModifiedTypeBuffer(recvbufMod);
         }
       }
@@ -5875,6 +6110,7 @@ namespace medi {
   struct AMPI_Gatherv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -5883,6 +6119,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -5920,6 +6157,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -5931,7 +6172,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
@@ -5939,24 +6180,25 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Gatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
                                          h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     if(h->root == getCommRank(h->comm)) {
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
       adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -5967,7 +6209,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
@@ -5975,7 +6217,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Gatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -5984,10 +6227,9 @@ namespace medi {
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -5998,16 +6240,18 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
 
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     h->sendbufAdjoints = nullptr;
@@ -6018,12 +6262,11 @@ namespace medi {
                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->root, h->comm);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -6033,7 +6276,7 @@ namespace medi {
                    AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Gatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs, recvtype->getMpiType(),
                             root, comm);
@@ -6045,8 +6288,8 @@ namespace medi {
       int displsTotalSize = 0;
       if(nullptr != displs) {
         displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -6059,7 +6302,7 @@ namespace medi {
         sendbufElements = recvcounts[getCommRank(comm)];
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -6071,7 +6314,7 @@ namespace medi {
         // compute the total size of the buffer
         recvbufElements = displsTotalSize;
 
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
         } else {
           recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -6079,11 +6322,11 @@ namespace medi {
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Gatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -6115,7 +6358,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           if(root == getCommRank(comm)) {
             recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
             if(root == getCommRank(comm)) {
@@ -6152,11 +6395,11 @@ namespace medi {
         h->displs = displs;
         h->recvtype = recvtype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
       if(root == getCommRank(comm)) {
-        if(!recvtype->isModifiedBufferRequired()) {
+        if(!isModifiedBufferRequired(recvtype)) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
           }
@@ -6168,7 +6411,7 @@ namespace medi {
       recvtype->getADTool().addToolAction(h);
 
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(recvtype)) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
           }
@@ -6182,18 +6425,21 @@ namespace medi {
             recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
           }
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->deleteModifiedTypeBuffer(recvbufMod);
         }
       }
@@ -6210,6 +6456,7 @@ namespace medi {
   struct AMPI_Iallgather_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -6218,6 +6465,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -6277,7 +6525,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Iallgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -6290,14 +6539,16 @@ namespace medi {
 
     AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
@@ -6313,7 +6564,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Iallgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -6326,11 +6578,12 @@ namespace medi {
 
     AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -6343,10 +6596,12 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -6362,11 +6617,12 @@ namespace medi {
 
     AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -6378,7 +6634,7 @@ namespace medi {
                       typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Iallgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm,
                                &request->request);
@@ -6396,7 +6652,7 @@ namespace medi {
         sendbufElements = recvcount;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -6407,18 +6663,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = recvcount * getCommSize(comm);
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -6445,7 +6701,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
@@ -6467,10 +6723,10 @@ namespace medi {
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
       }
 
@@ -6493,8 +6749,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iallgather_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iallgather_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallgather_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iallgather_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -6534,25 +6791,29 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -6568,6 +6829,7 @@ namespace medi {
   struct AMPI_Iallgatherv_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -6576,6 +6838,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -6612,6 +6875,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -6637,14 +6904,15 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Iallgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -6658,17 +6926,17 @@ namespace medi {
 
     AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -6677,14 +6945,15 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Iallgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -6698,14 +6967,13 @@ namespace medi {
 
     AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -6714,14 +6982,16 @@ namespace medi {
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -6738,15 +7008,14 @@ namespace medi {
 
     AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
       static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -6757,7 +7026,7 @@ namespace medi {
                        AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Iallgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
                                 recvtype->getMpiType(), comm, &request->request);
@@ -6769,8 +7038,8 @@ namespace medi {
       int displsTotalSize = 0;
       if(nullptr != displs) {
         displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -6783,7 +7052,7 @@ namespace medi {
         sendbufElements = recvcounts[getCommRank(comm)];
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -6794,18 +7063,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = displsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -6835,7 +7104,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
@@ -6865,10 +7134,10 @@ namespace medi {
         h->recvcounts = recvcounts;
         h->displs = displs;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
         }
@@ -6895,8 +7164,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iallgatherv_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iallgatherv_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iallgatherv_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -6940,11 +7210,12 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
         }
@@ -6955,17 +7226,20 @@ namespace medi {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -6981,12 +7255,14 @@ namespace medi {
   struct AMPI_Iallreduce_global_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
     int sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -7043,12 +7319,19 @@ namespace medi {
     (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Iallreduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
@@ -7061,17 +7344,23 @@ namespace medi {
 
     AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
   }
 
   template<typename DATATYPE>
@@ -7088,8 +7377,12 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
 
     AMPI_Iallreduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                          h->count, h->datatype, h->op, h->comm, &h->requestReverse);
@@ -7101,13 +7394,16 @@ namespace medi {
 
     AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -7122,15 +7418,18 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
     convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getCommSize(h->comm));
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints,
+                                              h->sendbufTotalSize * getAdjointCombineRanks(h->datatype, h->comm));
 
     AMPI_Iallreduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                          h->count, h->datatype, h->op, h->comm, &h->requestReverse);
@@ -7142,17 +7441,19 @@ namespace medi {
 
     AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
-    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getCommSize(h->comm));
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize,
+                                      getAdjointCombineRanks(h->datatype, h->comm));
     // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
     // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
     convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
                                 adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -7166,7 +7467,7 @@ namespace medi {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
     (void)convOp;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Iallreduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm,
                                &request->request);
@@ -7184,7 +7485,7 @@ namespace medi {
         sendbufElements = count;
       }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
@@ -7195,18 +7496,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Iallreduce_global_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Iallreduce_global_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
         } else {
@@ -7241,7 +7542,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
         }
@@ -7262,10 +7563,10 @@ namespace medi {
         h->count = count;
         h->datatype = datatype;
         h->op = op;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(recvbuf, 0, count);
       }
 
@@ -7287,8 +7588,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iallreduce_global_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Iallreduce_global_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallreduce_global_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Iallreduce_global_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -7326,19 +7628,23 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       AMPI_Op convOp = datatype->getADTool().convertOperator(op);
       (void)convOp;
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
       // extract the primal values for the operator if required
       if(nullptr != h && convOp.requiresPrimal) {
@@ -7348,10 +7654,10 @@ namespace medi {
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -7367,6 +7673,7 @@ namespace medi {
   struct AMPI_Ialltoall_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -7375,6 +7682,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -7434,7 +7742,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Ialltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -7447,14 +7756,16 @@ namespace medi {
 
     AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
@@ -7470,7 +7781,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Ialltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -7483,11 +7795,12 @@ namespace medi {
 
     AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
@@ -7500,10 +7813,12 @@ namespace medi {
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
@@ -7519,10 +7834,11 @@ namespace medi {
 
     AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
@@ -7534,7 +7850,7 @@ namespace medi {
                      typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ialltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm,
                               &request->request);
@@ -7552,7 +7868,7 @@ namespace medi {
         sendbufElements = recvcount * getCommSize(comm);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -7563,18 +7879,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = recvcount * getCommSize(comm);
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
         } else {
@@ -7600,7 +7916,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
@@ -7622,10 +7938,10 @@ namespace medi {
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
       }
 
@@ -7648,8 +7964,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ialltoall_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Ialltoall_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ialltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ialltoall_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -7689,25 +8006,29 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -7723,6 +8044,7 @@ namespace medi {
   struct AMPI_Ialltoallv_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int* sendbufCount;
@@ -7733,6 +8055,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -7757,6 +8080,10 @@ namespace medi {
         delete [] sendbufCount;
         sendbufCount = nullptr;
       }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
       if(nullptr != recvbufIndices) {
         recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
@@ -7773,6 +8100,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -7800,15 +8131,16 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Ialltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
@@ -7822,19 +8154,17 @@ namespace medi {
 
     AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -7843,15 +8173,16 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Ialltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
@@ -7865,16 +8196,13 @@ namespace medi {
 
     AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -7883,17 +8211,19 @@ namespace medi {
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
                                       adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
@@ -7908,16 +8238,13 @@ namespace medi {
 
     AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    delete [] h->sendbufCountVec;
-    delete [] h->sendbufDisplsVec;
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    delete [] h->recvbufCountVec;
-    delete [] h->recvbufDisplsVec;
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
@@ -7928,7 +8255,7 @@ namespace medi {
                       AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ialltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts, rdispls,
                                recvtype->getMpiType(), comm, &request->request);
@@ -7940,16 +8267,16 @@ namespace medi {
       int sdisplsTotalSize = 0;
       if(nullptr != sdispls) {
         sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          sdisplsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          sdisplsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
         }
       }
       MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
       int rdisplsTotalSize = 0;
       if(nullptr != rdispls) {
         rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          rdisplsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          rdisplsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -7962,7 +8289,7 @@ namespace medi {
         sendbufElements = rdisplsTotalSize;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -7973,18 +8300,18 @@ namespace medi {
       // compute the total size of the buffer
       recvbufElements = rdisplsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
@@ -8014,7 +8341,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
@@ -8046,10 +8373,10 @@ namespace medi {
         h->recvcounts = recvcounts;
         h->rdispls = rdispls;
         h->recvtype = recvtype;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
         }
@@ -8078,8 +8405,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ialltoallv_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Ialltoallv_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ialltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ialltoallv_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -8127,11 +8455,12 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(recvtype)) {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
         }
@@ -8142,20 +8471,23 @@ namespace medi {
         for(int i = 0; i < getCommSize(comm); ++i) {
           recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] sdisplsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(sdisplsMod);
       }
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] rdisplsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(rdisplsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -8171,12 +8503,14 @@ namespace medi {
   struct AMPI_Ibcast_wrap_AdjointHandle : public AsyncAdjointHandle {
     int bufferSendTotalSize;
     typename DATATYPE::IndexType* bufferSendIndices;
+    int bufferSendIndicesRanges;
     typename DATATYPE::PrimalType* bufferSendPrimals;
     /* required for async */ void* bufferSendAdjoints;
     int bufferSendCount;
     int bufferSendCountVec;
     int bufferRecvTotalSize;
     typename DATATYPE::IndexType* bufferRecvIndices;
+    int bufferRecvIndicesRanges;
     typename DATATYPE::PrimalType* bufferRecvPrimals;
     typename DATATYPE::PrimalType* bufferRecvOldPrimals;
     /* required for async */ void* bufferRecvAdjoints;
@@ -8236,7 +8570,8 @@ namespace medi {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createPrimalTypeBuffer((void*&)h->bufferSendPrimals, h->bufferSendTotalSize );
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->bufferSendIndices, h->bufferSendPrimals, h->bufferSendTotalSize);
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                 h->bufferSendPrimals, h->bufferSendTotalSize);
 
     }
 
@@ -8249,16 +8584,18 @@ namespace medi {
   void AMPI_Ibcast_wrap_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->bufferSendPrimals);
     }
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->bufferRecvIndices, h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                 h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->bufferRecvIndices, h->bufferRecvPrimals, h->bufferRecvTotalSize);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+               h->bufferRecvPrimals, h->bufferRecvTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->bufferRecvPrimals);
   }
 
@@ -8274,7 +8611,8 @@ namespace medi {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
       adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
+      getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                  h->bufferSendAdjoints, h->bufferSendTotalSize);
 
     }
 
@@ -8287,13 +8625,14 @@ namespace medi {
   void AMPI_Ibcast_wrap_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
     }
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                   h->bufferRecvAdjoints, h->bufferRecvTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->bufferRecvAdjoints);
   }
 
@@ -8305,15 +8644,18 @@ namespace medi {
     h->bufferRecvCountVec = adjointInterface->getVectorSize() * h->bufferRecvCount;
     adjointInterface->createAdjointTypeBuffer(h->bufferRecvAdjoints, h->bufferRecvTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->bufferRecvIndices, h->bufferRecvAdjoints, h->bufferRecvTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                h->bufferRecvAdjoints, h->bufferRecvTotalSize);
 
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->bufferRecvIndices, h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                 h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
     }
     h->bufferSendAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
       h->bufferSendCountVec = adjointInterface->getVectorSize() * h->bufferSendCount;
-      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints, h->bufferSendTotalSize * getCommSize(h->comm));
+      adjointInterface->createAdjointTypeBuffer(h->bufferSendAdjoints,
+                                                h->bufferSendTotalSize * getAdjointCombineRanks(h->datatype, h->comm));
     }
 
     AMPI_Ibcast_wrap_adj<DATATYPE>(h->bufferSendAdjoints, h->bufferSendCountVec, h->bufferRecvAdjoints,
@@ -8325,12 +8667,14 @@ namespace medi {
   void AMPI_Ibcast_wrap_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     if(h->root == getCommRank(h->comm)) {
-      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize, getCommSize(h->comm));
+      adjointInterface->combineAdjoints(h->bufferSendAdjoints, h->bufferSendTotalSize,
+                                        getAdjointCombineRanks(h->datatype, h->comm));
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->bufferSendIndices, h->bufferSendAdjoints, h->bufferSendTotalSize);
+      updateAdjoints(adjointInterface, h->datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                     h->bufferSendAdjoints, h->bufferSendTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->bufferSendAdjoints);
     }
     adjointInterface->deleteAdjointTypeBuffer(h->bufferRecvAdjoints);
@@ -8343,7 +8687,7 @@ namespace medi {
                        DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ibcast_wrap(bufferSend, bufferRecv, count, datatype->getMpiType(), root, comm, &request->request);
     } else {
@@ -8361,7 +8705,7 @@ namespace medi {
           bufferSendElements = count;
         }
 
-        if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == bufferSend)) {
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
           datatype->createModifiedTypeBuffer(bufferSendMod, bufferSendElements);
         } else {
           bufferSendMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferSend));
@@ -8373,19 +8717,19 @@ namespace medi {
       // compute the total size of the buffer
       bufferRecvElements = count;
 
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->createModifiedTypeBuffer(bufferRecvMod, bufferRecvElements);
       } else {
         bufferRecvMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferRecv));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(datatype)) {
           if(AMPI_IN_PLACE != bufferSend) {
             datatype->copyIntoModifiedBuffer(bufferSend, 0, bufferSendMod, 0, count);
           } else {
@@ -8414,7 +8758,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           datatype->getADTool().createPrimalTypeBuffer(h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
           datatype->getValues(bufferRecv, 0, h->bufferRecvOldPrimals, 0, count);
         }
@@ -8437,10 +8781,10 @@ namespace medi {
         h->count = count;
         h->datatype = datatype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!datatype->isModifiedBufferRequired()) {
+      if(!isModifiedBufferRequired(datatype)) {
         datatype->clearIndices(bufferRecv, 0, count);
       }
 
@@ -8462,8 +8806,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ibcast_wrap_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Ibcast_wrap_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ibcast_wrap_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ibcast_wrap_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -8500,27 +8845,33 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         datatype->copyFromModifiedBuffer(bufferRecv, 0, bufferRecvMod, 0, count);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
         datatype->registerValue(bufferRecv, 0, h->bufferRecvIndices, h->bufferRecvOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                        h->bufferSendTotalSize);
+        compressIndices(datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                        h->bufferRecvTotalSize);
       }
 
       datatype->getADTool().stopAssembly(h);
 
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == bufferSend)) {
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
           datatype->deleteModifiedTypeBuffer(bufferSendMod);
         }
       }
-      if(datatype->isModifiedBufferRequired() ) {
+      if(isModifiedBufferRequired(datatype) ) {
         datatype->deleteModifiedTypeBuffer(bufferRecvMod);
       }
 
@@ -8536,6 +8887,7 @@ namespace medi {
   struct AMPI_Igather_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -8544,6 +8896,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -8607,7 +8960,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Igather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -8620,17 +8974,19 @@ namespace medi {
 
     AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     if(h->root == getCommRank(h->comm)) {
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
       adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
     }
   }
@@ -8649,7 +9005,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Igather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -8662,12 +9019,13 @@ namespace medi {
 
     AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
     }
   }
@@ -8682,12 +9040,14 @@ namespace medi {
       h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
 
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     h->sendbufAdjoints = nullptr;
@@ -8704,10 +9064,11 @@ namespace medi {
 
     AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
@@ -8721,7 +9082,7 @@ namespace medi {
                    typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Igather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
                             comm, &request->request);
@@ -8739,7 +9100,7 @@ namespace medi {
         sendbufElements = recvcount;
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -8751,7 +9112,7 @@ namespace medi {
         // compute the total size of the buffer
         recvbufElements = recvcount * getCommSize(comm);
 
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
         } else {
           recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -8759,11 +9120,11 @@ namespace medi {
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -8792,7 +9153,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           if(root == getCommRank(comm)) {
             recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
             if(root == getCommRank(comm)) {
@@ -8821,11 +9182,11 @@ namespace medi {
         h->recvcount = recvcount;
         h->recvtype = recvtype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
       if(root == getCommRank(comm)) {
-        if(!recvtype->isModifiedBufferRequired()) {
+        if(!isModifiedBufferRequired(recvtype)) {
           recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
         }
       }
@@ -8850,8 +9211,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Igather_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Igather_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Igather_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Igather_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -8893,12 +9255,13 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(recvtype)) {
           recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
         }
       }
@@ -8908,15 +9271,18 @@ namespace medi {
         if(root == getCommRank(comm)) {
           recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->deleteModifiedTypeBuffer(recvbufMod);
         }
       }
@@ -8933,6 +9299,7 @@ namespace medi {
   struct AMPI_Igatherv_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -8941,6 +9308,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -8978,6 +9346,10 @@ namespace medi {
         delete [] recvbufCount;
         recvbufCount = nullptr;
       }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
@@ -9005,7 +9377,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     }
@@ -9013,7 +9385,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Igatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -9027,20 +9400,20 @@ namespace medi {
 
     AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     if(h->root == getCommRank(h->comm)) {
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
       adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -9051,7 +9424,7 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     }
@@ -9059,7 +9432,8 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
     AMPI_Igatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
@@ -9073,15 +9447,14 @@ namespace medi {
 
     AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -9092,16 +9465,18 @@ namespace medi {
 
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
+      updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommSize(h->comm),
                                         adjointInterface->getVectorSize());
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
 
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->recvtype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     h->sendbufAdjoints = nullptr;
@@ -9119,15 +9494,14 @@ namespace medi {
 
     AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-      delete [] h->recvbufCountVec;
-      delete [] h->recvbufDisplsVec;
     }
   }
 
@@ -9139,7 +9513,7 @@ namespace medi {
                     AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Igatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs, recvtype->getMpiType(),
                              root, comm, &request->request);
@@ -9151,8 +9525,8 @@ namespace medi {
       int displsTotalSize = 0;
       if(nullptr != displs) {
         displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
@@ -9165,7 +9539,7 @@ namespace medi {
         sendbufElements = recvcounts[getCommRank(comm)];
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
@@ -9177,7 +9551,7 @@ namespace medi {
         // compute the total size of the buffer
         recvbufElements = displsTotalSize;
 
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
         } else {
           recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
@@ -9185,11 +9559,11 @@ namespace medi {
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(sendtype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(sendtype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
         } else {
@@ -9221,7 +9595,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           if(root == getCommRank(comm)) {
             recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
             if(root == getCommRank(comm)) {
@@ -9258,11 +9632,11 @@ namespace medi {
         h->displs = displs;
         h->recvtype = recvtype;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
       if(root == getCommRank(comm)) {
-        if(!recvtype->isModifiedBufferRequired()) {
+        if(!isModifiedBufferRequired(recvtype)) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
           }
@@ -9291,8 +9665,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Igatherv_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Igatherv_d<SENDTYPE, RECVTYPE>, h);
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Igatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Igatherv_d<SENDTYPE, RECVTYPE>, h);
         recvtype->getADTool().addToolAction(waitH);
       }
     }
@@ -9338,12 +9713,13 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(recvtype)) {
 
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
       recvtype->getADTool().addToolAction(h);
 
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(recvtype)) {
           for(int i = 0; i < getCommSize(comm); ++i) {
             recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
           }
@@ -9357,18 +9733,21 @@ namespace medi {
             recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
           }
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
       }
 
-      if(sendtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
         sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
       if(root == getCommRank(comm)) {
-        if(recvtype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(recvtype) ) {
           recvtype->deleteModifiedTypeBuffer(recvbufMod);
         }
       }
@@ -9385,12 +9764,14 @@ namespace medi {
   struct AMPI_Ireduce_global_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
     typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
     int sendbufCountVec;
     int recvbufTotalSize;
     typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename DATATYPE::PrimalType* recvbufPrimals;
     typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -9449,13 +9830,20 @@ namespace medi {
     h->recvbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
       h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+      // the handle stores the primal values if the operator requires them, they are updated in place
+      if(!convOp.requiresPrimal) {
+        adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+      }
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
     AMPI_Ireduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
@@ -9467,20 +9855,26 @@ namespace medi {
   void AMPI_Ireduce_global_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     if(h->root == getCommRank(h->comm)) {
       // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
+      if(!convOp.requiresPrimal) {
+        adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+      }
     }
   }
 
@@ -9499,8 +9893,12 @@ namespace medi {
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
 
     AMPI_Ireduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
                                       h->count, h->datatype, h->op, h->root, h->comm, &h->requestReverse);
@@ -9511,14 +9909,17 @@ namespace medi {
   void AMPI_Ireduce_global_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
+      // the pre adjoint operation is applied after the sum of the tangents
+      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
     }
   }
@@ -9534,13 +9935,15 @@ namespace medi {
       h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
       adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
       // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+      getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
 
       convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     }
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
+    if(isOldPrimalsRequired(h->datatype)) {
       if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+        setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
       }
     }
     h->sendbufAdjoints = nullptr;
@@ -9556,7 +9959,7 @@ namespace medi {
   void AMPI_Ireduce_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
     AMPI_Ireduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_global_AdjointHandle<DATATYPE>*>(handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
     AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
     (void)convOp;
@@ -9565,7 +9968,8 @@ namespace medi {
     convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
                                 adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     if(h->root == getCommRank(h->comm)) {
       adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
@@ -9581,7 +9985,7 @@ namespace medi {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
     (void)convOp;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
       rStatus = MPI_Ireduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, root, comm,
                             &request->request);
@@ -9599,7 +10003,7 @@ namespace medi {
         sendbufElements = count;
       }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
         sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
@@ -9611,7 +10015,7 @@ namespace medi {
         // compute the total size of the buffer
         recvbufElements = count;
 
-        if(datatype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(datatype) ) {
           datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
         } else {
           recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
@@ -9619,11 +10023,11 @@ namespace medi {
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Ireduce_global_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ireduce_global_AdjointHandle<DATATYPE>();
       }
       datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
+      if(isModifiedBufferRequired(datatype)) {
         if(AMPI_IN_PLACE != sendbuf) {
           datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
         } else {
@@ -9660,7 +10064,7 @@ namespace medi {
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(datatype)) {
           if(root == getCommRank(comm)) {
             datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
             if(root == getCommRank(comm)) {
@@ -9688,11 +10092,11 @@ namespace medi {
         h->datatype = datatype;
         h->op = op;
         h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
       if(root == getCommRank(comm)) {
-        if(!datatype->isModifiedBufferRequired()) {
+        if(!isModifiedBufferRequired(datatype)) {
           datatype->clearIndices(recvbuf, 0, count);
         }
       }
@@ -9716,8 +10120,9 @@ namespace medi {
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Ireduce_global_b_finish<DATATYPE>,
-                                           (ForwardFunction)AMPI_Ireduce_global_d<DATATYPE>, h);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ireduce_global_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ireduce_global_d<DATATYPE>, h);
         datatype->getADTool().addToolAction(waitH);
       }
     }
@@ -9757,14 +10162,15 @@ namespace medi {
 
     delete asyncHandle;
 
-    if(datatype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
       AMPI_Op convOp = datatype->getADTool().convertOperator(op);
       (void)convOp;
+      recordReverseAggregationFlush(datatype->getADTool(), h);
       datatype->getADTool().addToolAction(h);
 
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()) {
+        if(isModifiedBufferRequired(datatype)) {
           datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
         }
       }
@@ -9774,6 +10180,9 @@ namespace medi {
         if(root == getCommRank(comm)) {
           datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
         }
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
       // extract the primal values for the operator if required
       if(nullptr != h && convOp.requiresPrimal) {
@@ -9787,11 +10196,11 @@ namespace medi {
 
       datatype->getADTool().stopAssembly(h);
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
         datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
       if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired() ) {
+        if(isModifiedBufferRequired(datatype) ) {
           datatype->deleteModifiedTypeBuffer(recvbufMod);
         }
       }
@@ -9804,393 +10213,395 @@ namespace medi {
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatter_AdjointHandle : public AsyncAdjointHandle {
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_global_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
-    typename SENDTYPE::IndexType* sendbufIndices;
-    typename SENDTYPE::PrimalType* sendbufPrimals;
+    typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
     int sendbufCountVec;
-    int sendcount;
-    SENDTYPE* sendtype;
     int recvbufTotalSize;
-    typename RECVTYPE::IndexType* recvbufIndices;
-    typename RECVTYPE::PrimalType* recvbufPrimals;
-    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
     int recvbufCountVec;
-    int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+    const  int* recvcounts;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
 
-    ~AMPI_Iscatter_AdjointHandle () {
+    ~AMPI_Ireduce_scatter_global_AdjointHandle () {
       if(nullptr != sendbufIndices) {
-        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
       }
       if(nullptr != sendbufPrimals) {
-        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
       if(nullptr != recvbufIndices) {
-        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
       }
       if(nullptr != recvbufPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
         recvbufPrimals = nullptr;
       }
       if(nullptr != recvbufOldPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
+      if(nullptr != recvcounts) {
+        delete [] recvcounts;
+        recvcounts = nullptr;
+      }
     }
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatter_AsyncHandle : public AsyncHandle {
-    typename SENDTYPE::Type* sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod;
-    int sendcount;
-    SENDTYPE* sendtype;
-    typename RECVTYPE::Type* recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod;
-    int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_global_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod;
+    typename DATATYPE::Type* recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod;
+    const  int* recvcounts;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
     AMPI_Request* request;
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
       adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
-
     }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
-    AMPI_Iscatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+
+    AMPI_Ireduce_scatter_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
+                                              h->recvcounts, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    if(!convOp.requiresPrimal) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
 
-    AMPI_Iscatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+    AMPI_Ireduce_scatter_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                              h->recvcounts, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    }
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Iscatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+    AMPI_Ireduce_scatter_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                              h->recvcounts, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter_finish(HandleBase* handle);
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter(typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
-                    int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_global_finish(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                  const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
-      rStatus = MPI_Iscatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
-                             comm, &request->request);
+      rStatus = MPI_Ireduce_scatter(sendbuf, recvbuf, recvcounts, datatype->getMpiType(), convOp.primalFunction, comm,
+                                    &request->request);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = sendcount * getCommSize(comm);
+      // compute the total size of the buffer
+      sendbufElements = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
       }
-      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcount;
-      }
+      recvbufElements = recvcounts[getCommRank(comm)];
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
-        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>();
       }
-      recvtype->getADTool().startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
-        }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
       }
 
       if(nullptr != h) {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          h->sendbufCount = sendtype->computeActiveElements(sendcount);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(sendcount);
-        }
-        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
-        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        h->sendbufCount = datatype->computeActiveElements(computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcounts[getCommRank(comm)]);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+        }
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
-          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
-          }
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcounts[getCommRank(comm)]);
         }
 
 
-        if(root == getCommRank(comm)) {
-          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
-        }
+        datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          sendtype->createIndices(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, 0, sendcount);
-        }
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcounts[getCommRank(comm)]);
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Iscatter_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Iscatter_d_finish<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Iscatter_p_finish<SENDTYPE, RECVTYPE>;
-        h->sendcount = sendcount;
-        h->sendtype = sendtype;
-        h->recvcount = recvcount;
-        h->recvtype = recvtype;
-        h->root = root;
-        h->comm = comm;
+        h->funcReverse = AMPI_Ireduce_scatter_global_b<DATATYPE>;
+        h->funcForward = AMPI_Ireduce_scatter_global_d_finish<DATATYPE>;
+        h->funcPrimal = AMPI_Ireduce_scatter_global_p_finish<DATATYPE>;
+        h->recvcounts = createCountsCopy(recvcounts, getCommSize(comm));
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          sendtype->clearIndices(sendbuf, sendcount * getCommRank(comm), sendcount);
-        }
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(recvbuf, 0, recvcounts[getCommRank(comm)]);
       }
 
-      rStatus = MPI_Iscatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                             recvtype->getModifiedMpiType(), root, comm, &request->request);
+      rStatus = MPI_Ireduce_scatter(sendbufMod, recvbufMod, recvcounts, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction,
+                                    comm, &request->request);
 
-      AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>();
+      AMPI_Ireduce_scatter_global_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Ireduce_scatter_global_AsyncHandle<DATATYPE>();
       asyncHandle->sendbuf = sendbuf;
       asyncHandle->sendbufMod = sendbufMod;
-      asyncHandle->sendcount = sendcount;
-      asyncHandle->sendtype = sendtype;
       asyncHandle->recvbuf = recvbuf;
       asyncHandle->recvbufMod = recvbufMod;
-      asyncHandle->recvcount = recvcount;
-      asyncHandle->recvtype = recvtype;
-      asyncHandle->root = root;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->datatype = datatype;
+      asyncHandle->op = op;
       asyncHandle->comm = comm;
       asyncHandle->toolHandle = h;
       request->handle = asyncHandle;
-      request->func = (ContinueFunction)AMPI_Iscatter_finish<SENDTYPE, RECVTYPE>;
+      request->func = (ContinueFunction)AMPI_Ireduce_scatter_global_finish<DATATYPE>;
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatter_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iscatter_d<SENDTYPE, RECVTYPE>, h);
-        recvtype->getADTool().addToolAction(waitH);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ireduce_scatter_global_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ireduce_scatter_global_d<DATATYPE>, h);
+        datatype->getADTool().addToolAction(waitH);
       }
     }
 
     return rStatus;
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatter_finish(HandleBase* handle) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_global_finish(HandleBase* handle) {
     int rStatus = 0;
 
-    AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
-      static_cast<AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
-    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
-    int sendcount = asyncHandle->sendcount;
-    SENDTYPE* sendtype = asyncHandle->sendtype;
-    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
-    int recvcount = asyncHandle->recvcount;
-    RECVTYPE* recvtype = asyncHandle->recvtype;
-    int root = asyncHandle->root;
+    AMPI_Ireduce_scatter_global_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Ireduce_scatter_global_AsyncHandle<DATATYPE>*>
+        (handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
     AMPI_Comm comm = asyncHandle->comm;
     AMPI_Request* request = asyncHandle->request;
-    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_global_AdjointHandle<DATATYPE>*>
         (asyncHandle->toolHandle);
     MEDI_UNUSED(h); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
-    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
-    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
     MEDI_UNUSED(comm); // Unused generated to ignore warnings
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
-      recvtype->getADTool().addToolAction(h);
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      (void)convOp;
+      recordReverseAggregationFlush(datatype->getADTool(), h);
+      datatype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          sendtype->copyFromModifiedBuffer(sendbuf, sendcount * getCommRank(comm), sendbufMod, sendcount * getCommRank(comm),
-                                           sendcount);
-        }
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcounts[getCommRank(comm)]);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          sendtype->registerValue(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, h->recvbufOldPrimals, 0, sendcount);
-        }
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcounts[getCommRank(comm)]);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcounts[getCommRank(comm)]);
       }
 
-      recvtype->getADTool().stopAssembly(h);
+      datatype->getADTool().stopAssembly(h);
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
       // handle is deleted by the AD tool
@@ -10201,450 +10612,391 @@ namespace medi {
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatterv_AdjointHandle : public AsyncAdjointHandle {
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_block_global_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
-    typename SENDTYPE::IndexType* sendbufIndices;
-    typename SENDTYPE::PrimalType* sendbufPrimals;
+    typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename DATATYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
-    int* sendbufCount;
-    /* required for async */ int* sendbufCountVec;
-    /* required for async */ int* sendbufDisplsVec;
-    const  int* sendcounts;
-    const  int* displs;
-    SENDTYPE* sendtype;
+    int sendbufCount;
+    int sendbufCountVec;
     int recvbufTotalSize;
-    typename RECVTYPE::IndexType* recvbufIndices;
-    typename RECVTYPE::PrimalType* recvbufPrimals;
-    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
     int recvbufCountVec;
     int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
 
-    ~AMPI_Iscatterv_AdjointHandle () {
+    ~AMPI_Ireduce_scatter_block_global_AdjointHandle () {
       if(nullptr != sendbufIndices) {
-        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
       }
       if(nullptr != sendbufPrimals) {
-        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
-      if(nullptr != sendbufCount) {
-        delete [] sendbufCount;
-        sendbufCount = nullptr;
-      }
       if(nullptr != recvbufIndices) {
-        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
       }
       if(nullptr != recvbufPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
         recvbufPrimals = nullptr;
       }
       if(nullptr != recvbufOldPrimals) {
-        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
     }
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Iscatterv_AsyncHandle : public AsyncHandle {
-    typename SENDTYPE::Type* sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod;
-    const int* displsMod;
-    const  int* sendcounts;
-    const  int* displs;
-    SENDTYPE* sendtype;
-    typename RECVTYPE::Type* recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod;
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_block_global_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod;
+    typename DATATYPE::Type* recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod;
     int recvcount;
-    RECVTYPE* recvtype;
-    int root;
+    DATATYPE* datatype;
+    AMPI_Op op;
     AMPI_Comm comm;
     AMPI_Request* request;
   };
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
       adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
-
     }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
-    AMPI_Iscatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+
+    AMPI_Ireduce_scatter_block_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
+                                                    h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    if(!convOp.requiresPrimal) {
       adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
     }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
 
-    AMPI_Iscatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+    AMPI_Ireduce_scatter_block_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                                    h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
 
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    }
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Iscatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
-                                           &h->requestReverse);
+    AMPI_Ireduce_scatter_block_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                                    h->recvcount, h->datatype, h->op, h->comm, &h->requestReverse);
 
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Iscatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
 
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (handle);
-    MPI_Wait(&h->requestReverse.request, MPI_STATUS_IGNORE);
+    waitReverse(&h->requestReverse);
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv_finish(HandleBase* handle);
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv(typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
-                     typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_block_global_finish(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_block_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                        int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       // call the regular function if the type is not active
-      rStatus = MPI_Iscatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
-                              root, comm, &request->request);
+      rStatus = MPI_Ireduce_scatter_block(sendbuf, recvbuf, recvcount, datatype->getMpiType(), convOp.primalFunction, comm,
+                                          &request->request);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      MEDI_OPTIONAL_CONST int* displsMod = displs;
-      int displsTotalSize = 0;
-      if(nullptr != displs) {
-        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
-        }
-      }
-      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = displsTotalSize;
+      // compute the total size of the buffer
+      sendbufElements = recvcount * getCommSize(comm);
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
       }
-      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcounts[getCommRank(comm)];
-      }
+      recvbufElements = recvcount;
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
-        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>();
       }
-      recvtype->getADTool().startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
-          }
-        }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, recvcount * getCommSize(comm));
       }
 
       if(nullptr != h) {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
-                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
-        }
-        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
-        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        h->sendbufCount = datatype->computeActiveElements(recvcount);
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, recvcount * getCommSize(comm));
+        }
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
-          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            {
-              const int rank = getCommRank(comm);
-              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
-            }
-          }
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
         }
 
 
-        if(root == getCommRank(comm)) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
-          }
-        }
+        datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, recvcount * getCommSize(comm));
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->createIndices(sendbuf, displs[rank], h->recvbufIndices, 0, sendcounts[rank]);
-          }
-        }
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Iscatterv_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Iscatterv_d_finish<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Iscatterv_p_finish<SENDTYPE, RECVTYPE>;
-        h->sendcounts = sendcounts;
-        h->displs = displs;
-        h->sendtype = sendtype;
+        h->funcReverse = AMPI_Ireduce_scatter_block_global_b<DATATYPE>;
+        h->funcForward = AMPI_Ireduce_scatter_block_global_d_finish<DATATYPE>;
+        h->funcPrimal = AMPI_Ireduce_scatter_block_global_p_finish<DATATYPE>;
         h->recvcount = recvcount;
-        h->recvtype = recvtype;
-        h->root = root;
-        h->comm = comm;
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->clearIndices(sendbuf, displs[rank], sendcounts[rank]);
-          }
-        }
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(recvbuf, 0, recvcount);
       }
 
-      rStatus = MPI_Iscatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                              recvtype->getModifiedMpiType(), root, comm, &request->request);
+      rStatus = MPI_Ireduce_scatter_block(sendbufMod, recvbufMod, recvcount, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction,
+                                          comm, &request->request);
 
-      AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      AMPI_Ireduce_scatter_block_global_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Ireduce_scatter_block_global_AsyncHandle<DATATYPE>();
       asyncHandle->sendbuf = sendbuf;
       asyncHandle->sendbufMod = sendbufMod;
-      asyncHandle->displsMod = displsMod;
-      asyncHandle->sendcounts = sendcounts;
-      asyncHandle->displs = displs;
-      asyncHandle->sendtype = sendtype;
       asyncHandle->recvbuf = recvbuf;
       asyncHandle->recvbufMod = recvbufMod;
       asyncHandle->recvcount = recvcount;
-      asyncHandle->recvtype = recvtype;
-      asyncHandle->root = root;
+      asyncHandle->datatype = datatype;
+      asyncHandle->op = op;
       asyncHandle->comm = comm;
       asyncHandle->toolHandle = h;
       request->handle = asyncHandle;
-      request->func = (ContinueFunction)AMPI_Iscatterv_finish<SENDTYPE, RECVTYPE>;
+      request->func = (ContinueFunction)AMPI_Ireduce_scatter_block_global_finish<DATATYPE>;
 
       // create adjoint wait
       if(nullptr != h) {
-        WaitHandle* waitH = new WaitHandle((ReverseFunction)AMPI_Iscatterv_b_finish<SENDTYPE, RECVTYPE>,
-                                           (ForwardFunction)AMPI_Iscatterv_d<SENDTYPE, RECVTYPE>, h);
-        recvtype->getADTool().addToolAction(waitH);
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ireduce_scatter_block_global_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ireduce_scatter_block_global_d<DATATYPE>, h);
+        datatype->getADTool().addToolAction(waitH);
       }
     }
 
     return rStatus;
   }
 
-  template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Iscatterv_finish(HandleBase* handle) {
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_block_global_finish(HandleBase* handle) {
     int rStatus = 0;
 
-    AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
-      static_cast<AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
-    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
-    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
-    const int* displsMod = asyncHandle->displsMod;
-    const  int* sendcounts = asyncHandle->sendcounts;
-    const  int* displs = asyncHandle->displs;
-    SENDTYPE* sendtype = asyncHandle->sendtype;
-    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
-    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    AMPI_Ireduce_scatter_block_global_AsyncHandle<DATATYPE>* asyncHandle = static_cast<AMPI_Ireduce_scatter_block_global_AsyncHandle<DATATYPE>*>
+        (handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
     int recvcount = asyncHandle->recvcount;
-    RECVTYPE* recvtype = asyncHandle->recvtype;
-    int root = asyncHandle->root;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
     AMPI_Comm comm = asyncHandle->comm;
     AMPI_Request* request = asyncHandle->request;
-    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+    AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_block_global_AdjointHandle<DATATYPE>*>
         (asyncHandle->toolHandle);
     MEDI_UNUSED(h); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
-    MEDI_UNUSED(displs); // Unused generated to ignore warnings
-    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
     MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
     MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
-    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
-    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
     MEDI_UNUSED(comm); // Unused generated to ignore warnings
     MEDI_UNUSED(request); // Unused generated to ignore warnings
 
     delete asyncHandle;
 
-    if(recvtype->getADTool().isActiveType()) {
+    if(isActiveType(datatype)) {
 
-      recvtype->getADTool().addToolAction(h);
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      (void)convOp;
+      recordReverseAggregationFlush(datatype->getADTool(), h);
+      datatype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->copyFromModifiedBuffer(sendbuf, displs[rank], sendbufMod, displsMod[rank], sendcounts[rank]);
-          }
-        }
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->registerValue(sendbuf, displs[rank], h->recvbufIndices, h->recvbufOldPrimals, 0, sendcounts[rank]);
-          }
-        }
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
-
-      recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcount);
       }
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      datatype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
-        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
       // handle is deleted by the AD tool
@@ -10654,312 +11006,8091 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  template<typename DATATYPE>
-  struct AMPI_Reduce_global_AdjointHandle : public HandleBase {
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatter_AdjointHandle : public AsyncAdjointHandle {
     int sendbufTotalSize;
-    typename DATATYPE::IndexType* sendbufIndices;
-    typename DATATYPE::PrimalType* sendbufPrimals;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
     int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
     int recvbufTotalSize;
-    typename DATATYPE::IndexType* recvbufIndices;
-    typename DATATYPE::PrimalType* recvbufPrimals;
-    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
     int recvbufCount;
     int recvbufCountVec;
-    int count;
-    DATATYPE* datatype;
-    AMPI_Op op;
+    int recvcount;
+    RECVTYPE* recvtype;
     int root;
     AMPI_Comm comm;
 
-    ~AMPI_Reduce_global_AdjointHandle () {
+    ~AMPI_Iscatter_AdjointHandle () {
       if(nullptr != sendbufIndices) {
-        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
       }
       if(nullptr != sendbufPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
         sendbufPrimals = nullptr;
       }
       if(nullptr != recvbufIndices) {
-        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
       }
       if(nullptr != recvbufPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
         recvbufPrimals = nullptr;
       }
       if(nullptr != recvbufOldPrimals) {
-        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
     }
   };
 
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatter_AsyncHandle : public AsyncHandle {
+    typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
 
-    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
     if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                 h->sendbufPrimals, h->sendbufTotalSize);
+
     }
-    h->sendbufAdjoints = nullptr;
-    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+
+    AMPI_Iscatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                  h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Iscatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+    AMPI_Iscatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                          h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatter_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                     h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatter_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatter(typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
+                    int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Iscatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
+                             comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = sendcount * getCommSize(comm);
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcount;
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(sendcount);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          sendtype->createIndices(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, 0, sendcount);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iscatter_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatter_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatter_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          sendtype->clearIndices(sendbuf, sendcount * getCommRank(comm), sendcount);
+        }
+      }
+
+      rStatus = MPI_Iscatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                             recvtype->getModifiedMpiType(), root, comm, &request->request);
+
+      AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Iscatter_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iscatter_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iscatter_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatter_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Iscatter_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          sendtype->copyFromModifiedBuffer(sendbuf, sendcount * getCommRank(comm), sendbufMod, sendcount * getCommRank(comm),
+                                           sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          sendtype->registerValue(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, h->recvbufOldPrimals, 0, sendcount);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatterv_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Iscatterv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Iscatterv_AsyncHandle : public AsyncHandle {
+    typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* displsMod;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                 h->sendbufPrimals, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Iscatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                  h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Iscatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+    AMPI_Iscatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                           h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm,
+                                           &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Iscatterv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                     h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv(typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
+                     typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Iscatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                              root, comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = displsTotalSize;
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcounts[getCommRank(comm)];
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
+                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            {
+              const int rank = getCommRank(comm);
+              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+            }
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+          }
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->createIndices(sendbuf, displs[rank], h->recvbufIndices, 0, sendcounts[rank]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iscatterv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatterv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatterv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->displs = displs;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->clearIndices(sendbuf, displs[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      rStatus = MPI_Iscatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                              recvtype->getModifiedMpiType(), root, comm, &request->request);
+
+      AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Iscatterv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iscatterv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iscatterv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Iscatterv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Iscatterv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* displs = asyncHandle->displs;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->copyFromModifiedBuffer(sendbuf, displs[rank], sendbufMod, displsMod[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->registerValue(sendbuf, displs[rank], h->recvbufIndices, h->recvbufOldPrimals, 0, sendcounts[rank]);
+          }
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Reduce_global_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename DATATYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int recvbufTotalSize;
+    typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int count;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Reduce_global_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      // the handle stores the primal values if the operator requires them, they are updated in place
+      if(!convOp.requiresPrimal) {
+        adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+      }
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec, h->count,
+                                     h->datatype, h->op, h->root, h->comm);
+
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      if(h->root == getCommRank(h->comm)) {
+        getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
+      }
+    }
+    if(h->root == getCommRank(h->comm)) {
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufPrimals, h->recvbufTotalSize);
+      if(!convOp.requiresPrimal) {
+        adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+      }
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+
+    AMPI_Reduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                     h->count, h->datatype, h->op, h->root, h->comm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    if(h->root == getCommRank(h->comm)) {
+      // the pre adjoint operation is applied after the sum of the tangents
+      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                     h->recvbufAdjoints, h->recvbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                  h->recvbufAdjoints, h->recvbufTotalSize);
+
+      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      if(h->root == getCommRank(h->comm)) {
+        setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufOldPrimals, h->recvbufTotalSize);
+      }
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Reduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                     h->count, h->datatype, h->op, h->root, h->comm);
+
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    }
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Reduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                         int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+    int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
+
+    if(!isActiveType(datatype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Reduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, root, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = count;
+      } else {
+        sendbufElements = count;
+      }
+
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        recvbufElements = count;
+
+        if(isModifiedBufferRequired(datatype) ) {
+          datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+        } else {
+          recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+        }
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Reduce_global_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
+        } else {
+          datatype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        } else {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        }
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        if(root == getCommRank(comm)) {
+          h->recvbufCount = datatype->computeActiveElements(count);
+          h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+          datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        }
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          if(AMPI_IN_PLACE != sendbuf) {
+            datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
+          } else {
+            datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
+          }
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(datatype)) {
+          if(root == getCommRank(comm)) {
+            datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+            if(root == getCommRank(comm)) {
+              datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
+            }
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
+        } else {
+          datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
+        }
+
+        if(root == getCommRank(comm)) {
+          datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Reduce_global_b<DATATYPE>;
+        h->funcForward = AMPI_Reduce_global_d<DATATYPE>;
+        h->funcPrimal = AMPI_Reduce_global_p<DATATYPE>;
+        h->count = count;
+        h->datatype = datatype;
+        h->op = op;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(!isModifiedBufferRequired(datatype)) {
+          datatype->clearIndices(recvbuf, 0, count);
+        }
+      }
+
+      rStatus = MPI_Reduce(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, root,
+                           comm);
+      datatype->getADTool().addToolAction(h);
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(datatype)) {
+          datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(root == getCommRank(comm)) {
+          datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+        }
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        if(root == getCommRank(comm)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+          if(root == getCommRank(comm)) {
+            datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
+          }
+        }
+      }
+
+      datatype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(datatype) ) {
+          datatype->deleteModifiedTypeBuffer(recvbufMod);
+        }
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Reduce_scatter_global_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename DATATYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int recvbufTotalSize;
+    typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    const  int* recvcounts;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    AMPI_Comm comm;
+
+    ~AMPI_Reduce_scatter_global_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvcounts) {
+        delete [] recvcounts;
+        recvcounts = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_scatter_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
+                                             h->recvcounts, h->datatype, h->op, h->comm);
+
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+
+    AMPI_Reduce_scatter_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                             h->recvcounts, h->datatype, h->op, h->comm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Reduce_scatter_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                             h->recvcounts, h->datatype, h->op, h->comm);
+
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                 const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
+
+    if(!isActiveType(datatype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Reduce_scatter(sendbuf, recvbuf, recvcounts, datatype->getMpiType(), convOp.primalFunction, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcounts[getCommRank(comm)];
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Reduce_scatter_global_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = datatype->computeActiveElements(computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcounts[getCommRank(comm)]);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcounts[getCommRank(comm)]);
+        }
+
+
+        datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)));
+
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcounts[getCommRank(comm)]);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Reduce_scatter_global_b<DATATYPE>;
+        h->funcForward = AMPI_Reduce_scatter_global_d<DATATYPE>;
+        h->funcPrimal = AMPI_Reduce_scatter_global_p<DATATYPE>;
+        h->recvcounts = createCountsCopy(recvcounts, getCommSize(comm));
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(recvbuf, 0, recvcounts[getCommRank(comm)]);
+      }
+
+      rStatus = MPI_Reduce_scatter(sendbufMod, recvbufMod, recvcounts, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction,
+                                   comm);
+      datatype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcounts[getCommRank(comm)]);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcounts[getCommRank(comm)]);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcounts[getCommRank(comm)]);
+      }
+
+      datatype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Reduce_scatter_block_global_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename DATATYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename DATATYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int recvbufTotalSize;
+    typename DATATYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename DATATYPE::PrimalType* recvbufPrimals;
+    typename DATATYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    AMPI_Comm comm;
+
+    ~AMPI_Reduce_scatter_block_global_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        datatype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        datatype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    // the handle stores the primal values if the operator requires them, they are updated in place
+    if(!convOp.requiresPrimal) {
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Reduce_scatter_block_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec,
+                                                   h->recvcount, h->datatype, h->op, h->comm);
+
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->datatype)) {
+      getPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    if(!convOp.requiresPrimal) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    }
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+    // the tangents use the transposed adjoint operations, the post adjoint operation is applied before the sum
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+
+    AMPI_Reduce_scatter_block_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                                   h->recvcount, h->datatype, h->op, h->comm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // the pre adjoint operation is applied after the sum of the tangents
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>*>(handle);
+
+    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
+    (void)convOp;
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
+    if(isOldPrimalsRequired(h->datatype)) {
+      setPrimals(adjointInterface, h->datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Reduce_scatter_block_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
+                                                   h->recvcount, h->datatype, h->op, h->comm);
+
+    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
+    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
+    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
+                                adjointInterface->getVectorSize());
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_block_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                       int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
+
+    if(!isActiveType(datatype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Reduce_scatter_block(sendbuf, recvbuf, recvcount, datatype->getMpiType(), convOp.primalFunction, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = recvcount * getCommSize(comm);
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount;
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Reduce_scatter_block_global_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, recvcount * getCommSize(comm));
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = datatype->computeActiveElements(recvcount);
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, recvcount * getCommSize(comm));
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+        }
+
+
+        datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, recvcount * getCommSize(comm));
+
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Reduce_scatter_block_global_b<DATATYPE>;
+        h->funcForward = AMPI_Reduce_scatter_block_global_d<DATATYPE>;
+        h->funcPrimal = AMPI_Reduce_scatter_block_global_p<DATATYPE>;
+        h->recvcount = recvcount;
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(recvbuf, 0, recvcount);
+      }
+
+      rStatus = MPI_Reduce_scatter_block(sendbufMod, recvbufMod, recvcount, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction,
+                                         comm);
+      datatype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, recvcount);
+      }
+
+      datatype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatter_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Scatter_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                 h->sendbufPrimals, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                  h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+    AMPI_Scatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                     h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter(typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
+                   int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
+                            comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = sendcount * getCommSize(comm);
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcount;
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(sendcount);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          sendtype->createIndices(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, 0, sendcount);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Scatter_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Scatter_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Scatter_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          sendtype->clearIndices(sendbuf, sendcount * getCommRank(comm), sendcount);
+        }
+      }
+
+      rStatus = MPI_Scatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                            recvtype->getModifiedMpiType(), root, comm);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          sendtype->copyFromModifiedBuffer(sendbuf, sendcount * getCommRank(comm), sendbufMod, sendcount * getCommRank(comm),
+                                           sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          sendtype->registerValue(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, h->recvbufOldPrimals, 0, sendcount);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatterv_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+
+    ~AMPI_Scatterv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+      // Primal buffers are always linear in space so we can accesses them in one sweep
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                 h->sendbufPrimals, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    }
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                  h->sendbufAdjoints, h->sendbufTotalSize);
+
+    }
+
+    AMPI_Scatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Scatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    if(h->root == getCommRank(h->comm)) {
+      updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
+                                        adjointInterface->getVectorSize());
+      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    }
+
+    AMPI_Scatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+
+    if(h->root == getCommRank(h->comm)) {
+      // Adjoint buffers are always linear in space so we can accesses them in one sweep
+      updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                     h->sendbufAdjoints, h->sendbufTotalSize);
+      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv(typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
+                    typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                             root, comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = displsTotalSize;
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcounts[getCommRank(comm)];
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
+                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            {
+              const int rank = getCommRank(comm);
+              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+            }
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+          }
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->createIndices(sendbuf, displs[rank], h->recvbufIndices, 0, sendcounts[rank]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Scatterv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Scatterv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Scatterv_p<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->displs = displs;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->clearIndices(sendbuf, displs[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      rStatus = MPI_Scatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                             recvtype->getModifiedMpiType(), root, comm);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->copyFromModifiedBuffer(sendbuf, displs[rank], sendbufMod, displsMod[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->registerValue(sendbuf, displs[rank], h->recvbufIndices, h->recvbufOldPrimals, 0, sendcounts[rank]);
+          }
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Allgather_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                          typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm,
+                          AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Allgather_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                   recvtype->getMpiType(), comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcount;
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommSize(comm);
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Allgather_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                   recvtype->getModifiedMpiType(), comm, info, &request->request);
+
+      AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Allgather_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Allgather_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Allgather_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcount;
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      recvbufElements = recvcount * getCommSize(comm);
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        } else {
+          recvtype->copyIntoModifiedBuffer(recvbuf, recvcount * getCommRank(comm), recvbufMod, recvcount * getCommRank(comm),
+                                           recvcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        } else {
+          h->sendbufCount = recvtype->computeActiveElements(recvcount);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        } else {
+          recvtype->getIndices(recvbuf, recvcount * getCommRank(comm), h->sendbufIndices, 0, recvcount);
+        }
+
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommSize(comm));
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iallgather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iallgather_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iallgather_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallgather_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iallgather_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iallgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Allgatherv_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* displsMod;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                           typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs,
+                           RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Allgatherv_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                    recvtype->getMpiType(), comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcounts[getCommRank(comm)];
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = displsTotalSize;
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Allgatherv_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcounts,
+                                    displsMod, recvtype->getModifiedMpiType(), comm, info, &request->request);
+
+      AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Allgatherv_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Allgatherv_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Allgatherv_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+      }
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcounts[getCommRank(comm)];
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      recvbufElements = displsTotalSize;
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            recvtype->copyIntoModifiedBuffer(recvbuf, displs[rank], recvbufMod, displsMod[rank], recvcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        } else {
+          h->sendbufCount = recvtype->computeActiveElements(displs[getCommRank(comm)] + recvcounts[getCommRank(
+                              comm)]) - recvtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommSize(comm), recvtype);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            recvtype->getIndices(recvbuf, displs[rank], h->sendbufIndices, 0, recvcounts[rank]);
+          }
+        }
+
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, displsMod[i], recvcounts[i]);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iallgatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iallgatherv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iallgatherv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iallgatherv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgatherv_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Allgatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Iallgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename DATATYPE>
+  struct AMPI_Allreduce_init_global_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod;
+    typename DATATYPE::Type* recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod;
+    int count;
+    DATATYPE* datatype;
+    AMPI_Op op;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_preStart(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_finish(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_postEnd(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
+                                 int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Info info,
+                                 AMPI_Request* request) {
+    int rStatus;
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+    (void)convOp;
+
+    if(!isActiveType(datatype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Allreduce_init(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm, info,
+                                   &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = count;
+      } else {
+        sendbufElements = count;
+      }
+
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+      }
+      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = count;
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Allreduce_init(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(),
+                                   convOp.modifiedPrimalFunction, comm, info, &request->request);
+
+      AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->count = count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->op = op;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Allreduce_init_global_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Allreduce_init_global_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Allreduce_init_global_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(datatype)) {
+
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      (void)convOp;
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = count;
+      } else {
+        sendbufElements = count;
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      recvbufElements = count;
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Iallreduce_global_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(datatype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
+        } else {
+          datatype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        } else {
+          h->sendbufCount = datatype->computeActiveElements(count);
+        }
+        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = datatype->computeActiveElements(count);
+        h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
+        datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+        // extract the primal values for the operator if required
+        if(convOp.requiresPrimal) {
+          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
+          if(AMPI_IN_PLACE != sendbuf) {
+            datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
+          } else {
+            datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
+          }
+        }
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
+        } else {
+          datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
+        }
+
+        datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iallreduce_global_b<DATATYPE>;
+        h->funcForward = AMPI_Iallreduce_global_d_finish<DATATYPE>;
+        h->funcPrimal = AMPI_Iallreduce_global_p_finish<DATATYPE>;
+        h->count = count;
+        h->datatype = datatype;
+        h->op = op;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(recvbuf, 0, count);
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iallreduce_global_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Iallreduce_global_d<DATATYPE>, h);
+        datatype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(datatype)) {
+
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      (void)convOp;
+      recordReverseAggregationFlush(datatype->getADTool(), h);
+      datatype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(datatype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+      // extract the primal values for the operator if required
+      if(nullptr != h && convOp.requiresPrimal) {
+        datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
+        datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
+      }
+
+      datatype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Allreduce_init_global_AsyncHandle<DATATYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename DATATYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename DATATYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    typename DATATYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename DATATYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    AMPI_Op op = asyncHandle->op;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iallreduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Iallreduce_global_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(op); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(datatype)) {
+
+      AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+      (void)convOp;
+
+
+      if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Alltoall_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                         typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm,
+                         AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Alltoall_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount,
+                                  recvtype->getMpiType(), comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount * getCommSize(comm);
+      } else {
+        sendbufElements = recvcount * getCommSize(comm);
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommSize(comm);
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Alltoall_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                  recvtype->getModifiedMpiType(), comm, info, &request->request);
+
+      AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Alltoall_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Alltoall_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Alltoall_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount * getCommSize(comm);
+      } else {
+        sendbufElements = recvcount * getCommSize(comm);
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      recvbufElements = recvcount * getCommSize(comm);
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+        } else {
+          recvtype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        } else {
+          h->sendbufCount = recvtype->computeActiveElements(recvcount);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        } else {
+          recvtype->getIndices(recvbuf, 0, h->sendbufIndices, 0, recvcount * getCommSize(comm));
+        }
+
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommSize(comm));
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ialltoall_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ialltoall_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ialltoall_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ialltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ialltoall_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoall_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoall_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Alltoallv_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* sdisplsMod;
+    const  int* sendcounts;
+    const  int* sdispls;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* rdisplsMod;
+    const  int* recvcounts;
+    const  int* rdispls;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts,
+                          const int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
+                          const int* recvcounts, const int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Info info,
+                          AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Alltoallv_init(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts, rdispls,
+                                   recvtype->getMpiType(), comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* sdisplsMod = sdispls;
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          sdisplsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          rdisplsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sdisplsTotalSize;
+      } else {
+        sendbufElements = rdisplsTotalSize;
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = rdisplsTotalSize;
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Alltoallv_init(sendbufMod, sendcounts, sdisplsMod, sendtype->getModifiedMpiType(), recvbufMod,
+                                   recvcounts, rdisplsMod, recvtype->getModifiedMpiType(), comm, info,
+                                   &request->request);
+
+      AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sdisplsMod = sdisplsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->sdispls = sdispls;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->rdisplsMod = rdisplsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->rdispls = rdispls;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Alltoallv_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Alltoallv_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Alltoallv_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* sdisplsMod = asyncHandle->sdisplsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* sdispls = asyncHandle->sdispls;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* rdisplsMod = asyncHandle->rdisplsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* rdispls = asyncHandle->rdispls;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+      }
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+      }
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sdisplsTotalSize;
+      } else {
+        sendbufElements = rdisplsTotalSize;
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      recvbufElements = rdisplsTotalSize;
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
+          }
+        } else {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->copyIntoModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, sdispls, getCommSize(comm), sendtype);
+        } else {
+          createLinearIndexCounts(h->sendbufCount, recvcounts, rdispls, getCommSize(comm), recvtype);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, rdispls, getCommSize(comm), recvtype);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, sdispls[i], h->sendbufIndices, sdisplsMod[i], sendcounts[i]);
+          }
+        } else {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->getIndices(recvbuf, rdispls[i], h->sendbufIndices, rdisplsMod[i], recvcounts[i]);
+          }
+        }
+
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->createIndices(recvbuf, rdispls[i], h->recvbufIndices, rdisplsMod[i], recvcounts[i]);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ialltoallv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ialltoallv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ialltoallv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->sdispls = sdispls;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->rdispls = rdispls;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ialltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ialltoallv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* sdisplsMod = asyncHandle->sdisplsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* sdispls = asyncHandle->sdispls;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* rdisplsMod = asyncHandle->rdisplsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* rdispls = asyncHandle->rdispls;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        for(int i = 0; i < getCommSize(comm); ++i) {
+          recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Alltoallv_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Alltoallv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* sdisplsMod = asyncHandle->sdisplsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* sdispls = asyncHandle->sdispls;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* rdisplsMod = asyncHandle->rdisplsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* rdispls = asyncHandle->rdispls;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ialltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(sdisplsMod);
+      }
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(rdisplsMod);
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename DATATYPE>
+  struct AMPI_Bcast_init_wrap_AsyncHandle : public AsyncHandle {
+    typename DATATYPE::Type* bufferSend;
+    typename DATATYPE::ModifiedType* bufferSendMod;
+    typename DATATYPE::Type* bufferRecv;
+    typename DATATYPE::ModifiedType* bufferRecvMod;
+    int count;
+    DATATYPE* datatype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_preStart(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_finish(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_postEnd(HandleBase* handle);
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap(typename DATATYPE::Type* bufferSend, typename DATATYPE::Type* bufferRecv, int count,
+                           DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(datatype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Bcast_init_wrap(bufferSend, bufferRecv, count, datatype->getMpiType(), root, comm, info,
+                                    &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = nullptr;
+      typename DATATYPE::ModifiedType* bufferSendMod = nullptr;
+      int bufferSendElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        if(AMPI_IN_PLACE != bufferSend) {
+          bufferSendElements = count;
+        } else {
+          bufferSendElements = count;
+        }
+
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
+          datatype->createModifiedTypeBuffer(bufferSendMod, bufferSendElements);
+        } else {
+          bufferSendMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferSend));
+        }
+      }
+      typename DATATYPE::ModifiedType* bufferRecvMod = nullptr;
+      int bufferRecvElements = 0;
+
+      // compute the total size of the buffer
+      bufferRecvElements = count;
+
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->createModifiedTypeBuffer(bufferRecvMod, bufferRecvElements);
+      } else {
+        bufferRecvMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(bufferRecv));
+      }
+
+      rStatus = MPI_Bcast_init_wrap(bufferSendMod, bufferRecvMod, count, datatype->getModifiedMpiType(), root, comm,
+                                    info, &request->request);
+
+      AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>* asyncHandle = new AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>();
+      asyncHandle->bufferSend = bufferSend;
+      asyncHandle->bufferSendMod = bufferSendMod;
+      asyncHandle->bufferRecv = bufferRecv;
+      asyncHandle->bufferRecvMod = bufferRecvMod;
+      asyncHandle->count = count;
+      asyncHandle->datatype = datatype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Bcast_init_wrap_finish<DATATYPE>;
+      request->start = (ContinueFunction)AMPI_Bcast_init_wrap_preStart<DATATYPE>;
+      request->end = (ContinueFunction)AMPI_Bcast_init_wrap_postEnd<DATATYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>*>(handle);
+    typename DATATYPE::Type* bufferSend = asyncHandle->bufferSend;
+    typename DATATYPE::ModifiedType* bufferSendMod = asyncHandle->bufferSendMod;
+    typename DATATYPE::Type* bufferRecv = asyncHandle->bufferRecv;
+    typename DATATYPE::ModifiedType* bufferRecvMod = asyncHandle->bufferRecvMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSend); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSendMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecv); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecvMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(datatype)) {
+
+      int bufferSendElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // recompute the total size of the buffer
+        if(AMPI_IN_PLACE != bufferSend) {
+          bufferSendElements = count;
+        } else {
+          bufferSendElements = count;
+        }
+      }
+      int bufferRecvElements = 0;
+
+      // recompute the total size of the buffer
+      bufferRecvElements = count;
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(datatype)) {
+        h = new (datatype->getADTool().getHandleSlab()) AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>();
+      }
+      datatype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(datatype)) {
+          if(AMPI_IN_PLACE != bufferSend) {
+            datatype->copyIntoModifiedBuffer(bufferSend, 0, bufferSendMod, 0, count);
+          } else {
+            datatype->copyIntoModifiedBuffer(bufferRecv, 0, bufferRecvMod, 0, count);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          if(AMPI_IN_PLACE != bufferSend) {
+            h->bufferSendCount = datatype->computeActiveElements(count);
+          } else {
+            h->bufferSendCount = datatype->computeActiveElements(count);
+          }
+          h->bufferSendTotalSize = datatype->computeActiveElements(bufferSendElements);
+          datatype->getADTool().createIndexTypeBuffer(h->bufferSendIndices, h->bufferSendTotalSize);
+        }
+        h->bufferRecvCount = datatype->computeActiveElements(count);
+        h->bufferRecvTotalSize = datatype->computeActiveElements(bufferRecvElements);
+        datatype->getADTool().createIndexTypeBuffer(h->bufferRecvIndices, h->bufferRecvTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(datatype)) {
+          datatype->getADTool().createPrimalTypeBuffer(h->bufferRecvOldPrimals, h->bufferRecvTotalSize);
+          datatype->getValues(bufferRecv, 0, h->bufferRecvOldPrimals, 0, count);
+        }
+
+
+        if(root == getCommRank(comm)) {
+          if(AMPI_IN_PLACE != bufferSend) {
+            datatype->getIndices(bufferSend, 0, h->bufferSendIndices, 0, count);
+          } else {
+            datatype->getIndices(bufferRecv, 0, h->bufferSendIndices, 0, count);
+          }
+        }
+
+        datatype->createIndices(bufferRecv, 0, h->bufferRecvIndices, 0, count);
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ibcast_wrap_b<DATATYPE>;
+        h->funcForward = AMPI_Ibcast_wrap_d_finish<DATATYPE>;
+        h->funcPrimal = AMPI_Ibcast_wrap_p_finish<DATATYPE>;
+        h->count = count;
+        h->datatype = datatype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(datatype)) {
+        datatype->clearIndices(bufferRecv, 0, count);
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = datatype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ibcast_wrap_b_finish<DATATYPE>,
+                                                        (ForwardFunction)AMPI_Ibcast_wrap_d<DATATYPE>, h);
+        datatype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>*>(handle);
+    typename DATATYPE::Type* bufferSend = asyncHandle->bufferSend;
+    typename DATATYPE::ModifiedType* bufferSendMod = asyncHandle->bufferSendMod;
+    typename DATATYPE::Type* bufferRecv = asyncHandle->bufferRecv;
+    typename DATATYPE::ModifiedType* bufferRecvMod = asyncHandle->bufferRecvMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSend); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSendMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecv); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecvMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(datatype)) {
+
+      recordReverseAggregationFlush(datatype->getADTool(), h);
+      datatype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(datatype)) {
+        datatype->copyFromModifiedBuffer(bufferRecv, 0, bufferRecvMod, 0, count);
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        datatype->registerValue(bufferRecv, 0, h->bufferRecvIndices, h->bufferRecvOldPrimals, 0, count);
+        // compress the index buffers
+        compressIndices(datatype->getADTool(), h->bufferSendIndices, h->bufferSendIndicesRanges,
+                        h->bufferSendTotalSize);
+        compressIndices(datatype->getADTool(), h->bufferRecvIndices, h->bufferRecvIndicesRanges,
+                        h->bufferRecvTotalSize);
+      }
+
+      datatype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>* asyncHandle =
+      static_cast<AMPI_Bcast_init_wrap_AsyncHandle<DATATYPE>*>(handle);
+    typename DATATYPE::Type* bufferSend = asyncHandle->bufferSend;
+    typename DATATYPE::ModifiedType* bufferSendMod = asyncHandle->bufferSendMod;
+    typename DATATYPE::Type* bufferRecv = asyncHandle->bufferRecv;
+    typename DATATYPE::ModifiedType* bufferRecvMod = asyncHandle->bufferRecvMod;
+    int count = asyncHandle->count;
+    DATATYPE* datatype = asyncHandle->datatype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Ibcast_wrap_AdjointHandle<DATATYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSend); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferSendMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecv); // Unused generated to ignore warnings
+    MEDI_UNUSED(bufferRecvMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(count); // Unused generated to ignore warnings
+    MEDI_UNUSED(datatype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(datatype)) {
+
+
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(datatype)  && !(AMPI_IN_PLACE == bufferSend)) {
+          datatype->deleteModifiedTypeBuffer(bufferSendMod);
+        }
+      }
+      if(isModifiedBufferRequired(datatype) ) {
+        datatype->deleteModifiedTypeBuffer(bufferRecvMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Gather_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                       typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm,
+                       AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Gather_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                                root, comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcount;
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        recvbufElements = recvcount * getCommSize(comm);
+
+        if(isModifiedBufferRequired(recvtype) ) {
+          recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+        } else {
+          recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+        }
+      }
+
+      rStatus = MPI_Gather_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                recvtype->getModifiedMpiType(), root, comm, info, &request->request);
+
+      AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Gather_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Gather_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Gather_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcount;
+      }
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // recompute the total size of the buffer
+        recvbufElements = recvcount * getCommSize(comm);
+      }
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        } else {
+          recvtype->copyIntoModifiedBuffer(recvbuf, recvcount * getCommRank(comm), recvbufMod, recvcount * getCommRank(comm),
+                                           recvcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        } else {
+          h->sendbufCount = recvtype->computeActiveElements(recvcount);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        if(root == getCommRank(comm)) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+          h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        }
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          if(root == getCommRank(comm)) {
+            recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+            if(root == getCommRank(comm)) {
+              recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+            }
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        } else {
+          recvtype->getIndices(recvbuf, recvcount * getCommRank(comm), h->sendbufIndices, 0, recvcount);
+        }
+
+        if(root == getCommRank(comm)) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommSize(comm));
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Igather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Igather_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Igather_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(!isModifiedBufferRequired(recvtype)) {
+          recvtype->clearIndices(recvbuf, 0, recvcount * getCommSize(comm));
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Igather_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Igather_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(recvtype)) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(root == getCommRank(comm)) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommSize(comm));
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gather_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gather_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(recvtype) ) {
+          recvtype->deleteModifiedTypeBuffer(recvbufMod);
+        }
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Gatherv_init_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* displsMod;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                        typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs, RECVTYPE* recvtype,
+                        int root, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Gatherv_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                 recvtype->getMpiType(), root, comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcounts[getCommRank(comm)];
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        recvbufElements = displsTotalSize;
+
+        if(isModifiedBufferRequired(recvtype) ) {
+          recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+        } else {
+          recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+        }
+      }
+
+      rStatus = MPI_Gatherv_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcounts,
+                                 displsMod, recvtype->getModifiedMpiType(), root, comm, info, &request->request);
+
+      AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Gatherv_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Gatherv_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Gatherv_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommSize(comm));
+      }
+      int sendbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != sendbuf) {
+        sendbufElements = sendcount;
+      } else {
+        sendbufElements = recvcounts[getCommRank(comm)];
+      }
+      int recvbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // recompute the total size of the buffer
+        recvbufElements = displsTotalSize;
+      }
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            recvtype->copyIntoModifiedBuffer(recvbuf, displs[rank], recvbufMod, displsMod[rank], recvcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(AMPI_IN_PLACE != sendbuf) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        } else {
+          h->sendbufCount = recvtype->computeActiveElements(displs[getCommRank(comm)] + recvcounts[getCommRank(
+                              comm)]) - recvtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommSize(comm), recvtype);
+          h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+        }
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          if(root == getCommRank(comm)) {
+            recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+            if(root == getCommRank(comm)) {
+              for(int i = 0; i < getCommSize(comm); ++i) {
+                recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+              }
+            }
+          }
+        }
+
+
+        if(AMPI_IN_PLACE != sendbuf) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            recvtype->getIndices(recvbuf, displs[rank], h->sendbufIndices, 0, recvcounts[rank]);
+          }
+        }
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, displsMod[i], recvcounts[i]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Igatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Igatherv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Igatherv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(!isModifiedBufferRequired(recvtype)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
+          }
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Igatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Igatherv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(recvtype)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+          }
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Gatherv_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Gatherv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Igatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(isModifiedBufferRequired(sendtype)  && !(AMPI_IN_PLACE == sendbuf)) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(recvtype) ) {
+          recvtype->deleteModifiedTypeBuffer(recvbufMod);
+        }
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatter_init_AsyncHandle : public AsyncHandle {
+    typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init(typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                        typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm,
+                        AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatter_init(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
+                                 root, comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = sendcount * getCommSize(comm);
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcount;
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Scatter_init(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                 recvtype->getModifiedMpiType(), root, comm, info, &request->request);
+
+      AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Scatter_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Scatter_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Scatter_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // recompute the total size of the buffer
+        sendbufElements = sendcount * getCommSize(comm);
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcount;
+      }
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          h->sendbufCount = sendtype->computeActiveElements(sendcount);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(sendcount);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          sendtype->createIndices(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, 0, sendcount);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iscatter_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatter_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatter_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          sendtype->clearIndices(sendbuf, sendcount * getCommRank(comm), sendcount);
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iscatter_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iscatter_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          sendtype->copyFromModifiedBuffer(sendbuf, sendcount * getCommRank(comm), sendbufMod, sendcount * getCommRank(comm),
+                                           sendcount);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          sendtype->registerValue(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, h->recvbufOldPrimals, 0, sendcount);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatter_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatter_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Scatterv_init_AsyncHandle : public AsyncHandle {
+    typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* displsMod;
+    const  int* sendcounts;
+    const  int* displs;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    int root;
+    AMPI_Comm comm;
+    AMPI_Info info;
+    AMPI_Request* request;
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_preStart(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_postEnd(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init(typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
+                         typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm,
+                         AMPI_Info info, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Scatterv_init(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount,
+                                  recvtype->getMpiType(), root, comm, info, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(sendcounts, getCommSize(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // compute the total size of the buffer
+        sendbufElements = displsTotalSize;
+
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+        } else {
+          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+        }
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcounts[getCommRank(comm)];
+      }
+
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      rStatus = MPI_Scatterv_init(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod,
+                                  recvcount, recvtype->getModifiedMpiType(), root, comm, info, &request->request);
+
+      AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->root = root;
+      asyncHandle->comm = comm;
+      asyncHandle->info = info;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Scatterv_init_finish<SENDTYPE, RECVTYPE>;
+      request->start = (ContinueFunction)AMPI_Scatterv_init_preStart<SENDTYPE, RECVTYPE>;
+      request->end = (ContinueFunction)AMPI_Scatterv_init_postEnd<SENDTYPE, RECVTYPE>;
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_preStart(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* displs = asyncHandle->displs;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
+      }
+      int sendbufElements = 0;
+
+      if(root == getCommRank(comm)) {
+        // recompute the total size of the buffer
+        sendbufElements = displsTotalSize;
+      }
+      int recvbufElements = 0;
+
+      // recompute the total size of the buffer
+      if(AMPI_IN_PLACE != recvbuf) {
+        recvbufElements = recvcount;
+      } else {
+        recvbufElements = sendcounts[getCommRank(comm)];
+      }
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        if(root == getCommRank(comm)) {
+          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
+          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        }
+        if(AMPI_IN_PLACE != recvbuf) {
+          h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        } else {
+          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
+                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
+        }
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          if(AMPI_IN_PLACE != recvbuf) {
+            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
+          } else {
+            {
+              const int rank = getCommRank(comm);
+              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
+            }
+          }
+        }
+
+
+        if(root == getCommRank(comm)) {
+          for(int i = 0; i < getCommSize(comm); ++i) {
+            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
+          }
+        }
+
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->createIndices(sendbuf, displs[rank], h->recvbufIndices, 0, sendcounts[rank]);
+          }
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Iscatterv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Iscatterv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Iscatterv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->displs = displs;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->root = root;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->clearIndices(recvbuf, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->clearIndices(sendbuf, displs[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      asyncHandle->toolHandle = h;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Iscatterv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Iscatterv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* displs = asyncHandle->displs;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->copyFromModifiedBuffer(sendbuf, displs[rank], sendbufMod, displsMod[rank], sendcounts[rank]);
+          }
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        if(AMPI_IN_PLACE != recvbuf) {
+          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
+        } else {
+          {
+            const int rank = getCommRank(comm);
+            sendtype->registerValue(sendbuf, displs[rank], h->recvbufIndices, h->recvbufOldPrimals, 0, sendcounts[rank]);
+          }
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Scatterv_init_postEnd(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Scatterv_init_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* displs = asyncHandle->displs;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    int root = asyncHandle->root;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Info info = asyncHandle->info;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Iscatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(root); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(info); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(root == getCommRank(comm)) {
+        if(isModifiedBufferRequired(sendtype) ) {
+          sendtype->deleteModifiedTypeBuffer(sendbufMod);
+        }
+      }
+      if(isModifiedBufferRequired(recvtype)  && !(AMPI_IN_PLACE == recvbuf)) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgather_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Ineighbor_allgather_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgather_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointCombineNeighbors(h->comm));
+
+    AMPI_Ineighbor_allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointCombineNeighbors(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                               typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_allgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm,
+                                        &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        }
+
+
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommInDegree(comm));
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_allgather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_allgather_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_allgather_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommInDegree(comm));
+      }
+
+      rStatus = MPI_Ineighbor_allgather(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                        recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_allgather_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ineighbor_allgather_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ineighbor_allgather_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgather_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_allgather_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommInDegree(comm));
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgatherv_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Ineighbor_allgatherv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_allgatherv_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* displsMod;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                 h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+                 &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                 h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+                 &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointCombineNeighbors(h->comm));
+
+    AMPI_Ineighbor_allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                 h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm,
+                 &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointCombineNeighbors(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                                typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs, RECVTYPE* recvtype, AMPI_Comm comm,
+                                AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_allgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                         recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = displsTotalSize;
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommInDegree(comm), recvtype);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+          }
+        }
+
+
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, displsMod[i], recvcounts[i]);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_allgatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_allgatherv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_allgatherv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
+        }
+      }
+
+      rStatus = MPI_Ineighbor_allgatherv(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcounts, displsMod,
+                                         recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->displsMod = displsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->displs = displs;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_allgatherv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ineighbor_allgatherv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ineighbor_allgatherv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_allgatherv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_allgatherv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* displsMod = asyncHandle->displsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* displs = asyncHandle->displs;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h =
+      static_cast<AMPI_Ineighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>(asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(displsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(displs); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoall_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Ineighbor_alltoall_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoall_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    int sendcount;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Ineighbor_alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                              typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_alltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm,
+                                       &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount * getCommOutDegree(comm);
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommOutDegree(comm));
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        }
+
+
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommOutDegree(comm));
+
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommInDegree(comm));
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_alltoall_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_alltoall_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_alltoall_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommInDegree(comm));
+      }
+
+      rStatus = MPI_Ineighbor_alltoall(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                       recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sendcount = sendcount;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->recvcount = recvcount;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_alltoall_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ineighbor_alltoall_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ineighbor_alltoall_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoall_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_alltoall_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    int sendcount = asyncHandle->sendcount;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    int recvcount = asyncHandle->recvcount;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcount); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommInDegree(comm));
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoallv_AdjointHandle : public AsyncAdjointHandle {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int* sendbufCount;
+    /* required for async */ int* sendbufCountVec;
+    /* required for async */ int* sendbufDisplsVec;
+    const  int* sendcounts;
+    const  int* sdispls;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* rdispls;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Ineighbor_alltoallv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != sendbufCount) {
+        delete [] sendbufCount;
+        sendbufCount = nullptr;
+      }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
+    }
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Ineighbor_alltoallv_AsyncHandle : public AsyncHandle {
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod;
+    const int* sdisplsMod;
+    const  int* sendcounts;
+    const  int* sdispls;
+    SENDTYPE* sendtype;
+    typename RECVTYPE::Type* recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod;
+    const int* rdisplsMod;
+    const  int* recvcounts;
+    const  int* rdispls;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+    AMPI_Request* request;
+  };
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_p_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Ineighbor_alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_d_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+
+    AMPI_Ineighbor_alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                     h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                     h->recvtype, h->comm, &h->requestReverse);
+
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_b_finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+    waitReverse(&h->requestReverse);
+
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv_finish(HandleBase* handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* sdispls,
+                               SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* rdispls, RECVTYPE* recvtype,
+                               AMPI_Comm comm, AMPI_Request* request) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Ineighbor_alltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts, rdispls,
+                                        recvtype->getMpiType(), comm, &request->request);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* sdisplsMod = sdispls;
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommOutDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          sdisplsMod = acquireLinearDisplacements(sendcounts, getCommOutDegree(comm));
+        }
+      }
+      MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          rdisplsMod = acquireLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sdisplsTotalSize;
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = rdisplsTotalSize;
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        createLinearIndexCounts(h->sendbufCount, sendcounts, sdispls, getCommOutDegree(comm), sendtype);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, rdispls, getCommInDegree(comm), recvtype);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
+          }
+        }
+
+
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          sendtype->getIndices(sendbuf, sdispls[i], h->sendbufIndices, sdisplsMod[i], sendcounts[i]);
+        }
+
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->createIndices(recvbuf, rdispls[i], h->recvbufIndices, rdisplsMod[i], recvcounts[i]);
+        }
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Ineighbor_alltoallv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Ineighbor_alltoallv_d_finish<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Ineighbor_alltoallv_p_finish<SENDTYPE, RECVTYPE>;
+        h->sendcounts = sendcounts;
+        h->sdispls = sdispls;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->rdispls = rdispls;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
+        }
+      }
+
+      rStatus = MPI_Ineighbor_alltoallv(sendbufMod, sendcounts, sdisplsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcounts,
+                                        rdisplsMod, recvtype->getModifiedMpiType(), comm, &request->request);
+
+      AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle = new AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>();
+      asyncHandle->sendbuf = sendbuf;
+      asyncHandle->sendbufMod = sendbufMod;
+      asyncHandle->sdisplsMod = sdisplsMod;
+      asyncHandle->sendcounts = sendcounts;
+      asyncHandle->sdispls = sdispls;
+      asyncHandle->sendtype = sendtype;
+      asyncHandle->recvbuf = recvbuf;
+      asyncHandle->recvbufMod = recvbufMod;
+      asyncHandle->rdisplsMod = rdisplsMod;
+      asyncHandle->recvcounts = recvcounts;
+      asyncHandle->rdispls = rdispls;
+      asyncHandle->recvtype = recvtype;
+      asyncHandle->comm = comm;
+      asyncHandle->toolHandle = h;
+      request->handle = asyncHandle;
+      request->func = (ContinueFunction)AMPI_Ineighbor_alltoallv_finish<SENDTYPE, RECVTYPE>;
+
+      // create adjoint wait
+      if(nullptr != h) {
+        HandleSlab& handleSlab = recvtype->getADTool().getHandleSlab();
+        WaitHandle* waitH = new (handleSlab) WaitHandle((ReverseFunction)AMPI_Ineighbor_alltoallv_b_finish<SENDTYPE, RECVTYPE>,
+                                                        (ForwardFunction)AMPI_Ineighbor_alltoallv_d<SENDTYPE, RECVTYPE>, h);
+        recvtype->getADTool().addToolAction(waitH);
+      }
+    }
+
+    return rStatus;
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Ineighbor_alltoallv_finish(HandleBase* handle) {
+    int rStatus = 0;
+
+    AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>* asyncHandle =
+      static_cast<AMPI_Ineighbor_alltoallv_AsyncHandle<SENDTYPE, RECVTYPE>*>(handle);
+    MEDI_OPTIONAL_CONST  typename SENDTYPE::Type* sendbuf = asyncHandle->sendbuf;
+    typename SENDTYPE::ModifiedType* sendbufMod = asyncHandle->sendbufMod;
+    const int* sdisplsMod = asyncHandle->sdisplsMod;
+    const  int* sendcounts = asyncHandle->sendcounts;
+    const  int* sdispls = asyncHandle->sdispls;
+    SENDTYPE* sendtype = asyncHandle->sendtype;
+    typename RECVTYPE::Type* recvbuf = asyncHandle->recvbuf;
+    typename RECVTYPE::ModifiedType* recvbufMod = asyncHandle->recvbufMod;
+    const int* rdisplsMod = asyncHandle->rdisplsMod;
+    const  int* recvcounts = asyncHandle->recvcounts;
+    const  int* rdispls = asyncHandle->rdispls;
+    RECVTYPE* recvtype = asyncHandle->recvtype;
+    AMPI_Comm comm = asyncHandle->comm;
+    AMPI_Request* request = asyncHandle->request;
+    AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Ineighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (asyncHandle->toolHandle);
+    MEDI_UNUSED(h); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(sdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(sendtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbuf); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvbufMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdisplsMod); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvcounts); // Unused generated to ignore warnings
+    MEDI_UNUSED(rdispls); // Unused generated to ignore warnings
+    MEDI_UNUSED(recvtype); // Unused generated to ignore warnings
+    MEDI_UNUSED(comm); // Unused generated to ignore warnings
+    MEDI_UNUSED(request); // Unused generated to ignore warnings
+
+    delete asyncHandle;
+
+    if(isActiveType(recvtype)) {
+
+      recordReverseAggregationFlush(recvtype->getADTool(), h);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
+        }
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
+        }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(sdisplsMod);
+      }
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(rdisplsMod);
+      }
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Neighbor_allgather_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int recvbufCount;
+    int recvbufCountVec;
+    int recvcount;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Neighbor_allgather_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
 
-    AMPI_Reduce_global_pri<DATATYPE>(h->sendbufPrimals, h->sendbufCountVec, h->recvbufPrimals, h->recvbufCountVec, h->count,
-                                     h->datatype, h->op, h->root, h->comm);
+    AMPI_Neighbor_allgather_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
     adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      if(h->root == getCommRank(h->comm)) {
-        adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
-      }
-    }
-    if(h->root == getCommRank(h->comm)) {
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
 
-    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
-    }
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
     adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
 
-    AMPI_Reduce_global_fwd<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                     h->count, h->datatype, h->op, h->root, h->comm);
+    AMPI_Neighbor_allgather_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
+
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
+    }
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointCombineNeighbors(h->comm));
+
+    AMPI_Neighbor_allgather_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                    h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
+
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointCombineNeighbors(h->comm));
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Neighbor_allgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                              typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    int rStatus;
+
+    if(!isActiveType(recvtype)) {
+      // call the regular function if the type is not active
+      rStatus = MPI_Neighbor_allgather(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm);
+    } else {
+
+      // the type is an AD type so handle the buffers
+      AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
+      int sendbufElements = 0;
+
+      // compute the total size of the buffer
+      sendbufElements = sendcount;
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
+      }
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
+      int recvbufElements = 0;
+
+      // compute the total size of the buffer
+      recvbufElements = recvcount * getCommInDegree(comm);
+
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
+      }
+
+      // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Neighbor_allgather_AdjointHandle<SENDTYPE, RECVTYPE>();
+      }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
+      }
+
+      if(nullptr != h) {
+        // gather the information for the reverse sweep
+
+        // create the index buffers
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
+
+
+        // extract the old primal values from the recv buffer if the AD tool
+        // needs the primal values reset
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        }
+
+
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
+
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommInDegree(comm));
+
+        // pack all the variables in the handle
+        h->funcReverse = AMPI_Neighbor_allgather_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_allgather_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_allgather_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcount = recvcount;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
+      }
+
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommInDegree(comm));
+      }
+
+      rStatus = MPI_Neighbor_allgather(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                       recvtype->getModifiedMpiType(), comm);
+      recvtype->getADTool().addToolAction(h);
+
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommInDegree(comm));
+      }
+
+      if(nullptr != h) {
+        // handle the recv buffers
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
+      }
+
+      recvtype->getADTool().stopAssembly(h);
+
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
+      }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
+      }
+
+      // handle is deleted by the AD tool
+    }
+
+    return rStatus;
+  }
+
+#endif
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  struct AMPI_Neighbor_allgatherv_AdjointHandle : public HandleBase {
+    int sendbufTotalSize;
+    typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
+    typename SENDTYPE::PrimalType* sendbufPrimals;
+    /* required for async */ void* sendbufAdjoints;
+    int sendbufCount;
+    int sendbufCountVec;
+    int sendcount;
+    SENDTYPE* sendtype;
+    int recvbufTotalSize;
+    typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
+    typename RECVTYPE::PrimalType* recvbufPrimals;
+    typename RECVTYPE::PrimalType* recvbufOldPrimals;
+    /* required for async */ void* recvbufAdjoints;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* displs;
+    RECVTYPE* recvtype;
+    AMPI_Comm comm;
+
+    ~AMPI_Neighbor_allgatherv_AdjointHandle () {
+      if(nullptr != sendbufIndices) {
+        sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
+        sendbufIndices = nullptr;
+      }
+      if(nullptr != sendbufPrimals) {
+        sendtype->getADTool().deletePrimalTypeBuffer(sendbufPrimals);
+        sendbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufIndices) {
+        recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
+        recvbufIndices = nullptr;
+      }
+      if(nullptr != recvbufPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufPrimals);
+        recvbufPrimals = nullptr;
+      }
+      if(nullptr != recvbufOldPrimals) {
+        recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
+        recvbufOldPrimals = nullptr;
+      }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
+    }
+  };
+
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgatherv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
+
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
+  }
+
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
+
+    h->recvbufAdjoints = nullptr;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    h->sendbufAdjoints = nullptr;
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
+
+
+    AMPI_Neighbor_allgatherv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
+
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename DATATYPE>
-  void AMPI_Reduce_global_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = static_cast<AMPI_Reduce_global_AdjointHandle<DATATYPE>*>(handle);
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+        (handle);
 
-    AMPI_Op convOp = h->datatype->getADTool().convertOperator(h->op);
-    (void)convOp;
     h->recvbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-      convOp.preAdjointOperation(h->recvbufAdjoints, h->recvbufPrimals, h->recvbufCount, adjointInterface->getVectorSize());
-    }
-    if(h->datatype->getADTool().isOldPrimalsRequired()) {
-      if(h->root == getCommRank(h->comm)) {
-        adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
-      }
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
     h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize * getAdjointCombineNeighbors(h->comm));
 
-    AMPI_Reduce_global_adj<DATATYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->recvbufAdjoints, h->recvbufCountVec,
-                                     h->count, h->datatype, h->op, h->root, h->comm);
+    AMPI_Neighbor_allgatherv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                     h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->displs, h->recvtype, h->comm);
 
-    // the primals of the recive buffer are always given to the function. The operator should ignore them if not needed.
-    // The wrapper functions make sure that for operators that need the primals an all* action is perfomed (e.g. Allreduce instead of Reduce)
-    convOp.postAdjointOperation(h->sendbufAdjoints, h->sendbufPrimals, h->recvbufPrimals, h->sendbufTotalSize,
-                                adjointInterface->getVectorSize());
+    adjointInterface->combineAdjoints(h->sendbufAdjoints, h->sendbufTotalSize, getAdjointCombineNeighbors(h->comm));
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
-    }
+    adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
-  template<typename DATATYPE>
-  int AMPI_Reduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf,
-                         int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Neighbor_allgatherv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                               typename RECVTYPE::Type* recvbuf, const int* recvcounts, const int* displs,
+                               RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
-    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
-    (void)convOp;
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
-      rStatus = MPI_Reduce(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, root, comm);
+      rStatus = MPI_Neighbor_allgatherv(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcounts, displs,
+                                        recvtype->getMpiType(), comm);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Reduce_global_AdjointHandle<DATATYPE>* h = nullptr;
-      typename DATATYPE::ModifiedType* sendbufMod = nullptr;
+      AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* displsMod = displs;
+      int displsTotalSize = 0;
+      if(nullptr != displs) {
+        displsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          displsMod = acquireLinearDisplacements(recvcounts, getCommInDegree(comm));
+        }
+      }
+      typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != sendbuf) {
-        sendbufElements = count;
-      } else {
-        sendbufElements = count;
-      }
+      sendbufElements = sendcount;
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
-        datatype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
       } else {
-        sendbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(sendbuf));
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
       }
-      typename DATATYPE::ModifiedType* recvbufMod = nullptr;
+      typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        recvbufElements = count;
+      // compute the total size of the buffer
+      recvbufElements = displsTotalSize;
 
-        if(datatype->isModifiedBufferRequired() ) {
-          datatype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
-        } else {
-          recvbufMod = reinterpret_cast<typename DATATYPE::ModifiedType*>(const_cast<typename DATATYPE::Type*>(recvbuf));
-        }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
+      } else {
+        recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(datatype->getADTool().isHandleRequired()) {
-        h = new AMPI_Reduce_global_AdjointHandle<DATATYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Neighbor_allgatherv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
-      datatype->getADTool().startAssembly(h);
-      if(datatype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != sendbuf) {
-          datatype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, count);
-        } else {
-          datatype->copyIntoModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
-        }
+      recvtype->getADTool().startAssembly(h);
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount);
       }
 
       if(nullptr != h) {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(AMPI_IN_PLACE != sendbuf) {
-          h->sendbufCount = datatype->computeActiveElements(count);
-        } else {
-          h->sendbufCount = datatype->computeActiveElements(count);
-        }
-        h->sendbufTotalSize = datatype->computeActiveElements(sendbufElements);
-        datatype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        if(root == getCommRank(comm)) {
-          h->recvbufCount = datatype->computeActiveElements(count);
-          h->recvbufTotalSize = datatype->computeActiveElements(recvbufElements);
-          datatype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
-        }
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, displs, getCommInDegree(comm), recvtype);
+        h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
-        // extract the primal values for the operator if required
-        if(convOp.requiresPrimal) {
-          datatype->getADTool().createPrimalTypeBuffer(h->sendbufPrimals, h->sendbufTotalSize);
-          if(AMPI_IN_PLACE != sendbuf) {
-            datatype->getValues(sendbuf, 0, h->sendbufPrimals, 0, count);
-          } else {
-            datatype->getValues(recvbuf, 0, h->sendbufPrimals, 0, count);
-          }
-        }
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(datatype->getADTool().isOldPrimalsRequired()) {
-          if(root == getCommRank(comm)) {
-            datatype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-            if(root == getCommRank(comm)) {
-              datatype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, count);
-            }
+        if(isOldPrimalsRequired(recvtype)) {
+          recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            recvtype->getValues(recvbuf, displs[i], h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
           }
         }
 
 
-        if(AMPI_IN_PLACE != sendbuf) {
-          datatype->getIndices(sendbuf, 0, h->sendbufIndices, 0, count);
-        } else {
-          datatype->getIndices(recvbuf, 0, h->sendbufIndices, 0, count);
-        }
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount);
 
-        if(root == getCommRank(comm)) {
-          datatype->createIndices(recvbuf, 0, h->recvbufIndices, 0, count);
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->createIndices(recvbuf, displs[i], h->recvbufIndices, displsMod[i], recvcounts[i]);
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Reduce_global_b<DATATYPE>;
-        h->funcForward = AMPI_Reduce_global_d<DATATYPE>;
-        h->funcPrimal = AMPI_Reduce_global_p<DATATYPE>;
-        h->count = count;
-        h->datatype = datatype;
-        h->op = op;
-        h->root = root;
-        h->comm = comm;
+        h->funcReverse = AMPI_Neighbor_allgatherv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_allgatherv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_allgatherv_p<SENDTYPE, RECVTYPE>;
+        h->sendcount = sendcount;
+        h->sendtype = sendtype;
+        h->recvcounts = recvcounts;
+        h->displs = displs;
+        h->recvtype = recvtype;
+        h->comm = getReverseComm(comm);
       }
 
-      if(root == getCommRank(comm)) {
-        if(!datatype->isModifiedBufferRequired()) {
-          datatype->clearIndices(recvbuf, 0, count);
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->clearIndices(recvbuf, displs[i], recvcounts[i]);
         }
       }
 
-      rStatus = MPI_Reduce(sendbufMod, recvbufMod, count, datatype->getModifiedMpiType(), convOp.modifiedPrimalFunction, root,
-                           comm);
-      datatype->getADTool().addToolAction(h);
+      rStatus = MPI_Neighbor_allgatherv(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcounts, displsMod,
+                                        recvtype->getModifiedMpiType(), comm);
+      recvtype->getADTool().addToolAction(h);
 
-      if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired()) {
-          datatype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, count);
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, displs[i], recvbufMod, displsMod[i], recvcounts[i]);
         }
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(root == getCommRank(comm)) {
-          datatype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, count);
-        }
-      }
-      // extract the primal values for the operator if required
-      if(nullptr != h && convOp.requiresPrimal) {
-        if(root == getCommRank(comm)) {
-          datatype->getADTool().createPrimalTypeBuffer(h->recvbufPrimals, h->recvbufTotalSize);
-          if(root == getCommRank(comm)) {
-            datatype->getValues(recvbuf, 0, h->recvbufPrimals, 0, count);
-          }
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->registerValue(recvbuf, displs[i], h->recvbufIndices, h->recvbufOldPrimals, displsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
-      datatype->getADTool().stopAssembly(h);
+      recvtype->getADTool().stopAssembly(h);
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(displsMod);
+      }
 
-      if(datatype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == sendbuf)) {
-        datatype->deleteModifiedTypeBuffer(sendbufMod);
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(root == getCommRank(comm)) {
-        if(datatype->isModifiedBufferRequired() ) {
-          datatype->deleteModifiedTypeBuffer(recvbufMod);
-        }
+      if(isModifiedBufferRequired(recvtype) ) {
+        recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
       // handle is deleted by the AD tool
@@ -10969,11 +19100,12 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Scatter_AdjointHandle : public HandleBase {
+  struct AMPI_Neighbor_alltoall_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int sendbufCount;
@@ -10982,6 +19114,7 @@ namespace medi {
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
@@ -10989,10 +19122,9 @@ namespace medi {
     int recvbufCountVec;
     int recvcount;
     RECVTYPE* recvtype;
-    int root;
     AMPI_Comm comm;
 
-    ~AMPI_Scatter_AdjointHandle () {
+    ~AMPI_Neighbor_alltoall_AdjointHandle () {
       if(nullptr != sendbufIndices) {
         sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
@@ -11018,238 +19150,196 @@ namespace medi {
 
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatter_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoall_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-    }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatter_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoall_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatter_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoall_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
     h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    }
+    h->sendbufCountVec = adjointInterface->getVectorSize() * h->sendbufCount;
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Scatter_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
-                                         h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoall_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendcount, h->sendtype,
+                                                   h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Scatter(typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
-                   int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  int AMPI_Neighbor_alltoall(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype,
+                             typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
-      rStatus = MPI_Scatter(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), root,
-                            comm);
+      rStatus = MPI_Neighbor_alltoall(sendbuf, sendcount, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(), comm);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = sendcount * getCommSize(comm);
+      // compute the total size of the buffer
+      sendbufElements = sendcount * getCommOutDegree(comm);
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
       }
       typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcount;
-      }
+      recvbufElements = recvcount * getCommInDegree(comm);
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Scatter_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Neighbor_alltoall_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommSize(comm));
-        }
+      if(isModifiedBufferRequired(sendtype)) {
+        sendtype->copyIntoModifiedBuffer(sendbuf, 0, sendbufMod, 0, sendcount * getCommOutDegree(comm));
       }
 
       if(nullptr != h) {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          h->sendbufCount = sendtype->computeActiveElements(sendcount);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(sendcount);
-        }
+        h->sendbufCount = sendtype->computeActiveElements(sendcount);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        h->recvbufCount = recvtype->computeActiveElements(recvcount);
         h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
         recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            sendtype->getValues(sendbuf, sendcount * getCommRank(comm), h->recvbufOldPrimals, 0, sendcount);
-          }
+          recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
         }
 
 
-        if(root == getCommRank(comm)) {
-          sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommSize(comm));
-        }
+        sendtype->getIndices(sendbuf, 0, h->sendbufIndices, 0, sendcount * getCommOutDegree(comm));
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          sendtype->createIndices(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, 0, sendcount);
-        }
+        recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount * getCommInDegree(comm));
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Scatter_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Scatter_d<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Scatter_p<SENDTYPE, RECVTYPE>;
+        h->funcReverse = AMPI_Neighbor_alltoall_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_alltoall_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_alltoall_p<SENDTYPE, RECVTYPE>;
         h->sendcount = sendcount;
         h->sendtype = sendtype;
         h->recvcount = recvcount;
         h->recvtype = recvtype;
-        h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          sendtype->clearIndices(sendbuf, sendcount * getCommRank(comm), sendcount);
-        }
+      if(!isModifiedBufferRequired(recvtype)) {
+        recvtype->clearIndices(recvbuf, 0, recvcount * getCommInDegree(comm));
       }
 
-      rStatus = MPI_Scatter(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                            recvtype->getModifiedMpiType(), root, comm);
+      rStatus = MPI_Neighbor_alltoall(sendbufMod, sendcount, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
+                                      recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          sendtype->copyFromModifiedBuffer(sendbuf, sendcount * getCommRank(comm), sendbufMod, sendcount * getCommRank(comm),
-                                           sendcount);
-        }
+      if(isModifiedBufferRequired(recvtype)) {
+        recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount * getCommInDegree(comm));
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          sendtype->registerValue(sendbuf, sendcount * getCommRank(comm), h->recvbufIndices, h->recvbufOldPrimals, 0, sendcount);
-        }
+        recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount * getCommInDegree(comm));
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -11260,32 +19350,35 @@ namespace medi {
   }
 
 #endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename SENDTYPE, typename RECVTYPE>
-  struct AMPI_Scatterv_AdjointHandle : public HandleBase {
+  struct AMPI_Neighbor_alltoallv_AdjointHandle : public HandleBase {
     int sendbufTotalSize;
     typename SENDTYPE::IndexType* sendbufIndices;
+    int sendbufIndicesRanges;
     typename SENDTYPE::PrimalType* sendbufPrimals;
     /* required for async */ void* sendbufAdjoints;
     int* sendbufCount;
     /* required for async */ int* sendbufCountVec;
     /* required for async */ int* sendbufDisplsVec;
     const  int* sendcounts;
-    const  int* displs;
+    const  int* sdispls;
     SENDTYPE* sendtype;
     int recvbufTotalSize;
     typename RECVTYPE::IndexType* recvbufIndices;
+    int recvbufIndicesRanges;
     typename RECVTYPE::PrimalType* recvbufPrimals;
     typename RECVTYPE::PrimalType* recvbufOldPrimals;
     /* required for async */ void* recvbufAdjoints;
-    int recvbufCount;
-    int recvbufCountVec;
-    int recvcount;
+    int* recvbufCount;
+    /* required for async */ int* recvbufCountVec;
+    /* required for async */ int* recvbufDisplsVec;
+    const  int* recvcounts;
+    const  int* rdispls;
     RECVTYPE* recvtype;
-    int root;
     AMPI_Comm comm;
 
-    ~AMPI_Scatterv_AdjointHandle () {
+    ~AMPI_Neighbor_alltoallv_AdjointHandle () {
       if(nullptr != sendbufIndices) {
         sendtype->getADTool().deleteIndexTypeBuffer(sendbufIndices);
         sendbufIndices = nullptr;
@@ -11298,6 +19391,10 @@ namespace medi {
         delete [] sendbufCount;
         sendbufCount = nullptr;
       }
+      if(nullptr != sendbufDisplsVec) {
+        releaseLinearDisplacements(sendbufDisplsVec);
+        sendbufDisplsVec = nullptr;
+      }
       if(nullptr != recvbufIndices) {
         recvtype->getADTool().deleteIndexTypeBuffer(recvbufIndices);
         recvbufIndices = nullptr;
@@ -11310,169 +19407,174 @@ namespace medi {
         recvtype->getADTool().deletePrimalTypeBuffer(recvbufOldPrimals);
         recvbufOldPrimals = nullptr;
       }
+      if(nullptr != recvbufCount) {
+        delete [] recvbufCount;
+        recvbufCount = nullptr;
+      }
+      if(nullptr != recvbufDisplsVec) {
+        releaseLinearDisplacements(recvbufDisplsVec);
+        recvbufDisplsVec = nullptr;
+      }
     }
   };
 
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_p(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
     adjointInterface->createPrimalTypeBuffer((void*&)h->recvbufPrimals, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
-      // Primal buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getPrimals(h->sendbufIndices, h->sendbufPrimals, h->sendbufTotalSize);
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createPrimalTypeBuffer((void*&)h->sendbufPrimals, h->sendbufTotalSize );
+    // Primal buffers are always linear in space so we can accesses them in one sweep
+    getPrimals(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+               h->sendbufPrimals, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatterv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoallv_pri<SENDTYPE, RECVTYPE>(h->sendbufPrimals, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufPrimals, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->getPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    adjointInterface->deletePrimalTypeBuffer((void*&)h->sendbufPrimals);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      getPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     // Primal buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->setPrimals(h->recvbufIndices, h->recvbufPrimals, h->recvbufTotalSize);
+    setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+               h->recvbufPrimals, h->recvbufTotalSize);
     adjointInterface->deletePrimalTypeBuffer((void*&)h->recvbufPrimals);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_d(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->getAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                h->sendbufAdjoints, h->sendbufTotalSize);
 
-    }
 
-    AMPI_Scatterv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoallv_fwd<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->updateAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                   h->recvbufAdjoints, h->recvbufTotalSize);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  void AMPI_Scatterv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
-    AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>*>
+  void AMPI_Neighbor_alltoallv_b(HandleBase* handle, AdjointInterface* adjointInterface) {
+    AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = static_cast<AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>*>
         (handle);
 
     h->recvbufAdjoints = nullptr;
-    h->recvbufCountVec = adjointInterface->getVectorSize() * h->recvbufCount;
+    updateLinearDisplacementsAndCount(h->recvbufCountVec, h->recvbufDisplsVec, h->recvbufCount, getCommInDegree(h->comm),
+                                      adjointInterface->getVectorSize());
     adjointInterface->createAdjointTypeBuffer(h->recvbufAdjoints, h->recvbufTotalSize );
     // Adjoint buffers are always linear in space so we can accesses them in one sweep
-    adjointInterface->getAdjoints(h->recvbufIndices, h->recvbufAdjoints, h->recvbufTotalSize);
+    getAdjoints(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                h->recvbufAdjoints, h->recvbufTotalSize);
 
-    if(h->recvtype->getADTool().isOldPrimalsRequired()) {
-      adjointInterface->setPrimals(h->recvbufIndices, h->recvbufOldPrimals, h->recvbufTotalSize);
+    if(isOldPrimalsRequired(h->recvtype)) {
+      setPrimals(adjointInterface, h->recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges,
+                 h->recvbufOldPrimals, h->recvbufTotalSize);
     }
     h->sendbufAdjoints = nullptr;
-    if(h->root == getCommRank(h->comm)) {
-      createLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommSize(h->comm),
-                                        adjointInterface->getVectorSize());
-      adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
-    }
+    updateLinearDisplacementsAndCount(h->sendbufCountVec, h->sendbufDisplsVec, h->sendbufCount, getCommOutDegree(h->comm),
+                                      adjointInterface->getVectorSize());
+    adjointInterface->createAdjointTypeBuffer(h->sendbufAdjoints, h->sendbufTotalSize );
 
-    AMPI_Scatterv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
-                                          h->displs, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvcount, h->recvtype, h->root, h->comm);
+    AMPI_Neighbor_alltoallv_adj<SENDTYPE, RECVTYPE>(h->sendbufAdjoints, h->sendbufCountVec, h->sendbufDisplsVec, h->sendcounts,
+                                                    h->sdispls, h->sendtype, h->recvbufAdjoints, h->recvbufCountVec, h->recvbufDisplsVec, h->recvcounts, h->rdispls,
+                                                    h->recvtype, h->comm);
 
-    if(h->root == getCommRank(h->comm)) {
-      // Adjoint buffers are always linear in space so we can accesses them in one sweep
-      adjointInterface->updateAdjoints(h->sendbufIndices, h->sendbufAdjoints, h->sendbufTotalSize);
-      adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
-      delete [] h->sendbufCountVec;
-      delete [] h->sendbufDisplsVec;
-    }
+    // Adjoint buffers are always linear in space so we can accesses them in one sweep
+    updateAdjoints(adjointInterface, h->recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges,
+                   h->sendbufAdjoints, h->sendbufTotalSize);
+    adjointInterface->deleteAdjointTypeBuffer(h->sendbufAdjoints);
     adjointInterface->deleteAdjointTypeBuffer(h->recvbufAdjoints);
   }
 
   template<typename SENDTYPE, typename RECVTYPE>
-  int AMPI_Scatterv(typename SENDTYPE::Type* sendbuf, const int* sendcounts, const int* displs, SENDTYPE* sendtype,
-                    typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int root, AMPI_Comm comm) {
+  int AMPI_Neighbor_alltoallv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, const int* sendcounts,
+                              const int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf,
+                              const int* recvcounts, const int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
     int rStatus;
 
-    if(!recvtype->getADTool().isActiveType()) {
+    if(!isActiveType(recvtype)) {
       // call the regular function if the type is not active
-      rStatus = MPI_Scatterv(sendbuf, sendcounts, displs, sendtype->getMpiType(), recvbuf, recvcount, recvtype->getMpiType(),
-                             root, comm);
+      rStatus = MPI_Neighbor_alltoallv(sendbuf, sendcounts, sdispls, sendtype->getMpiType(), recvbuf, recvcounts, rdispls,
+                                       recvtype->getMpiType(), comm);
     } else {
 
       // the type is an AD type so handle the buffers
-      AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
-      MEDI_OPTIONAL_CONST int* displsMod = displs;
-      int displsTotalSize = 0;
-      if(nullptr != displs) {
-        displsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommSize(comm));
-        if(recvtype->isModifiedBufferRequired()) {
-          displsMod = createLinearDisplacements(sendcounts, getCommSize(comm));
+      AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>* h = nullptr;
+      MEDI_OPTIONAL_CONST int* sdisplsMod = sdispls;
+      int sdisplsTotalSize = 0;
+      if(nullptr != sdispls) {
+        sdisplsTotalSize = computeDisplacementsTotalSize(sendcounts, getCommOutDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          sdisplsMod = acquireLinearDisplacements(sendcounts, getCommOutDegree(comm));
+        }
+      }
+      MEDI_OPTIONAL_CONST int* rdisplsMod = rdispls;
+      int rdisplsTotalSize = 0;
+      if(nullptr != rdispls) {
+        rdisplsTotalSize = computeDisplacementsTotalSize(recvcounts, getCommInDegree(comm));
+        if(isModifiedBufferRequired(recvtype)) {
+          rdisplsMod = acquireLinearDisplacements(recvcounts, getCommInDegree(comm));
         }
       }
       typename SENDTYPE::ModifiedType* sendbufMod = nullptr;
       int sendbufElements = 0;
 
-      if(root == getCommRank(comm)) {
-        // compute the total size of the buffer
-        sendbufElements = displsTotalSize;
+      // compute the total size of the buffer
+      sendbufElements = sdisplsTotalSize;
 
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
-        } else {
-          sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
-        }
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->createModifiedTypeBuffer(sendbufMod, sendbufElements);
+      } else {
+        sendbufMod = reinterpret_cast<typename SENDTYPE::ModifiedType*>(const_cast<typename SENDTYPE::Type*>(sendbuf));
       }
       typename RECVTYPE::ModifiedType* recvbufMod = nullptr;
       int recvbufElements = 0;
 
       // compute the total size of the buffer
-      if(AMPI_IN_PLACE != recvbuf) {
-        recvbufElements = recvcount;
-      } else {
-        recvbufElements = sendcounts[getCommRank(comm)];
-      }
+      recvbufElements = rdisplsTotalSize;
 
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->createModifiedTypeBuffer(recvbufMod, recvbufElements);
       } else {
         recvbufMod = reinterpret_cast<typename RECVTYPE::ModifiedType*>(const_cast<typename RECVTYPE::Type*>(recvbuf));
       }
 
       // the handle is created if a reverse action should be recorded, h != nullptr => tape is active
-      if(recvtype->getADTool().isHandleRequired()) {
-        h = new AMPI_Scatterv_AdjointHandle<SENDTYPE, RECVTYPE>();
+      if(isHandleRequired(recvtype)) {
+        h = new (recvtype->getADTool().getHandleSlab()) AMPI_Neighbor_alltoallv_AdjointHandle<SENDTYPE, RECVTYPE>();
       }
       recvtype->getADTool().startAssembly(h);
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired()) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->copyIntoModifiedBuffer(sendbuf, displs[i], sendbufMod, displsMod[i], sendcounts[i]);
-          }
+      if(isModifiedBufferRequired(sendtype)) {
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          sendtype->copyIntoModifiedBuffer(sendbuf, sdispls[i], sendbufMod, sdisplsMod[i], sendcounts[i]);
         }
       }
 
@@ -11480,113 +19582,83 @@ namespace medi {
         // gather the information for the reverse sweep
 
         // create the index buffers
-        if(root == getCommRank(comm)) {
-          createLinearIndexCounts(h->sendbufCount, sendcounts, displs, getCommSize(comm), sendtype);
-          h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
-          recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
-        }
-        if(AMPI_IN_PLACE != recvbuf) {
-          h->recvbufCount = recvtype->computeActiveElements(recvcount);
-        } else {
-          h->recvbufCount = sendtype->computeActiveElements(displs[getCommRank(comm)] + sendcounts[getCommRank(
-                              comm)]) - sendtype->computeActiveElements(displs[getCommRank(comm)]);
-        }
+        createLinearIndexCounts(h->sendbufCount, sendcounts, sdispls, getCommOutDegree(comm), sendtype);
+        h->sendbufTotalSize = sendtype->computeActiveElements(sendbufElements);
+        recvtype->getADTool().createIndexTypeBuffer(h->sendbufIndices, h->sendbufTotalSize);
+        createLinearIndexCounts(h->recvbufCount, recvcounts, rdispls, getCommInDegree(comm), recvtype);
         h->recvbufTotalSize = recvtype->computeActiveElements(recvbufElements);
         recvtype->getADTool().createIndexTypeBuffer(h->recvbufIndices, h->recvbufTotalSize);
 
 
         // extract the old primal values from the recv buffer if the AD tool
         // needs the primal values reset
-        if(recvtype->getADTool().isOldPrimalsRequired()) {
+        if(isOldPrimalsRequired(recvtype)) {
           recvtype->getADTool().createPrimalTypeBuffer(h->recvbufOldPrimals, h->recvbufTotalSize);
-          if(AMPI_IN_PLACE != recvbuf) {
-            recvtype->getValues(recvbuf, 0, h->recvbufOldPrimals, 0, recvcount);
-          } else {
-            {
-              const int rank = getCommRank(comm);
-              sendtype->getValues(sendbuf, displs[rank], h->recvbufOldPrimals, 0, sendcounts[rank]);
-            }
+          for(int i = 0; i < getCommInDegree(comm); ++i) {
+            recvtype->getValues(recvbuf, rdispls[i], h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
           }
         }
 
 
-        if(root == getCommRank(comm)) {
-          for(int i = 0; i < getCommSize(comm); ++i) {
-            sendtype->getIndices(sendbuf, displs[i], h->sendbufIndices, displsMod[i], sendcounts[i]);
-          }
+        for(int i = 0; i < getCommOutDegree(comm); ++i) {
+          sendtype->getIndices(sendbuf, sdispls[i], h->sendbufIndices, sdisplsMod[i], sendcounts[i]);
         }
 
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->createIndices(recvbuf, 0, h->recvbufIndices, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->createIndices(sendbuf, displs[rank], h->recvbufIndices, 0, sendcounts[rank]);
-          }
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->createIndices(recvbuf, rdispls[i], h->recvbufIndices, rdisplsMod[i], recvcounts[i]);
         }
 
         // pack all the variables in the handle
-        h->funcReverse = AMPI_Scatterv_b<SENDTYPE, RECVTYPE>;
-        h->funcForward = AMPI_Scatterv_d<SENDTYPE, RECVTYPE>;
-        h->funcPrimal = AMPI_Scatterv_p<SENDTYPE, RECVTYPE>;
+        h->funcReverse = AMPI_Neighbor_alltoallv_b<SENDTYPE, RECVTYPE>;
+        h->funcForward = AMPI_Neighbor_alltoallv_d<SENDTYPE, RECVTYPE>;
+        h->funcPrimal = AMPI_Neighbor_alltoallv_p<SENDTYPE, RECVTYPE>;
         h->sendcounts = sendcounts;
-        h->displs = displs;
+        h->sdispls = sdispls;
         h->sendtype = sendtype;
-        h->recvcount = recvcount;
+        h->recvcounts = recvcounts;
+        h->rdispls = rdispls;
         h->recvtype = recvtype;
-        h->root = root;
-        h->comm = comm;
+        h->comm = getReverseComm(comm);
       }
 
-      if(!recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->clearIndices(recvbuf, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->clearIndices(sendbuf, displs[rank], sendcounts[rank]);
-          }
+      if(!isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->clearIndices(recvbuf, rdispls[i], recvcounts[i]);
         }
       }
 
-      rStatus = MPI_Scatterv(sendbufMod, sendcounts, displsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcount,
-                             recvtype->getModifiedMpiType(), root, comm);
+      rStatus = MPI_Neighbor_alltoallv(sendbufMod, sendcounts, sdisplsMod, sendtype->getModifiedMpiType(), recvbufMod, recvcounts,
+                                       rdisplsMod, recvtype->getModifiedMpiType(), comm);
       recvtype->getADTool().addToolAction(h);
 
-      if(recvtype->isModifiedBufferRequired()) {
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->copyFromModifiedBuffer(recvbuf, 0, recvbufMod, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->copyFromModifiedBuffer(sendbuf, displs[rank], sendbufMod, displsMod[rank], sendcounts[rank]);
-          }
+      if(isModifiedBufferRequired(recvtype)) {
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->copyFromModifiedBuffer(recvbuf, rdispls[i], recvbufMod, rdisplsMod[i], recvcounts[i]);
         }
       }
 
       if(nullptr != h) {
         // handle the recv buffers
-        if(AMPI_IN_PLACE != recvbuf) {
-          recvtype->registerValue(recvbuf, 0, h->recvbufIndices, h->recvbufOldPrimals, 0, recvcount);
-        } else {
-          {
-            const int rank = getCommRank(comm);
-            sendtype->registerValue(sendbuf, displs[rank], h->recvbufIndices, h->recvbufOldPrimals, 0, sendcounts[rank]);
-          }
+        for(int i = 0; i < getCommInDegree(comm); ++i) {
+          recvtype->registerValue(recvbuf, rdispls[i], h->recvbufIndices, h->recvbufOldPrimals, rdisplsMod[i], recvcounts[i]);
         }
+        // compress the index buffers
+        compressIndices(recvtype->getADTool(), h->sendbufIndices, h->sendbufIndicesRanges, h->sendbufTotalSize);
+        compressIndices(recvtype->getADTool(), h->recvbufIndices, h->recvbufIndicesRanges, h->recvbufTotalSize);
       }
 
       recvtype->getADTool().stopAssembly(h);
-      if(recvtype->isModifiedBufferRequired()) {
-        delete [] displsMod;
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(sdisplsMod);
+      }
+      if(isModifiedBufferRequired(recvtype)) {
+        releaseLinearDisplacements(rdisplsMod);
       }
 
-      if(root == getCommRank(comm)) {
-        if(sendtype->isModifiedBufferRequired() ) {
-          sendtype->deleteModifiedTypeBuffer(sendbufMod);
-        }
+      if(isModifiedBufferRequired(sendtype) ) {
+        sendtype->deleteModifiedTypeBuffer(sendbufMod);
       }
-      if(recvtype->isModifiedBufferRequired()  && !(AMPI_IN_PLACE == recvbuf)) {
+      if(isModifiedBufferRequired(recvtype) ) {
         recvtype->deleteModifiedTypeBuffer(recvbufMod);
       }
 
@@ -11785,13 +19857,19 @@ namespace medi {
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_create(AMPI_Comm comm, AMPI_Group group, AMPI_Comm* newcomm) {
-    return MPI_Comm_create(comm, group, newcomm);
+    int rStatus = MPI_Comm_create(comm, group, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_create_group(AMPI_Comm comm, AMPI_Group group, int tag, AMPI_Comm* newcomm) {
-    return MPI_Comm_create_group(comm, group, tag, newcomm);
+    int rStatus = MPI_Comm_create_group(comm, group, tag, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
@@ -11810,13 +19888,19 @@ namespace medi {
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_dup(AMPI_Comm comm, AMPI_Comm* newcomm) {
-    return MPI_Comm_dup(comm, newcomm);
+    int rStatus = MPI_Comm_dup(comm, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_dup_with_info(AMPI_Comm comm, AMPI_Info info, AMPI_Comm* newcomm) {
-    return MPI_Comm_dup_with_info(comm, info, newcomm);
+    int rStatus = MPI_Comm_dup_with_info(comm, info, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
@@ -11906,13 +19990,19 @@ namespace medi {
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_split(AMPI_Comm comm, int color, int key, AMPI_Comm* newcomm) {
-    return MPI_Comm_split(comm, color, key, newcomm);
+    int rStatus = MPI_Comm_split(comm, color, key, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   inline int AMPI_Comm_split_type(AMPI_Comm comm, int split_type, int key, AMPI_Info info, AMPI_Comm* newcomm) {
-    return MPI_Comm_split_type(comm, split_type, key, info, newcomm);
+    int rStatus = MPI_Comm_split_type(comm, split_type, key, info, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
@@ -11998,13 +20088,19 @@ namespace medi {
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Intercomm_create(AMPI_Comm local_comm, int local_leader, AMPI_Comm peer_comm, int remote_leader,
                                    int tag, AMPI_Comm* newintercomm) {
-    return MPI_Intercomm_create(local_comm, local_leader, peer_comm, remote_leader, tag, newintercomm);
+    int rStatus = MPI_Intercomm_create(local_comm, local_leader, peer_comm, remote_leader, tag, newintercomm);
+    createReverseComm(*newintercomm);
+
+    return rStatus;
   }
 
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Intercomm_merge(AMPI_Comm intercomm, int high, AMPI_Comm* newintracomm) {
-    return MPI_Intercomm_merge(intercomm, high, newintracomm);
+    int rStatus = MPI_Intercomm_merge(intercomm, high, newintracomm);
+    createReverseComm(*newintracomm);
+
+    return rStatus;
   }
 
 #endif
@@ -12108,7 +20204,10 @@ namespace medi {
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Cart_create(AMPI_Comm comm_old, int ndims, MEDI_OPTIONAL_CONST int* dims,
                               MEDI_OPTIONAL_CONST int* periods, int reorder, AMPI_Comm* comm_cart) {
-    return MPI_Cart_create(comm_old, ndims, dims, periods, reorder, comm_cart);
+    int rStatus = MPI_Cart_create(comm_old, ndims, dims, periods, reorder, comm_cart);
+    createReverseComm(*comm_cart);
+
+    return rStatus;
   }
 
 #endif
@@ -12139,7 +20238,10 @@ namespace medi {
 #endif
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Cart_sub(AMPI_Comm comm, MEDI_OPTIONAL_CONST int* remain_dims, AMPI_Comm* newcomm) {
-    return MPI_Cart_sub(comm, remain_dims, newcomm);
+    int rStatus = MPI_Cart_sub(comm, remain_dims, newcomm);
+    createReverseComm(*newcomm);
+
+    return rStatus;
   }
 
 #endif
@@ -12159,7 +20261,10 @@ namespace medi {
   inline int AMPI_Dist_graph_create(AMPI_Comm comm_old, int n, MEDI_OPTIONAL_CONST int* sources,
                                     MEDI_OPTIONAL_CONST int* degrees, MEDI_OPTIONAL_CONST int* destinations, MEDI_OPTIONAL_CONST int* weights,
                                     AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
-    return MPI_Dist_graph_create(comm_old, n, sources, degrees, destinations, weights, info, reorder, comm_dist_graph);
+    int rStatus = MPI_Dist_graph_create(comm_old, n, sources, degrees, destinations, weights, info, reorder, comm_dist_graph);
+    createReverseComm(*comm_dist_graph);
+
+    return rStatus;
   }
 
 #endif
@@ -12167,8 +20272,11 @@ namespace medi {
   inline int AMPI_Dist_graph_create_adjacent(AMPI_Comm comm_old, int indegree, MEDI_OPTIONAL_CONST int* sources,
       MEDI_OPTIONAL_CONST int* sourceweights, int outdegree, MEDI_OPTIONAL_CONST int* destinations,
       MEDI_OPTIONAL_CONST int* destweights, AMPI_Info info, int reorder, AMPI_Comm* comm_dist_graph) {
-    return MPI_Dist_graph_create_adjacent(comm_old, indegree, sources, sourceweights, outdegree, destinations, destweights,
+    int rStatus = MPI_Dist_graph_create_adjacent(comm_old, indegree, sources, sourceweights, outdegree, destinations, destweights,
                                           info, reorder, comm_dist_graph);
+    createReverseComm(*comm_dist_graph);
+
+    return rStatus;
   }
 
 #endif
@@ -12188,7 +20296,10 @@ namespace medi {
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Graph_create(AMPI_Comm comm_old, int nnodes, MEDI_OPTIONAL_CONST int* index,
                                MEDI_OPTIONAL_CONST int* edges, int reorder, AMPI_Comm* comm_graph) {
-    return MPI_Graph_create(comm_old, nnodes, index, edges, reorder, comm_graph);
+    int rStatus = MPI_Graph_create(comm_old, nnodes, index, edges, reorder, comm_graph);
+    createReverseComm(*comm_graph);
+
+    return rStatus;
   }
 
 #endif
@@ -12348,12 +20459,6 @@ namespace medi {
     return MPI_File_set_errhandler(file, errhandler);
   }
 
-#endif
-#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
-  inline int AMPI_Finalize() {
-    return MPI_Finalize();
-  }
-
 #endif
 #if MEDI_MPI_VERSION_2_0 <= MEDI_MPI_TARGET
   inline int AMPI_Finalized(int* flag) {
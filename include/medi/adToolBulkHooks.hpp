@@ -0,0 +1,213 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include "exceptions.hpp"
+#include "macros.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Array versions of the static methods of the StaticADToolInterface.
+   *
+   * An AD tool can provide the optional static methods
+   *  - setIntoModifyBufferArray(ModifiedType* modValues, const Type* values, int count)
+   *  - getFromModifyBufferArray(const ModifiedType* modValues, Type* values, int count)
+   *  - getIndexArray(const Type* values, IndexType* indices, int count)
+   *  - getValueArray(const Type* values, PrimalType* primals, int count)
+   *  - registerValueArray(Type* values, PrimalType* oldPrimals, IndexType* indices, int count)
+   *  - clearIndexArray(Type* values, int count)
+   *  - createIndexArray(Type* values, IndexType* indices, int count)
+   *
+   * If a method is present, it is called for the whole buffer. Otherwise a loop over the element wise method is used.
+   * The buffers do not overlap and are accessed with unit stride, so the loops can be vectorized by the compiler if the
+   * element wise methods are simple field accesses.
+   *
+   * setModifiedValue uses the element wise method setPrimalToMod(ModifiedType& modValue, const PrimalType& value) of the
+   * ToolInterface for the operators. It is optional, without it the primal values in a modified buffer can not be set
+   * and AMPI_Accumulate is not available for the AD types.
+   *
+   * @tparam ADTool  The implementation of the StaticADToolInterface.
+   */
+  template<typename ADTool>
+  struct ADToolBulkHooks {
+
+      typedef typename ADTool::Type Type;
+      typedef typename ADTool::ModifiedType ModifiedType;
+      typedef typename ADTool::PrimalType PrimalType;
+      typedef typename ADTool::IndexType IndexType;
+
+      static inline void setIntoModifyBuffer(ModifiedType* modValues, const Type* values, int count) {
+        setIntoModifyBufferImpl<ADTool>(modValues, values, count, 0);
+      }
+
+      static inline void getFromModifyBuffer(const ModifiedType* modValues, Type* values, int count) {
+        getFromModifyBufferImpl<ADTool>(modValues, values, count, 0);
+      }
+
+      static inline void getIndex(const Type* values, IndexType* indices, int count) {
+        getIndexImpl<ADTool>(values, indices, count, 0);
+      }
+
+      static inline void getValue(const Type* values, PrimalType* primals, int count) {
+        getValueImpl<ADTool>(values, primals, count, 0);
+      }
+
+      static inline void registerValue(Type* values, PrimalType* oldPrimals, IndexType* indices, int count) {
+        registerValueImpl<ADTool>(values, oldPrimals, indices, count, 0);
+      }
+
+      static inline void clearIndex(Type* values, int count) {
+        clearIndexImpl<ADTool>(values, count, 0);
+      }
+
+      static inline void createIndex(Type* values, IndexType* indices, int count) {
+        createIndexImpl<ADTool>(values, indices, count, 0);
+      }
+
+      static inline void setModifiedValue(ModifiedType* modValues, const PrimalType* primals, int count) {
+        setModifiedValueImpl<ADTool>(modValues, primals, count, 0);
+      }
+
+    private:
+
+      // The int overloads are selected if the tool provides the array method, the long overloads are the fallback.
+
+      template<typename T>
+      static inline auto setIntoModifyBufferImpl(ModifiedType* modValues, const Type* values, int count, int)
+          -> decltype(T::setIntoModifyBufferArray(modValues, values, count), void()) {
+        T::setIntoModifyBufferArray(modValues, values, count);
+      }
+
+      template<typename T>
+      static inline void setIntoModifyBufferImpl(ModifiedType* MEDI_RESTRICT modValues, const Type* MEDI_RESTRICT values, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          T::setIntoModifyBuffer(modValues[i], values[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto getFromModifyBufferImpl(const ModifiedType* modValues, Type* values, int count, int)
+          -> decltype(T::getFromModifyBufferArray(modValues, values, count), void()) {
+        T::getFromModifyBufferArray(modValues, values, count);
+      }
+
+      template<typename T>
+      static inline void getFromModifyBufferImpl(const ModifiedType* MEDI_RESTRICT modValues, Type* MEDI_RESTRICT values, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          T::getFromModifyBuffer(modValues[i], values[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto getIndexImpl(const Type* values, IndexType* indices, int count, int)
+          -> decltype(T::getIndexArray(values, indices, count), void()) {
+        T::getIndexArray(values, indices, count);
+      }
+
+      template<typename T>
+      static inline void getIndexImpl(const Type* MEDI_RESTRICT values, IndexType* MEDI_RESTRICT indices, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          indices[i] = T::getIndex(values[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto getValueImpl(const Type* values, PrimalType* primals, int count, int)
+          -> decltype(T::getValueArray(values, primals, count), void()) {
+        T::getValueArray(values, primals, count);
+      }
+
+      template<typename T>
+      static inline void getValueImpl(const Type* MEDI_RESTRICT values, PrimalType* MEDI_RESTRICT primals, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          primals[i] = T::getValue(values[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto registerValueImpl(Type* values, PrimalType* oldPrimals, IndexType* indices, int count, int)
+          -> decltype(T::registerValueArray(values, oldPrimals, indices, count), void()) {
+        T::registerValueArray(values, oldPrimals, indices, count);
+      }
+
+      template<typename T>
+      static inline void registerValueImpl(Type* MEDI_RESTRICT values, PrimalType* MEDI_RESTRICT oldPrimals, IndexType* MEDI_RESTRICT indices, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          T::registerValue(values[i], oldPrimals[i], indices[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto clearIndexImpl(Type* values, int count, int)
+          -> decltype(T::clearIndexArray(values, count), void()) {
+        T::clearIndexArray(values, count);
+      }
+
+      template<typename T>
+      static inline void clearIndexImpl(Type* MEDI_RESTRICT values, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          T::clearIndex(values[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto createIndexImpl(Type* values, IndexType* indices, int count, int)
+          -> decltype(T::createIndexArray(values, indices, count), void()) {
+        T::createIndexArray(values, indices, count);
+      }
+
+      template<typename T>
+      static inline void createIndexImpl(Type* MEDI_RESTRICT values, IndexType* MEDI_RESTRICT indices, int count, long) {
+        for(int i = 0; i < count; ++i) {
+          T::createIndex(values[i], indices[i]);
+        }
+      }
+
+      template<typename T>
+      static inline auto setModifiedValueImpl(ModifiedType* modValues, const PrimalType* primals, int count, int)
+          -> decltype(T::setPrimalToMod(*modValues, *primals), void()) {
+        for(int i = 0; i < count; ++i) {
+          T::setPrimalToMod(modValues[i], primals[i]);
+        }
+      }
+
+      template<typename T>
+      static inline void setModifiedValueImpl(ModifiedType* modValues, const PrimalType* primals, int count, long) {
+        MEDI_UNUSED(modValues);
+        MEDI_UNUSED(primals);
+        MEDI_UNUSED(count);
+
+        MEDI_EXCEPTION("The AD tool does not provide setPrimalToMod, the primal values in modified buffers can not be set.");
+      }
+  };
+}
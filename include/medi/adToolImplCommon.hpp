@@ -56,25 +56,19 @@ namespace medi {
       }
 
       inline void createPrimalTypeBuffer(PrimalType* &buf, size_t size) const {
-        buf = new PrimalType[size];
+        buf = this->getBufferArena().template createArray<PrimalType>(size);
       }
 
       inline void createIndexTypeBuffer(IndexType* &buf, size_t size) const {
-        buf = new IndexType[size];
+        buf = this->getBufferArena().template createArray<IndexType>(size);
       }
 
-        inline void deletePrimalTypeBuffer(PrimalType* &buf) const {
-          if(NULL != buf) {
-            delete [] buf;
-            buf = NULL;
-          }
-        }
+      inline void deletePrimalTypeBuffer(PrimalType* &buf) const {
+        this->getBufferArena().deleteArray(buf);
+      }
 
       inline void deleteIndexTypeBuffer(IndexType* &buf) const {
-        if(NULL != buf) {
-          delete [] buf;
-          buf = NULL;
-        }
+        this->getBufferArena().deleteArray(buf);
       }
   };
 }
@@ -29,6 +29,8 @@
 #pragma once
 
 #include "ampi/op.hpp"
+#include "bufferArena.hpp"
+#include "handleSlab.hpp"
 #include "typeDefinitions.h"
 
 /**
@@ -36,6 +38,23 @@
  */
 namespace medi {
 
+  /**
+   * @brief Properties of an AD tool that are known at compile time.
+   *
+   * If isStatic() is true, MeDiPack uses the values of isActive(), needsModifiedBuffer() and needsOldPrimals() instead
+   * of the virtual methods of the ADToolInterface. For passive types, all AD handling is then removed by the compiler.
+   * The default leaves all decisions to the run time. AD tools can specialize the structure for their types.
+   *
+   * @tparam Tool  The implementation of the ADToolInterface.
+   */
+  template<typename Tool>
+  struct ADToolTraits {
+      static constexpr bool isStatic() {return false;}  ///< If the values below are valid.
+      static constexpr bool isActive() {return true;}  ///< See ADToolInterface::isActiveType.
+      static constexpr bool needsModifiedBuffer() {return true;}  ///< See ADToolInterface::isModifiedBufferRequired.
+      static constexpr bool needsOldPrimals() {return true;}  ///< See ADToolInterface::isOldPrimalsRequired.
+  };
+
   /**
    * @brief The interface for the AD tool that is accessed by MeDiPack.
    */
@@ -44,6 +63,9 @@ namespace medi {
       MPI_Datatype primalMpiType;
       MPI_Datatype adjointMpiType;
 
+      mutable BufferArena bufferArena;
+      mutable HandleSlab handleSlab;
+
     public:
 
       /**
@@ -77,7 +99,9 @@ namespace medi {
        */
       ADToolInterface(MPI_Datatype primalMpiType, MPI_Datatype adjointMpiType) :
         primalMpiType(primalMpiType),
-        adjointMpiType(adjointMpiType) {}
+        adjointMpiType(adjointMpiType),
+        bufferArena(),
+        handleSlab() {}
 
       virtual ~ADToolInterface() {}
 
@@ -98,6 +122,58 @@ namespace medi {
         return adjointMpiType;
       }
 
+      /**
+       * @brief Indicates if the adjoint values can be summed with MPI_SUM during the reverse communication.
+       *
+       * The reverse operations of reductions and broadcasts gather the adjoint values from all ranks and combine them
+       * with AdjointInterface::combineAdjoints. If the adjoint mpi type is a predefined numeric type, MPI_SUM is defined
+       * on it and the adjoint values are summed by an MPI reduction instead. AD tools with a combineAdjoints that is not
+       * a plain sum need to return false here.
+       *
+       * @return true if MPI_SUM can be applied to the adjoint mpi type.
+       */
+      virtual bool isAdjointSumSupported() const {
+        if(MPI_DATATYPE_NULL == adjointMpiType || MPI_BYTE == adjointMpiType || MPI_PACKED == adjointMpiType) {
+          return false;
+        }
+
+        int numIntegers;
+        int numAddresses;
+        int numDatatypes;
+        int combiner;
+        MEDI_CHECK_ERROR(MPI_Type_get_envelope(adjointMpiType, &numIntegers, &numAddresses, &numDatatypes, &combiner));
+
+        return MPI_COMBINER_NAMED == combiner;
+      }
+
+      /**
+       * @brief The arena from which the index, primal and modified buffers of this AD tool are created.
+       *
+       * The AD tool can use the arena for the adjoint buffers of its AdjointInterface implementation. MeDiPack does not
+       * reset the arena, in the mode BufferArenaMode::TapeLifetime the AD tool has to call BufferArena::reset when its
+       * tape is reset. The AD tool has to delete all handles of its tape before it is destroyed, since the handles
+       * hold buffers of the arena.
+       *
+       * @return The buffer arena of the AD tool.
+       */
+      BufferArena& getBufferArena() const {
+        return bufferArena;
+      }
+
+      /**
+       * @brief The slab in which MeDiPack creates the handles that are given to the AD tool with addToolAction.
+       *
+       * The AD tool deletes the handles as before. It should call HandleSlab::reset when the tape is reset, so that the
+       * memory of the slab is used again for the next recording. The deletion of a handle gives its memory back to the
+       * slab, therefore the AD tool has to reset or delete its tape before it is destroyed. The slab aborts with an
+       * exception if it is destroyed while handles are alive.
+       *
+       * @return The handle slab of the AD tool.
+       */
+      HandleSlab& getHandleSlab() const {
+        return handleSlab;
+      }
+
       /**
        * @brief If this AD interface represents an AD type.
        * @return true if it is an AD type.
@@ -197,6 +273,9 @@ namespace medi {
    * @brief The static methods for the AD tool interface.
    *
    * All these static methods need to be implemented by the AD tool
+   *
+   * The tool can additionally provide array versions of the methods, e.g. getIndexArray(values, indices, count).
+   * These are optional and are used for whole buffers when present. See ADToolBulkHooks for the list of the methods.
    */
   struct StaticADToolInterface : public ADToolInterface {
 
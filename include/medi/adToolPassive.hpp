@@ -85,4 +85,15 @@ namespace medi {
         buf = nullptr;
       }
   };
+
+  /**
+   * @brief The passive tool never handles AD types.
+   */
+  template<>
+  struct ADToolTraits<ADToolPassive> {
+      static constexpr bool isStatic() {return true;}
+      static constexpr bool isActive() {return false;}
+      static constexpr bool needsModifiedBuffer() {return false;}
+      static constexpr bool needsOldPrimals() {return false;}
+  };
 }
@@ -0,0 +1,766 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+#include "adToolImplCommon.hpp"
+#include "adjointInterface.hpp"
+#include "bufferArena.hpp"
+#include "handleSlab.hpp"
+#include "macros.h"
+#include "medi.hpp"
+#include "ampi/types/indexTypeHelper.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief A minimal reverse mode AD tool that ships with MeDiPack.
+   *
+   * The tool records the statements of the program with their partial derivatives on a linear index tape. It is
+   * used for the tests and benchmarks of MeDiPack without a third party AD library. The supported operations are
+   * limited to the basic arithmetic and a few elementary functions.
+   *
+   * Usage:
+   * \code{.cpp}
+   *   reference::Tool* tool = new reference::Tool();  // after AMPI_Init
+   *   reference::Tape& tape = reference::Real::getGlobalTape();
+   *   tape.setActive();
+   *   tape.registerInput(x);
+   *   // ... computation with AMPI_Send(&x, 1, tool->MPI_TYPE, ...)
+   *   tape.registerOutput(y);
+   *   tape.gradient(y.getGradientData()) = 1.0;
+   *   tape.evaluate();
+   * \endcode
+   */
+  namespace reference {
+
+    struct Real;
+
+    /**
+     * @brief The tape of the reference AD tool.
+     *
+     * Each statement stores the index of its left hand side and the end of its arguments in the argument and
+     * Jacobian vectors. Index 0 is the passive index. The handles of MeDiPack are stored with the position of the
+     * statement at which they have been recorded.
+     *
+     * The adjoint vector has `dimension` entries for each index.
+     */
+    struct Tape {
+      private:
+
+        struct Statement {
+            int lhs;
+            size_t argEnd;
+        };
+
+        struct External {
+            size_t statementPos;
+            HandleBase* handle;
+        };
+
+        bool active;
+        int indexCounter;
+        int dimension;
+        bool reverse;
+
+        std::vector<Statement> statements;
+        std::vector<int> arguments;
+        std::vector<double> jacobians;
+        std::vector<External> externals;
+        std::vector<double> adjoints;
+
+        BufferArena arena;
+        std::vector<BufferArena*> toolArenas;
+        std::vector<HandleSlab*> toolSlabs;
+
+        friend struct TapeAdjointInterface;
+
+      public:
+
+        Tape() :
+          active(false),
+          indexCounter(0),
+          dimension(1),
+          reverse(true),
+          statements(),
+          arguments(),
+          jacobians(),
+          externals(),
+          adjoints(),
+          arena(),
+          toolArenas(),
+          toolSlabs() {}
+
+        ~Tape() {
+          for(External& e : externals) {
+            delete e.handle;
+          }
+        }
+
+        /**
+         * @return The tape that is used by all reference::Real values.
+         */
+        static Tape& getGlobalTape() {
+          static Tape tape;
+
+          return tape;
+        }
+
+        void setActive() {
+          active = true;
+        }
+
+        void setPassive() {
+          active = false;
+        }
+
+        bool isActive() const {
+          return active;
+        }
+
+        /**
+         * @brief Set the number of adjoint directions for vector mode.
+         *
+         * Can only be changed on an empty tape.
+         *
+         * @param[in] dim  The number of directions.
+         */
+        void setDimension(int dim) {
+          dimension = dim;
+          adjoints.clear();
+        }
+
+        int getDimension() const {
+          return dimension;
+        }
+
+        /**
+         * @return A new index for an active value.
+         */
+        int createIndex() {
+          return ++indexCounter;
+        }
+
+        /**
+         * @brief Record a statement.
+         *
+         * Passive arguments are not stored. If all arguments are passive, no statement is recorded.
+         *
+         * @param[in]     count  The number of arguments.
+         * @param[in]   indices  The indices of the arguments.
+         * @param[in]      jacs  The partial derivatives with respect to the arguments.
+         *
+         * @return The index of the left hand side, 0 if it is passive.
+         */
+        int pushStatement(int count, const int* indices, const double* jacs) {
+          size_t start = arguments.size();
+          for(int i = 0; i < count; ++i) {
+            if(0 != indices[i]) {
+              arguments.push_back(indices[i]);
+              jacobians.push_back(jacs[i]);
+            }
+          }
+
+          if(start == arguments.size()) {
+            return 0;
+          }
+
+          int lhs = createIndex();
+          statements.push_back(Statement{lhs, arguments.size()});
+
+          return lhs;
+        }
+
+        /**
+         * @brief Store a MeDiPack handle at the current position of the tape. The tape takes the ownership.
+         */
+        void pushExternalFunction(HandleBase* handle) {
+          externals.push_back(External{statements.size(), handle});
+        }
+
+        /**
+         * @brief Register the buffers of an AD tool such that they are reset with the tape.
+         */
+        void registerToolBuffers(BufferArena* toolArena, HandleSlab* toolSlab) {
+          toolArenas.push_back(toolArena);
+          toolSlabs.push_back(toolSlab);
+        }
+
+        /**
+         * @brief Remove the buffers of an AD tool, see registerToolBuffers.
+         */
+        void unregisterToolBuffers(BufferArena* toolArena, HandleSlab* toolSlab) {
+          for(size_t i = 0; i < toolArenas.size(); ++i) {
+            if(toolArenas[i] == toolArena && toolSlabs[i] == toolSlab) {
+              toolArenas.erase(toolArenas.begin() + i);
+              toolSlabs.erase(toolSlabs.begin() + i);
+              break;
+            }
+          }
+        }
+
+        /**
+         * @brief Access to the adjoint of an index.
+         *
+         * @param[in] index  The index of the value.
+         * @param[in]   dim  The direction in vector mode.
+         *
+         * @return Reference to the adjoint value.
+         */
+        double& gradient(int index, int dim = 0) {
+          resizeAdjoints();
+
+          return adjoints[(size_t)index * dimension + dim];
+        }
+
+        inline void registerInput(Real& value);
+        inline void registerOutput(Real& value);
+
+        inline void evaluate();
+        inline void evaluateForward();
+
+        /**
+         * @brief Delete all statements and handles and set all adjoints to zero.
+         */
+        void reset() {
+          for(External& e : externals) {
+            delete e.handle;
+          }
+          externals.clear();
+          statements.clear();
+          arguments.clear();
+          jacobians.clear();
+
+          indexCounter = 0;
+          std::fill(adjoints.begin(), adjoints.end(), 0.0);
+
+          arena.reset();
+          for(BufferArena* toolArena : toolArenas) {
+            toolArena->reset();
+          }
+          for(HandleSlab* toolSlab : toolSlabs) {
+            toolSlab->reset();
+          }
+        }
+
+      private:
+
+        // seeds of passive values are written to index 0, they must not be propagated
+        void clearPassiveAdjoint() {
+          for(int d = 0; d < dimension; ++d) {
+            adjoints[d] = 0.0;
+          }
+        }
+
+        void resizeAdjoints() {
+          size_t size = (size_t)(indexCounter + 1) * dimension;
+          if(adjoints.size() < size) {
+            adjoints.resize(size, 0.0);
+          }
+        }
+    };
+
+    /**
+     * @brief The active floating point type of the reference AD tool.
+     *
+     * The index is 0 if the value is passive.
+     */
+    struct Real {
+        double value;
+        int index;
+
+        typedef Tape TapeType;
+        typedef double Real_t;
+
+        Real() : value(0.0), index(0) {}
+        Real(double value) : value(value), index(0) {}
+        Real(const Real& o) = default;
+
+        Real& operator=(const Real& o) = default;
+        Real& operator=(double v) {
+          value = v;
+          index = 0;
+
+          return *this;
+        }
+
+        static Tape& getGlobalTape() {
+          return Tape::getGlobalTape();
+        }
+
+        double getValue() const {
+          return value;
+        }
+
+        int& getGradientData() {
+          return index;
+        }
+
+        double& gradient() {
+          return getGlobalTape().gradient(index);
+        }
+
+        inline Real& operator+=(const Real& o);
+        inline Real& operator-=(const Real& o);
+        inline Real& operator*=(const Real& o);
+        inline Real& operator/=(const Real& o);
+    };
+
+    /**
+     * @brief Creates the result of an operation and records the statement if the tape is active.
+     */
+    inline Real createResult(double value, int count, const int* indices, const double* jacobians) {
+      Real r(value);
+      Tape& tape = Tape::getGlobalTape();
+      if(tape.isActive()) {
+        r.index = tape.pushStatement(count, indices, jacobians);
+      }
+
+      return r;
+    }
+
+    inline Real createUnary(double value, const Real& a, double da) {
+      int indices[1] = {a.index};
+      double jacobians[1] = {da};
+
+      return createResult(value, 1, indices, jacobians);
+    }
+
+    inline Real createBinary(double value, const Real& a, double da, const Real& b, double db) {
+      int indices[2] = {a.index, b.index};
+      double jacobians[2] = {da, db};
+
+      return createResult(value, 2, indices, jacobians);
+    }
+
+    inline Real operator+(const Real& a, const Real& b) {
+      return createBinary(a.value + b.value, a, 1.0, b, 1.0);
+    }
+
+    inline Real operator-(const Real& a, const Real& b) {
+      return createBinary(a.value - b.value, a, 1.0, b, -1.0);
+    }
+
+    inline Real operator*(const Real& a, const Real& b) {
+      return createBinary(a.value * b.value, a, b.value, b, a.value);
+    }
+
+    inline Real operator/(const Real& a, const Real& b) {
+      return createBinary(a.value / b.value, a, 1.0 / b.value, b, -a.value / (b.value * b.value));
+    }
+
+    inline Real operator-(const Real& a) {
+      return createUnary(-a.value, a, -1.0);
+    }
+
+    inline Real operator+(const Real& a) {
+      return a;
+    }
+
+    inline Real sqrt(const Real& a) {
+      double s = std::sqrt(a.value);
+      return createUnary(s, a, 0.5 / s);
+    }
+
+    inline Real exp(const Real& a) {
+      double e = std::exp(a.value);
+      return createUnary(e, a, e);
+    }
+
+    inline Real log(const Real& a) {
+      return createUnary(std::log(a.value), a, 1.0 / a.value);
+    }
+
+    inline Real sin(const Real& a) {
+      return createUnary(std::sin(a.value), a, std::cos(a.value));
+    }
+
+    inline Real cos(const Real& a) {
+      return createUnary(std::cos(a.value), a, -std::sin(a.value));
+    }
+
+    inline Real fabs(const Real& a) {
+      return a.value < 0.0 ? -a : a;
+    }
+
+    inline Real abs(const Real& a) {
+      return fabs(a);
+    }
+
+    inline Real& Real::operator+=(const Real& o) {
+      return *this = *this + o;
+    }
+
+    inline Real& Real::operator-=(const Real& o) {
+      return *this = *this - o;
+    }
+
+    inline Real& Real::operator*=(const Real& o) {
+      return *this = *this * o;
+    }
+
+    inline Real& Real::operator/=(const Real& o) {
+      return *this = *this / o;
+    }
+
+    inline bool operator<(const Real& a, const Real& b) {
+      return a.value < b.value;
+    }
+
+    inline bool operator>(const Real& a, const Real& b) {
+      return a.value > b.value;
+    }
+
+    inline bool operator<=(const Real& a, const Real& b) {
+      return a.value <= b.value;
+    }
+
+    inline bool operator>=(const Real& a, const Real& b) {
+      return a.value >= b.value;
+    }
+
+    inline bool operator==(const Real& a, const Real& b) {
+      return a.value == b.value;
+    }
+
+    inline bool operator!=(const Real& a, const Real& b) {
+      return a.value != b.value;
+    }
+
+    inline std::ostream& operator<<(std::ostream& out, const Real& a) {
+      return out << a.value;
+    }
+
+    inline void Tape::registerInput(Real& value) {
+      if(active) {
+        value.index = createIndex();
+      }
+    }
+
+    inline void Tape::registerOutput(Real& value) {
+      if(active && 0 != value.index) {
+        int indices[1] = {value.index};
+        double jacs[1] = {1.0};
+        value.index = pushStatement(1, indices, jacs);
+      }
+    }
+
+    /**
+     * @brief Implementation of the AdjointInterface for the reference tape.
+     *
+     * In the reverse evaluation getAdjoints sets the adjoints to zero, in the forward evaluation they are kept.
+     */
+    struct TapeAdjointInterface : public AdjointInterface {
+        Tape& tape;
+
+        TapeAdjointInterface(Tape& tape) : tape(tape) {}
+
+        int computeElements(int elements) const {
+          return elements * tape.dimension;
+        }
+
+        int getVectorSize() const {
+          return tape.dimension;
+        }
+
+        void createPrimalTypeBuffer(void* &buf, size_t size) const {
+          buf = tape.arena.createArray<double>(size);
+        }
+
+        void deletePrimalTypeBuffer(void* &buf) const {
+          tape.arena.deleteArray(reinterpret_cast<double*&>(buf));
+        }
+
+        void createAdjointTypeBuffer(void* &buf, size_t size) const {
+          buf = tape.arena.createArray<double>(size * tape.dimension);
+        }
+
+        void deleteAdjointTypeBuffer(void* &buf) const {
+          tape.arena.deleteArray(reinterpret_cast<double*&>(buf));
+        }
+
+        void combineAdjoints(void* buf, const int elements, const int ranks) const {
+          double* adjoints = static_cast<double*>(buf);
+          int dim = tape.dimension;
+
+          for(int i = 0; i < elements; ++i) {
+            for(int r = 1; r < ranks; ++r) {
+              for(int d = 0; d < dim; ++d) {
+                adjoints[i * dim + d] += adjoints[(elements * r + i) * dim + d];
+              }
+            }
+          }
+        }
+
+        void getAdjoints(const void* i, void* a, int elements) const {
+          const int* indices = static_cast<const int*>(i);
+          double* adjoints = static_cast<double*>(a);
+          int dim = tape.dimension;
+
+          for(int pos = 0; pos < elements; ++pos) {
+            for(int d = 0; d < dim; ++d) {
+              double& adjoint = tape.gradient(indices[pos], d);
+              adjoints[pos * dim + d] = adjoint;
+              if(tape.reverse) {
+                adjoint = 0.0;
+              }
+            }
+          }
+        }
+
+        void updateAdjoints(const void* i, const void* a, int elements) const {
+          const int* indices = static_cast<const int*>(i);
+          const double* adjoints = static_cast<const double*>(a);
+          int dim = tape.dimension;
+
+          for(int pos = 0; pos < elements; ++pos) {
+            if(0 != indices[pos]) {
+              for(int d = 0; d < dim; ++d) {
+                tape.gradient(indices[pos], d) += adjoints[pos * dim + d];
+              }
+            }
+          }
+        }
+
+        void getPrimals(const void* i, const void* p, int elements) const {
+          MEDI_UNUSED(i);
+          MEDI_UNUSED(p);
+          MEDI_UNUSED(elements);
+        }
+
+        void setPrimals(const void* i, const void* p, int elements) const {
+          MEDI_UNUSED(i);
+          MEDI_UNUSED(p);
+          MEDI_UNUSED(elements);
+        }
+    };
+
+    inline void Tape::evaluate() {
+      resizeAdjoints();
+      clearPassiveAdjoint();
+      reverse = true;
+      TapeAdjointInterface adjointInterface(*this);
+
+      size_t curExternal = externals.size();
+      for(size_t pos = statements.size(); ; --pos) {
+        while(0 < curExternal && externals[curExternal - 1].statementPos == pos) {
+          curExternal -= 1;
+          HandleBase* h = externals[curExternal].handle;
+          h->funcReverse(h, &adjointInterface);
+        }
+
+        if(0 == pos) {
+          break;
+        }
+
+        const Statement& stmt = statements[pos - 1];
+        size_t argStart = (2 <= pos) ? statements[pos - 2].argEnd : 0;
+        for(int d = 0; d < dimension; ++d) {
+          double lhsAdjoint = adjoints[(size_t)stmt.lhs * dimension + d];
+          adjoints[(size_t)stmt.lhs * dimension + d] = 0.0;
+          for(size_t k = argStart; k < stmt.argEnd; ++k) {
+            adjoints[(size_t)arguments[k] * dimension + d] += jacobians[k] * lhsAdjoint;
+          }
+        }
+      }
+    }
+
+    inline void Tape::evaluateForward() {
+      resizeAdjoints();
+      clearPassiveAdjoint();
+      reverse = false;
+      TapeAdjointInterface adjointInterface(*this);
+
+      size_t curExternal = 0;
+      for(size_t pos = 0; ; ++pos) {
+        while(curExternal < externals.size() && externals[curExternal].statementPos == pos) {
+          HandleBase* h = externals[curExternal].handle;
+          h->funcForward(h, &adjointInterface);
+          curExternal += 1;
+        }
+
+        if(pos == statements.size()) {
+          break;
+        }
+
+        const Statement& stmt = statements[pos];
+        size_t argStart = (1 <= pos) ? statements[pos - 1].argEnd : 0;
+        for(int d = 0; d < dimension; ++d) {
+          double lhsTangent = 0.0;
+          for(size_t k = argStart; k < stmt.argEnd; ++k) {
+            lhsTangent += jacobians[k] * adjoints[(size_t)arguments[k] * dimension + d];
+          }
+          adjoints[(size_t)stmt.lhs * dimension + d] = lhsTangent;
+        }
+      }
+      reverse = true;
+    }
+
+    /**
+     * @brief The MeDiPack interface of the reference AD tool.
+     *
+     * The tool needs to be created after AMPI_Init and deleted before AMPI_Finalize.
+     *
+     * @tparam modifiedBuffer  If the values are sent through the modified buffers with the primal value and the
+     *                         index. This exercises the code paths of primal value taping tools.
+     */
+    template<bool modifiedBuffer = false>
+    class ToolImpl final : public ADToolImplCommon<ToolImpl<modifiedBuffer>, false, modifiedBuffer, Real, void, double,
+                                                   int> {
+      public:
+
+        typedef ADToolImplCommon<ToolImpl<modifiedBuffer>, false, modifiedBuffer, Real, void, double, int> Base;
+
+        typedef Real Type;
+        typedef void AdjointType;
+        typedef Real ModifiedType;
+        typedef double PrimalType;
+        typedef int IndexType;
+
+        typedef MpiTypeDefault<ToolImpl> MediType;
+        typedef FunctionHelper<Real, Real, double, int, double, ToolImpl> FuncHelper;
+        typedef OperatorHelper<FuncHelper> OpHelper;
+
+        MediType* MPI_TYPE;
+        AMPI_Datatype MPI_INT_TYPE;
+
+      private:
+
+        OpHelper opHelper;
+        MPI_Datatype modifiedType;
+
+      public:
+
+        ToolImpl() : Base(MPI_DOUBLE, MPI_DOUBLE) {
+          MPI_Type_contiguous(sizeof(Real), MPI_BYTE, &modifiedType);
+          MPI_Type_commit(&modifiedType);
+
+          Tape::getGlobalTape().registerToolBuffers(&this->getBufferArena(), &this->getHandleSlab());
+
+          MPI_TYPE = new MediType(this, modifiedType, modifiedType);
+          opHelper.init();
+          MPI_INT_TYPE = OpHelper::createIntType(MPI_TYPE);
+        }
+
+        ~ToolImpl() {
+          OpHelper::freeIntType(MPI_INT_TYPE);
+          opHelper.finalize();
+          delete MPI_TYPE;
+          MPI_Type_free(&modifiedType);
+
+          Tape::getGlobalTape().unregisterToolBuffers(&this->getBufferArena(), &this->getHandleSlab());
+        }
+
+        inline bool isHandleRequired() const {
+          return Tape::getGlobalTape().isActive();
+        }
+
+        inline void startAssembly(HandleBase* h) const {
+          MEDI_UNUSED(h);
+        }
+
+        inline void stopAssembly(HandleBase* h) const {
+          MEDI_UNUSED(h);
+        }
+
+        inline void addToolAction(HandleBase* h) const {
+          if(nullptr != h) {
+            Tape::getGlobalTape().pushExternalFunction(h);
+          }
+        }
+
+        inline AMPI_Op convertOperator(AMPI_Op op) const {
+          return opHelper.convertOperator(op);
+        }
+
+        static inline void setIntoModifyBuffer(ModifiedType& modValue, const Type& value) {
+          modValue = value;
+        }
+
+        static inline void getFromModifyBuffer(const ModifiedType& modValue, Type& value) {
+          value = modValue;
+        }
+
+        static inline IndexType getIndex(const Type& value) {
+          return value.index;
+        }
+
+        static inline void clearIndex(Type& value) {
+          MEDI_UNUSED(value);
+        }
+
+        static inline void createIndex(Type& value, IndexType& index) {
+          MEDI_UNUSED(value);
+
+          index = 0;
+        }
+
+        static inline PrimalType getValue(const Type& value) {
+          return value.value;
+        }
+
+        static inline void registerValue(Type& value, PrimalType& oldPrimal, IndexType& index) {
+          MEDI_UNUSED(oldPrimal);
+
+          // the received index is the one of the sender, it only tells if the value is active
+          bool wasActive = 0 != value.index;
+          value.index = 0;
+          if(wasActive) {
+            value.index = Tape::getGlobalTape().createIndex();
+          }
+          index = value.index;
+        }
+
+        static inline PrimalType getPrimalFromMod(const ModifiedType& modValue) {
+          return modValue.value;
+        }
+
+        static inline void setPrimalToMod(ModifiedType& modValue, const PrimalType& value) {
+          modValue.value = value;
+        }
+
+        static inline void modifyDependency(ModifiedType& in, ModifiedType& inout) {
+          if(0 != in.index || 0 != inout.index) {
+            inout.index = -1;
+          }
+        }
+    };
+
+    /**
+     * @brief The reference AD tool that sends the values directly.
+     */
+    typedef ToolImpl<false> Tool;
+  }
+}
@@ -0,0 +1,290 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include "../macros.h"
+#include "reverseComm.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief The precision of the adjoint values in the messages of the reverse point to point communication.
+   *
+   * The reduced precisions are only applied if the adjoint MPI type of the AD tool is MPI_DOUBLE. The adjoints are
+   * converted back to double before they are given to the AD tool, so the accumulation is still performed in double.
+   */
+  enum class AdjointPrecision {
+    Default,  ///< Use the global precision, see setAdjointPrecision.
+    Full,     ///< Send the adjoints with the adjoint MPI type of the AD tool.
+    Float,    ///< Send the adjoints as float.
+    BFloat16  ///< Send the adjoints as bfloat16, that is a float with an 8 bit mantissa.
+  };
+
+  /**
+   * @brief Counters for the conversion errors of the reduced precision transport.
+   *
+   * The counters are updated on the sending side of the adjoint messages.
+   */
+  struct AdjointPrecisionStatistics {
+      long convertedElements;  ///< Number of adjoint values that were sent with a reduced precision.
+      long savedBytes;         ///< Number of bytes saved by the reduced precision.
+      double sumAbsError;      ///< Sum of the absolute conversion errors.
+      double maxAbsError;      ///< Maximum absolute conversion error.
+      double maxRelError;      ///< Maximum relative conversion error of the nonzero values.
+
+      AdjointPrecisionStatistics() :
+        convertedElements(0),
+        savedBytes(0),
+        sumAbsError(0.0),
+        maxAbsError(0.0),
+        maxRelError(0.0) {}
+  };
+
+  /**
+   * @brief Access to the global precision for the adjoint messages.
+   *
+   * @return Reference to the global precision.
+   */
+  inline AdjointPrecision& globalAdjointPrecision() {
+    static AdjointPrecision precision = AdjointPrecision::Full;
+
+    return precision;
+  }
+
+  /**
+   * @return Reference to the global counters of the reduced precision transport.
+   */
+  inline AdjointPrecisionStatistics& globalAdjointPrecisionStatistics() {
+    static AdjointPrecisionStatistics statistics;
+
+    return statistics;
+  }
+
+  /**
+   * @return The key for the precision attribute of the communicators. It is created on the first call.
+   */
+  inline int getAdjointPrecisionKeyval() {
+    static int keyval = MPI_KEYVAL_INVALID;
+    if(MPI_KEYVAL_INVALID == keyval) {
+      // the precision is stored as the value of the attribute pointer, duplicated communicators inherit it
+      MPI_Comm_create_keyval(MPI_COMM_DUP_FN, MPI_COMM_NULL_DELETE_FN, &keyval, nullptr);
+    }
+
+    return keyval;
+  }
+
+  /**
+   * @brief Set the global precision for the adjoint messages.
+   *
+   * Needs to be called with the same argument on all processes, before the reverse evaluation.
+   *
+   * @param[in] precision  The new precision. AdjointPrecision::Default selects the full precision.
+   */
+  inline void setAdjointPrecision(AdjointPrecision precision) {
+    if(AdjointPrecision::Default == precision) {
+      precision = AdjointPrecision::Full;
+    }
+
+    globalAdjointPrecision() = precision;
+  }
+
+  /**
+   * @brief Set the precision for the adjoint messages on one communicator.
+   *
+   * Needs to be called by all processes of the communicator. Communicators created with MPI_Comm_dup inherit the
+   * precision. The precision is also set on the duplicate for the replay, see getReverseComm.
+   *
+   * @param[in]      comm  The communicator of the primal messages.
+   * @param[in] precision  The precision for the communicator. AdjointPrecision::Default selects the global precision.
+   */
+  inline void setAdjointPrecision(MPI_Comm comm, AdjointPrecision precision) {
+    void* value = reinterpret_cast<void*>(static_cast<intptr_t>(precision));
+    MPI_Comm_set_attr(comm, getAdjointPrecisionKeyval(), value);
+
+    MPI_Comm reverseComm = getReverseComm(comm);
+    if(reverseComm != comm) {
+      MPI_Comm_set_attr(reverseComm, getAdjointPrecisionKeyval(), value);
+    }
+  }
+
+  /**
+   * @brief The precision for the adjoint messages on a communicator.
+   *
+   * @param[in]        comm  The communicator of the primal messages.
+   * @param[in] adjointType  The adjoint MPI type of the AD tool.
+   *
+   * @return The precision of the communicator or the global one. AdjointPrecision::Full if the adjoint type is not
+   *         MPI_DOUBLE.
+   */
+  inline AdjointPrecision getAdjointPrecision(MPI_Comm comm, MPI_Datatype adjointType) {
+    if(MPI_DOUBLE != adjointType) {
+      return AdjointPrecision::Full;
+    }
+
+    AdjointPrecision precision = AdjointPrecision::Default;
+
+    void* value;
+    int flag = 0;
+    MPI_Comm_get_attr(comm, getAdjointPrecisionKeyval(), &value, &flag);
+    if(flag) {
+      precision = static_cast<AdjointPrecision>(reinterpret_cast<intptr_t>(value));
+    }
+
+    if(AdjointPrecision::Default == precision) {
+      precision = globalAdjointPrecision();
+    }
+
+    return precision;
+  }
+
+  /**
+   * @return The counters of the reduced precision transport on this process.
+   */
+  inline const AdjointPrecisionStatistics& getAdjointPrecisionStatistics() {
+    return globalAdjointPrecisionStatistics();
+  }
+
+  /**
+   * @brief Set all counters of the reduced precision transport to zero.
+   */
+  inline void resetAdjointPrecisionStatistics() {
+    globalAdjointPrecisionStatistics() = AdjointPrecisionStatistics();
+  }
+
+  /**
+   * @brief Conversion of double adjoints to and from the reduced precisions.
+   */
+  struct ReducedAdjoints {
+
+      /**
+       * @return The size of one converted value in bytes.
+       */
+      static int getElementSize(AdjointPrecision precision) {
+        switch(precision) {
+          case AdjointPrecision::Float:
+            return (int)sizeof(float);
+          case AdjointPrecision::BFloat16:
+            return (int)sizeof(uint16_t);
+          default:
+            return (int)sizeof(double);
+        }
+      }
+
+      /**
+       * @brief Convert the adjoints to the reduced precision and update the error counters.
+       *
+       * @param[in]  adjoints  The double adjoints.
+       * @param[out]  reduced  The converted values, the size is elements * getElementSize(precision) bytes.
+       * @param[in]  elements  The number of adjoints.
+       * @param[in] precision  The reduced precision.
+       */
+      static void convertDown(const double* adjoints, char* reduced, int elements, AdjointPrecision precision) {
+        AdjointPrecisionStatistics& statistics = globalAdjointPrecisionStatistics();
+
+        for(int i = 0; i < elements; ++i) {
+          double value = adjoints[i];
+          double converted;
+          if(AdjointPrecision::Float == precision) {
+            float f = (float)value;
+            std::memcpy(&reduced[i * sizeof(float)], &f, sizeof(float));
+            converted = (double)f;
+          } else {
+            uint16_t b = floatToBFloat16((float)value);
+            std::memcpy(&reduced[i * sizeof(uint16_t)], &b, sizeof(uint16_t));
+            converted = (double)bFloat16ToFloat(b);
+          }
+
+          double error = std::abs(value - converted);
+          statistics.sumAbsError += error;
+          if(error > statistics.maxAbsError) {
+            statistics.maxAbsError = error;
+          }
+          if(0.0 != value && error / std::abs(value) > statistics.maxRelError) {
+            statistics.maxRelError = error / std::abs(value);
+          }
+        }
+
+        statistics.convertedElements += elements;
+        statistics.savedBytes += (long)elements * (sizeof(double) - getElementSize(precision));
+      }
+
+      /**
+       * @brief Convert the received values back to double.
+       *
+       * @param[in]   reduced  The values in the reduced precision.
+       * @param[out] adjoints  The double adjoints.
+       * @param[in]  elements  The number of adjoints.
+       * @param[in] precision  The reduced precision.
+       */
+      static void convertUp(const char* reduced, double* adjoints, int elements, AdjointPrecision precision) {
+        for(int i = 0; i < elements; ++i) {
+          if(AdjointPrecision::Float == precision) {
+            float f;
+            std::memcpy(&f, &reduced[i * sizeof(float)], sizeof(float));
+            adjoints[i] = (double)f;
+          } else {
+            uint16_t b;
+            std::memcpy(&b, &reduced[i * sizeof(uint16_t)], sizeof(uint16_t));
+            adjoints[i] = (double)bFloat16ToFloat(b);
+          }
+        }
+      }
+
+    private:
+
+      static uint16_t floatToBFloat16(float value) {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+
+        if(std::isnan(value)) {
+          return (uint16_t)((bits >> 16) | 0x0040u); // keep a quiet NaN
+        }
+
+        // round to nearest even
+        bits += 0x7FFFu + ((bits >> 16) & 1u);
+
+        return (uint16_t)(bits >> 16);
+      }
+
+      static float bFloat16ToFloat(uint16_t value) {
+        uint32_t bits = (uint32_t)value << 16;
+        float f;
+        std::memcpy(&f, &bits, sizeof(float));
+
+        return f;
+      }
+  };
+}
@@ -0,0 +1,357 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include "../macros.h"
+#include "adjointPrecision.hpp"
+#include "async.hpp"
+#include "persistentReverse.hpp"
+#include "reverseAggregation.hpp"
+#include "sparseAdjoints.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief The adjoint messages of the reverse point to point communication.
+   *
+   * If neither the sparse transfer nor a reduced precision is enabled, the adjoints are sent with the adjoint MPI type
+   * of the AD tool. Otherwise the messages are sent as bytes. The sender converts the adjoints to the reduced precision
+   * and encodes them in the sparse format, the receiver reverts both steps.
+   *
+   * Small messages are sent in the aggregated transfers if the aggregation is enabled, see ReverseAggregationSettings.
+   * The other nonblocking messages can use persistent requests, see PersistentReverseSettings.
+   */
+  struct AdjointTransport {
+
+      /**
+       * @return True if the adjoints are sent as bytes.
+       */
+      static bool isPacked(AdjointPrecision precision) {
+        return globalSparseAdjointSettings().enabled || AdjointPrecision::Full != precision;
+      }
+
+      /**
+       * @return True if the message is sent in an aggregated transfer.
+       */
+      static bool isAggregated(int peer, int elements, MPI_Datatype adjointType) {
+        return ReverseAggregation::isAggregated(peer, elements * SparseAdjoints::getElementSize(adjointType));
+      }
+
+      /**
+       * @return The number of bytes of a receive operation.
+       */
+      static int getReceivedBytes(MPI_Status* status) {
+        int bytes;
+        MPI_Get_count(status, MPI_BYTE, &bytes);
+
+        return bytes;
+      }
+
+      /**
+       * @brief Create the message for the adjoints.
+       *
+       * @return The message which needs to be deleted with delete [] or nullptr if the adjoint buffer can be sent
+       *         directly.
+       */
+      static char* createMessage(void* adjoints, int elements, MPI_Datatype adjointType, AdjointPrecision precision,
+                                 int& bytes) {
+        char* data = reinterpret_cast<char*>(adjoints);
+        int elementSize = SparseAdjoints::getElementSize(adjointType);
+        char* reduced = nullptr;
+
+        if(AdjointPrecision::Full != precision) {
+          elementSize = ReducedAdjoints::getElementSize(precision);
+          reduced = new char[elements * elementSize];
+          ReducedAdjoints::convertDown(reinterpret_cast<double*>(adjoints), reduced, elements, precision);
+          data = reduced;
+        }
+
+        bytes = elements * elementSize;
+        if(globalSparseAdjointSettings().enabled) {
+          char* sparse = SparseAdjoints::encode(data, elements, elementSize, bytes);
+          if(nullptr != sparse) {
+            delete [] reduced;
+            reduced = sparse;
+          }
+        }
+
+        return reduced;
+      }
+
+      /**
+       * @return The buffer for the receive of the message, the adjoint buffer or a temporary one.
+       */
+      static char* createRecvBuffer(void* adjoints, int elements, AdjointPrecision precision, int& bytes) {
+        if(AdjointPrecision::Full != precision) {
+          bytes = elements * ReducedAdjoints::getElementSize(precision);
+          return new char[bytes];
+        } else {
+          return reinterpret_cast<char*>(adjoints);
+        }
+      }
+
+      /**
+       * @brief Expand the received message into the adjoint buffer and delete the temporary buffer.
+       *
+       * An empty message, e.g. from MPI_PROC_NULL, leaves the adjoint buffer unchanged.
+       */
+      static void finishRecv(char* buffer, void* adjoints, int elements, MPI_Datatype adjointType,
+                             AdjointPrecision precision, int bytes) {
+        if(AdjointPrecision::Full != precision) {
+          if(0 != bytes) {
+            SparseAdjoints::decode(buffer, elements, ReducedAdjoints::getElementSize(precision), bytes);
+            ReducedAdjoints::convertUp(buffer, reinterpret_cast<double*>(adjoints), elements, precision);
+          }
+          delete [] buffer;
+        } else if(0 != bytes) {
+          SparseAdjoints::decode(adjoints, elements, SparseAdjoints::getElementSize(adjointType), bytes);
+        }
+      }
+  };
+
+  /**
+   * @brief Data of a nonblocking receive of adjoints, which is expanded after the wait.
+   */
+  struct AdjointRecvData {
+      char* buffer;
+      void* adjoints;
+      int elements;
+      MPI_Datatype adjointType;
+      AdjointPrecision precision;
+      bool isAggregated;
+      AggregatedRecv aggregatedRecv;
+
+      static void finishFunc(void* data, MPI_Status* status) {
+        AdjointRecvData* recvData = reinterpret_cast<AdjointRecvData*>(data);
+
+        int bytes;
+        if(recvData->isAggregated) {
+          ReverseAggregation::global().waitRecv(&recvData->aggregatedRecv);
+          bytes = recvData->aggregatedRecv.bytes;
+        } else {
+          bytes = AdjointTransport::getReceivedBytes(status);
+        }
+
+        AdjointTransport::finishRecv(recvData->buffer, recvData->adjoints, recvData->elements, recvData->adjointType,
+                                     recvData->precision, bytes);
+      }
+
+      static void deleteFunc(void* data) {
+        delete reinterpret_cast<AdjointRecvData*>(data);
+      }
+  };
+
+  /**
+   * @brief Deletes the message of a nonblocking send after the wait.
+   */
+  inline void deleteAdjointMessage(void* data) {
+    delete [] reinterpret_cast<char*>(data);
+  }
+
+  /**
+   * @brief Send the adjoints to the process that sent the primal values.
+   */
+  inline void sendAdjoints(void* adjoints, int elements, MPI_Datatype adjointType, int dest, int tag,
+                           AMPI_Comm comm) {
+    AdjointPrecision precision = getAdjointPrecision(comm, adjointType);
+    if(AdjointTransport::isAggregated(dest, elements, adjointType)) {
+      int bytes;
+      char* message = AdjointTransport::createMessage(adjoints, elements, adjointType, precision, bytes);
+      ReverseAggregation::global().addSend(comm, dest, tag, nullptr != message ? (void*)message : adjoints, bytes);
+      ReverseAggregation::global().flush();
+      delete [] message;
+    } else if(AdjointTransport::isPacked(precision)) {
+      int bytes;
+      char* message = AdjointTransport::createMessage(adjoints, elements, adjointType, precision, bytes);
+      MPI_Send(nullptr != message ? (void*)message : adjoints, bytes, MPI_BYTE, dest, tag, comm);
+      delete [] message;
+    } else {
+      MPI_Send(adjoints, elements, adjointType, dest, tag, comm);
+    }
+  }
+
+  /**
+   * @brief Nonblocking version of sendAdjoints. The message is deleted with the reverse data of the request.
+   *
+   * Aggregated messages are only collected, they are sent with the flush after the start of all requests of the wait.
+   */
+  inline void isendAdjoints(void* adjoints, int elements, MPI_Datatype adjointType, int dest, int tag,
+                            AMPI_Comm comm, AMPI_Request* request) {
+    AdjointPrecision precision = getAdjointPrecision(comm, adjointType);
+    if(AdjointTransport::isAggregated(dest, elements, adjointType)) {
+      int bytes;
+      char* message = AdjointTransport::createMessage(adjoints, elements, adjointType, precision, bytes);
+      ReverseAggregation::global().addSend(comm, dest, tag, nullptr != message ? (void*)message : adjoints, bytes);
+      delete [] message;
+    } else if(AdjointTransport::isPacked(precision)) {
+      int bytes;
+      char* message = AdjointTransport::createMessage(adjoints, elements, adjointType, precision, bytes);
+      if(nullptr != message) {
+        request->setReverseData(message, deleteAdjointMessage);
+      }
+      MPI_Isend(nullptr != message ? (void*)message : adjoints, bytes, MPI_BYTE, dest, tag, comm, &request->request);
+    } else if(globalPersistentReverseSettings().enabled) {
+      PersistentReverseRequest::start(adjoints, elements, adjointType, dest, tag, comm, true, request);
+    } else {
+      MPI_Isend(adjoints, elements, adjointType, dest, tag, comm, &request->request);
+    }
+  }
+
+  /**
+   * @brief Receive the adjoints from the process that received the primal values.
+   */
+  inline void recvAdjoints(void* adjoints, int elements, MPI_Datatype adjointType, int src, int tag, AMPI_Comm comm) {
+    AdjointPrecision precision = getAdjointPrecision(comm, adjointType);
+    if(AdjointTransport::isAggregated(src, elements, adjointType)) {
+      int bytes = elements * SparseAdjoints::getElementSize(adjointType);
+      char* buffer = AdjointTransport::createRecvBuffer(adjoints, elements, precision, bytes);
+      AggregatedRecv recv(comm, src, tag, buffer, bytes);
+      ReverseAggregation::global().postRecv(&recv);
+      ReverseAggregation::global().waitRecv(&recv);
+      AdjointTransport::finishRecv(buffer, adjoints, elements, adjointType, precision, recv.bytes);
+    } else if(AdjointTransport::isPacked(precision)) {
+      int bytes = elements * SparseAdjoints::getElementSize(adjointType);
+      char* buffer = AdjointTransport::createRecvBuffer(adjoints, elements, precision, bytes);
+      MPI_Status status;
+      MPI_Recv(buffer, bytes, MPI_BYTE, src, tag, comm, &status);
+      AdjointTransport::finishRecv(buffer, adjoints, elements, adjointType, precision,
+                                   AdjointTransport::getReceivedBytes(&status));
+    } else {
+      MPI_Recv(adjoints, elements, adjointType, src, tag, comm, MPI_STATUS_IGNORE);
+    }
+  }
+
+  /**
+   * @brief Nonblocking version of recvAdjoints. The adjoints are expanded in waitReverse.
+   */
+  inline void irecvAdjoints(void* adjoints, int elements, MPI_Datatype adjointType, int src, int tag, AMPI_Comm comm,
+                            AMPI_Request* request) {
+    AdjointPrecision precision = getAdjointPrecision(comm, adjointType);
+    bool isAggregated = AdjointTransport::isAggregated(src, elements, adjointType);
+    if(isAggregated || AdjointTransport::isPacked(precision)) {
+      int bytes = elements * SparseAdjoints::getElementSize(adjointType);
+      AdjointRecvData* recvData = new AdjointRecvData();
+      recvData->buffer = AdjointTransport::createRecvBuffer(adjoints, elements, precision, bytes);
+      recvData->adjoints = adjoints;
+      recvData->elements = elements;
+      recvData->adjointType = adjointType;
+      recvData->precision = precision;
+      recvData->isAggregated = isAggregated;
+      request->setReverseData(recvData, AdjointRecvData::deleteFunc, AdjointRecvData::finishFunc);
+
+      if(isAggregated) {
+        recvData->aggregatedRecv = AggregatedRecv(comm, src, tag, recvData->buffer, bytes);
+        ReverseAggregation::global().postRecv(&recvData->aggregatedRecv);
+      } else {
+        MPI_Irecv(recvData->buffer, bytes, MPI_BYTE, src, tag, comm, &request->request);
+      }
+    } else if(globalPersistentReverseSettings().enabled) {
+      PersistentReverseRequest::start(adjoints, elements, adjointType, src, tag, comm, false, request);
+    } else {
+      MPI_Irecv(adjoints, elements, adjointType, src, tag, comm, &request->request);
+    }
+  }
+
+  /**
+   * @brief Combined version of sendAdjoints and recvAdjoints.
+   *
+   * If only one of the messages is aggregated, the other one is sent or received with a nonblocking call.
+   */
+  inline void sendrecvAdjoints(void* sendAdjoints, int sendElements, MPI_Datatype sendType, int dest,
+                               int sendtag, void* recvAdjoints, int recvElements, MPI_Datatype recvType, int source,
+                               int recvtag, AMPI_Comm comm, MPI_Status* status) {
+    AdjointPrecision sendPrecision = getAdjointPrecision(comm, sendType);
+    AdjointPrecision recvPrecision = getAdjointPrecision(comm, recvType);
+    bool sendAggregated = AdjointTransport::isAggregated(dest, sendElements, sendType);
+    bool recvAggregated = AdjointTransport::isAggregated(source, recvElements, recvType);
+    bool sendPacked = AdjointTransport::isPacked(sendPrecision);
+    bool recvPacked = AdjointTransport::isPacked(recvPrecision);
+
+    if(sendAggregated || recvAggregated) {
+      ReverseAggregation& aggregation = ReverseAggregation::global();
+
+      int recvBytes = recvElements * SparseAdjoints::getElementSize(recvType);
+      char* buffer = AdjointTransport::createRecvBuffer(recvAdjoints, recvElements, recvPrecision, recvBytes);
+      AggregatedRecv recv(comm, source, recvtag, buffer, recvBytes);
+      MPI_Request recvRequest = MPI_REQUEST_NULL;
+      if(recvAggregated) {
+        aggregation.postRecv(&recv);
+      } else if(recvPacked) {
+        MPI_Irecv(buffer, recvBytes, MPI_BYTE, source, recvtag, comm, &recvRequest);
+      } else {
+        MPI_Irecv(recvAdjoints, recvElements, recvType, source, recvtag, comm, &recvRequest);
+      }
+
+      int sendBytes;
+      char* message = AdjointTransport::createMessage(sendAdjoints, sendElements, sendType, sendPrecision, sendBytes);
+      void* sendData = nullptr != message ? (void*)message : sendAdjoints;
+      MPI_Request sendRequest = MPI_REQUEST_NULL;
+      if(sendAggregated) {
+        aggregation.addSend(comm, dest, sendtag, sendData, sendBytes);
+        aggregation.flush();
+      } else if(sendPacked) {
+        MPI_Isend(sendData, sendBytes, MPI_BYTE, dest, sendtag, comm, &sendRequest);
+      } else {
+        MPI_Isend(sendAdjoints, sendElements, sendType, dest, sendtag, comm, &sendRequest);
+      }
+
+      if(recvAggregated) {
+        aggregation.waitRecv(&recv);
+        recvBytes = recv.bytes;
+      } else {
+        MPI_Status recvStatus;
+        MPI_Wait(&recvRequest, &recvStatus);
+        recvBytes = AdjointTransport::getReceivedBytes(&recvStatus);
+      }
+      MPI_Wait(&sendRequest, MPI_STATUS_IGNORE);
+      delete [] message;
+
+      if(recvAggregated || recvPacked) {
+        AdjointTransport::finishRecv(buffer, recvAdjoints, recvElements, recvType, recvPrecision, recvBytes);
+      }
+    } else if(sendPacked || recvPacked) {
+      int sendBytes;
+      char* message = AdjointTransport::createMessage(sendAdjoints, sendElements, sendType, sendPrecision, sendBytes);
+      int recvBytes = recvElements * SparseAdjoints::getElementSize(recvType);
+      char* buffer = AdjointTransport::createRecvBuffer(recvAdjoints, recvElements, recvPrecision, recvBytes);
+      MPI_Status recvStatus;
+      MPI_Sendrecv(nullptr != message ? (void*)message : sendAdjoints, sendBytes, MPI_BYTE, dest, sendtag,
+                   buffer, recvBytes, MPI_BYTE, source, recvtag, comm, &recvStatus);
+      AdjointTransport::finishRecv(buffer, recvAdjoints, recvElements, recvType, recvPrecision,
+                                   AdjointTransport::getReceivedBytes(&recvStatus));
+      delete [] message;
+    } else {
+      MPI_Sendrecv(sendAdjoints, sendElements, sendType, dest, sendtag, recvAdjoints, recvElements, recvType, source,
+                   recvtag, comm, status);
+    }
+  }
+}
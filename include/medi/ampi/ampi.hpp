@@ -35,6 +35,8 @@
 #include "operatorFunctions.hpp"
 #include "typeInterface.hpp"
 #include "typeDefault.hpp"
+#include "typeTraits.hpp"
+#include "win.hpp"
 #include "wrappers.hpp"
 
 #include "../../../generated/medi/ampiDefinitions.h"
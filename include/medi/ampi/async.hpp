@@ -28,6 +28,8 @@
 
 #pragma once
 
+#include <algorithm>
+
 #include "ampiMisc.h"
 
 #include "../../../generated/medi/ampiDefinitions.h"
@@ -39,6 +41,7 @@
 namespace medi {
 
   typedef void (*DeleteReverseData)(void* data);
+  typedef void (*FinishReverseData)(void* data, MPI_Status* status);
 
   struct AsyncHandle;
 
@@ -56,6 +59,11 @@ namespace medi {
       // required for reverse communication that needs to create data
       void* reverseData;
       DeleteReverseData deleteDataFunc;
+      FinishReverseData finishDataFunc;
+
+      // required for reverse communication that keeps its data over several evaluations
+      void* persistentData;
+      DeleteReverseData deletePersistentFunc;
 
       AMPI_Request() :
         request(MPI_REQUEST_NULL),
@@ -65,11 +73,15 @@ namespace medi {
         end(NULL),
         isActive(false),
         reverseData(NULL),
-        deleteDataFunc(NULL){}
+        deleteDataFunc(NULL),
+        finishDataFunc(NULL),
+        persistentData(NULL),
+        deletePersistentFunc(NULL){}
 
-      inline void setReverseData(void* data, DeleteReverseData func) {
+      inline void setReverseData(void* data, DeleteReverseData func, FinishReverseData finishFunc = NULL) {
         this->reverseData = data;
         this->deleteDataFunc = func;
+        this->finishDataFunc = finishFunc;
       }
 
       inline void deleteReverseData() {
@@ -77,6 +89,18 @@ namespace medi {
            this->deleteDataFunc(this->reverseData);
         }
       }
+
+      inline void setPersistentData(void* data, DeleteReverseData func) {
+        this->persistentData = data;
+        this->deletePersistentFunc = func;
+      }
+
+      inline void deletePersistentData() {
+        if(NULL != persistentData) {
+          this->deletePersistentFunc(this->persistentData);
+          this->persistentData = NULL;
+        }
+      }
   };
 
   inline bool operator ==(const AMPI_Request& a, const AMPI_Request& b) {
@@ -96,6 +120,10 @@ namespace medi {
 
     AsyncAdjointHandle() :
       HandleBase() {}
+
+    ~AsyncAdjointHandle() {
+      requestReverse.deletePersistentData();
+    }
   };
 
   struct AsyncHandle : public HandleBase {
@@ -164,8 +192,93 @@ namespace medi {
     }
   }
 
+  /**
+   * @brief Wait for a communication of the reverse or forward evaluation.
+   *
+   * The reverse data of the request is finished with the status of the communication and deleted afterwards.
+   *
+   * @param[in,out] request  The request of the communication in the handle.
+   */
+  inline void waitReverse(AMPI_Request* request) {
+    MPI_Status status;
+    MPI_Wait(&request->request, &status);
+
+    if(NULL != request->reverseData) {
+      if(NULL != request->finishDataFunc) {
+        request->finishDataFunc(request->reverseData, &status);
+      }
+      request->deleteReverseData();
+      request->setReverseData(NULL, NULL);
+    }
+  }
+
+  /**
+   * @brief True while the requests of AMPI_Wait, AMPI_Test and their variants are finished.
+   *
+   * The first finished request with an active handle records the flush of the aggregated reverse messages, see
+   * recordReverseAggregationFlush.
+   *
+   * @return Reference to the global flag.
+   */
+  inline bool& isWaitBoundaryOpen() {
+    static bool open = false;
+
+    return open;
+  }
+
+  /**
+   * @brief Grow only buffer for the conversion of AMPI_Request arrays into MPI_Request arrays.
+   */
+  struct RequestConversionBuffer {
+      MPI_Request* data;
+      int size;
+
+      RequestConversionBuffer() :
+        data(nullptr),
+        size(0) {}
+
+      ~RequestConversionBuffer() {
+        delete [] data;
+      }
+
+      /**
+       * @brief Get a buffer that can hold at least count requests.
+       *
+       * @param[in] count  The number of requests.
+       * @return The buffer, it is valid until the next call.
+       */
+      inline MPI_Request* reserve(int count) {
+        if(size < count) {
+          delete [] data;
+          size = std::max(count, 2 * size);
+          data = new MPI_Request[size];
+        }
+
+        return data;
+      }
+  };
+
+  /**
+   * @return The conversion buffer of this thread.
+   */
+  inline RequestConversionBuffer& getRequestConversionBuffer() {
+    static thread_local RequestConversionBuffer buffer;
+
+    return buffer;
+  }
+
+  /**
+   * @brief Copy the MPI requests of an AMPI_Request array into the conversion buffer.
+   *
+   * The result must not be deleted. It is valid until the next conversion on the same thread, so it has to be used
+   * before any reverse action is performed.
+   *
+   * @param[in] array  The AMPI requests.
+   * @param[in] count  The number of requests.
+   * @return The MPI requests.
+   */
   inline MPI_Request* convertToMPI(AMPI_Request* array, int count) {
-    MPI_Request* converted = new MPI_Request[count];
+    MPI_Request* converted = getRequestConversionBuffer().reserve(count);
 
     for(int i = 0; i < count; ++i) {
       converted[i] = array[i].request;
@@ -182,7 +295,9 @@ namespace medi {
 
     int rStatus = MPI_Wait(&request->request, status);
 
+    isWaitBoundaryOpen() = true;
     performReverseAction(request);
+    isWaitBoundaryOpen() = false;
 
     return rStatus;
   }
@@ -198,7 +313,9 @@ namespace medi {
     int rStatus = MPI_Test(&request->request, flag, status);
 
     if(true == *flag) {
+      isWaitBoundaryOpen() = true;
       performReverseAction(request);
+      isWaitBoundaryOpen() = false;
     }
 
     return rStatus;
@@ -221,18 +338,16 @@ namespace medi {
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   inline int AMPI_Startall(int count, AMPI_Request* array_of_requests) {
-    MPI_Request* array = convertToMPI(array_of_requests, count);
-
     for(int i = 0; i < count; ++i) {
       if(AMPI_REQUEST_NULL != array_of_requests[i]) {
         performStartAction(&array_of_requests[i]);
       }
     }
 
+    // the start actions are performed first, since they may use the conversion buffer
+    MPI_Request* array = convertToMPI(array_of_requests, count);
     int rStatus = MPI_Startall(count, array);
 
-    delete [] array;
-
     return rStatus;
   }
 #endif
@@ -263,11 +378,11 @@ namespace medi {
     int rStatus = MPI_Waitany(count, array, index, status);
 
     if(MPI_UNDEFINED != *index) {
+      isWaitBoundaryOpen() = true;
       performReverseAction(&array_of_requests[*index]);
+      isWaitBoundaryOpen() = false;
     }
 
-    delete [] array;
-
     return rStatus;
   }
 #endif
@@ -280,12 +395,12 @@ namespace medi {
 
     if(true == *flag) {
       if(MPI_UNDEFINED != *index) {
+        isWaitBoundaryOpen() = true;
         performReverseAction(&array_of_requests[*index]);
+        isWaitBoundaryOpen() = false;
       }
     }
 
-    delete [] array;
-
     return rStatus;
   }
 #endif
@@ -296,13 +411,13 @@ namespace medi {
 
     int rStatus = MPI_Waitall(count, array, array_of_statuses);
 
+    isWaitBoundaryOpen() = true;
     for(int i = 0; i < count; ++i) {
       if(AMPI_REQUEST_NULL != array_of_requests[i]) {
         performReverseAction(&array_of_requests[i]);
       }
     }
-
-    delete [] array;
+    isWaitBoundaryOpen() = false;
 
     return rStatus;
   }
@@ -315,15 +430,15 @@ namespace medi {
     int rStatus = MPI_Testall(count, array, flag, array_of_statuses);
 
     if(true == *flag) {
+      isWaitBoundaryOpen() = true;
       for(int i = 0; i < count; ++i) {
         if(AMPI_REQUEST_NULL != array_of_requests[i]) {
           performReverseAction(&array_of_requests[i]);
         }
       }
+      isWaitBoundaryOpen() = false;
     }
 
-    delete [] array;
-
     return rStatus;
   }
 #endif
@@ -334,14 +449,14 @@ namespace medi {
 
     int rStatus = MPI_Waitsome(incount, array, outcount, array_of_indices, array_of_statuses);
 
+    isWaitBoundaryOpen() = true;
     for(int i = 0; i < *outcount; ++i) {
       int index = array_of_indices[i];
       if(AMPI_REQUEST_NULL != array_of_requests[index]) {
         performReverseAction(&array_of_requests[index]);
       }
     }
-
-    delete [] array;
+    isWaitBoundaryOpen() = false;
 
     return rStatus;
   }
@@ -353,14 +468,14 @@ namespace medi {
 
     int rStatus = MPI_Testsome(incount, array, outcount, array_of_indices, array_of_statuses);
 
+    isWaitBoundaryOpen() = true;
     for(int i = 0; i < *outcount; ++i) {
       int index = array_of_indices[i];
       if(AMPI_REQUEST_NULL != array_of_requests[index]) {
         performReverseAction(&array_of_requests[index]);
       }
     }
-
-    delete [] array;
+    isWaitBoundaryOpen() = false;
 
     return rStatus;
   }
@@ -0,0 +1,271 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "../macros.h"
+#include "../mpiTools.h"
+#include "reverseComm.hpp"
+
+#ifndef MEDI_CollectiveHierarchyThreshold
+  /**
+   * @brief The default message size in bytes from which CollectiveHierarchy::Threshold uses the node hierarchy.
+   *
+   * It can be set with the preprocessor macro MEDI_CollectiveHierarchyThreshold=<bytes>
+   */
+  #define MEDI_CollectiveHierarchyThreshold 65536
+#endif
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief The algorithm for the adjoint and tangent communication of the reductions and broadcasts.
+   *
+   * The node hierarchy first combines the values on each node, then only the first rank of each node communicates
+   * between the nodes and finally the result is distributed on each node. It is only used if the communicator spans
+   * several nodes and at least one node has several ranks, see getCommHierarchyInfo.
+   */
+  enum class CollectiveHierarchy {
+    Default,    ///< Use the global setting, see setCollectiveHierarchy.
+    Flat,       ///< Use one MPI call on the whole communicator.
+    Node,       ///< Use the node hierarchy.
+    Threshold   ///< Use the node hierarchy if the message has at least the threshold size.
+  };
+
+  /**
+   * @brief Access to the global algorithm for the adjoint and tangent communication of the reductions.
+   *
+   * @return Reference to the global algorithm.
+   */
+  inline CollectiveHierarchy& globalCollectiveHierarchy() {
+    static CollectiveHierarchy hierarchy = CollectiveHierarchy::Threshold;
+
+    return hierarchy;
+  }
+
+  /**
+   * @brief Access to the global message size for CollectiveHierarchy::Threshold.
+   *
+   * @return Reference to the size in bytes.
+   */
+  inline long& globalCollectiveHierarchyThreshold() {
+    static long threshold = MEDI_CollectiveHierarchyThreshold;
+
+    return threshold;
+  }
+
+  /**
+   * @return The key for the hierarchy attribute of the communicators. It is created on the first call.
+   */
+  inline int getCollectiveHierarchyKeyval() {
+    static int keyval = MPI_KEYVAL_INVALID;
+    if(MPI_KEYVAL_INVALID == keyval) {
+      // the algorithm is stored as the value of the attribute pointer, duplicated communicators inherit it
+      MPI_Comm_create_keyval(MPI_COMM_DUP_FN, MPI_COMM_NULL_DELETE_FN, &keyval, nullptr);
+    }
+
+    return keyval;
+  }
+
+  /**
+   * @brief Set the global algorithm for the adjoint and tangent communication of the reductions.
+   *
+   * Needs to be called with the same arguments on all processes, before the evaluation of the tape.
+   *
+   * @param[in] hierarchy  The new algorithm. CollectiveHierarchy::Default selects CollectiveHierarchy::Threshold.
+   * @param[in] threshold  The message size in bytes for CollectiveHierarchy::Threshold.
+   */
+  inline void setCollectiveHierarchy(CollectiveHierarchy hierarchy,
+                                     long threshold = MEDI_CollectiveHierarchyThreshold) {
+    if(CollectiveHierarchy::Default == hierarchy) {
+      hierarchy = CollectiveHierarchy::Threshold;
+    }
+
+    globalCollectiveHierarchy() = hierarchy;
+    globalCollectiveHierarchyThreshold() = threshold;
+  }
+
+  /**
+   * @brief Set the algorithm for the adjoint and tangent communication of the reductions on one communicator.
+   *
+   * Needs to be called by all processes of the communicator. Communicators created with MPI_Comm_dup inherit the
+   * algorithm, a duplicate can be used to select the algorithm for single calls. The algorithm is also set on the
+   * duplicate for the replay, see getReverseComm.
+   *
+   * @param[in]      comm  The communicator of the primal reductions.
+   * @param[in] hierarchy  The algorithm for the communicator. CollectiveHierarchy::Default selects the global one.
+   */
+  inline void setCollectiveHierarchy(MPI_Comm comm, CollectiveHierarchy hierarchy) {
+    void* value = reinterpret_cast<void*>(static_cast<intptr_t>(hierarchy));
+    MPI_Comm_set_attr(comm, getCollectiveHierarchyKeyval(), value);
+
+    MPI_Comm reverseComm = getReverseComm(comm);
+    if(reverseComm != comm) {
+      MPI_Comm_set_attr(reverseComm, getCollectiveHierarchyKeyval(), value);
+    }
+  }
+
+  /**
+   * @brief Decides if the node hierarchy is used for a message.
+   *
+   * The first call that selects the node hierarchy for a communicator is collective, see getCommHierarchyInfo.
+   *
+   * @param[in]  comm  The communicator of the reduction.
+   * @param[in] count  The number of elements in the message.
+   * @param[in]  type  The data type of the elements.
+   *
+   * @return True if the node hierarchy is used.
+   */
+  inline bool isCollectiveHierarchyUsed(MPI_Comm comm, int count, MPI_Datatype type) {
+    CollectiveHierarchy hierarchy = CollectiveHierarchy::Default;
+
+    void* value;
+    int flag = 0;
+    MPI_Comm_get_attr(comm, getCollectiveHierarchyKeyval(), &value, &flag);
+    if(flag) {
+      hierarchy = static_cast<CollectiveHierarchy>(reinterpret_cast<intptr_t>(value));
+    }
+
+    if(CollectiveHierarchy::Default == hierarchy) {
+      hierarchy = globalCollectiveHierarchy();
+    }
+
+    if(CollectiveHierarchy::Flat == hierarchy ||
+       (CollectiveHierarchy::Threshold == hierarchy && count * getExtent(type) < globalCollectiveHierarchyThreshold())) {
+      return false;
+    }
+
+    const CommInfo& info = getCommHierarchyInfo(comm);
+
+    return !info.isInter && 1 < info.nodeCount && info.nodeCount < info.size;
+  }
+
+  /**
+   * @brief Sum of the values of all ranks, which is received by all ranks.
+   *
+   * Same as MPI_Allreduce with MPI_SUM. The node hierarchy is used if selected, see isCollectiveHierarchyUsed.
+   */
+  inline int hierarchicalAllreduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype type, MPI_Comm comm) {
+    if(!isCollectiveHierarchyUsed(comm, count, type)) {
+      return MPI_Allreduce(sendbuf, recvbuf, count, type, MPI_SUM, comm);
+    }
+
+    const CommInfo& info = getCommHierarchyInfo(comm);
+
+    int rStatus = MPI_Reduce(sendbuf, recvbuf, count, type, MPI_SUM, 0, info.nodeComm);
+    if(MPI_COMM_NULL != info.leaderComm) {
+      MPI_Allreduce(MPI_IN_PLACE, recvbuf, count, type, MPI_SUM, info.leaderComm);
+    }
+    MPI_Bcast(recvbuf, count, type, 0, info.nodeComm);
+
+    return rStatus;
+  }
+
+  /**
+   * @brief Sum of the values of all ranks, which is received by the root.
+   *
+   * Same as MPI_Reduce with MPI_SUM. The node hierarchy is used if selected, see isCollectiveHierarchyUsed. The
+   * first rank on the node of the root sends the sum to the root, if the root is not the first rank.
+   */
+  inline int hierarchicalReduce(const void* sendbuf, void* recvbuf, int count, MPI_Datatype type, int root,
+                                MPI_Comm comm) {
+    if(!isCollectiveHierarchyUsed(comm, count, type)) {
+      return MPI_Reduce(sendbuf, recvbuf, count, type, MPI_SUM, root, comm);
+    }
+
+    const CommInfo& info = getCommHierarchyInfo(comm);
+    int node = info.rankNodes[2 * info.rank];
+    int rootNode = info.rankNodes[2 * root];
+    int rootNodeRank = info.rankNodes[2 * root + 1];
+
+    std::vector<char> nodeSum;
+    void* nodeBuf = recvbuf;
+    if(0 == info.nodeRank && info.rank != root) {
+      nodeSum.resize(count * getExtent(type));
+      nodeBuf = nodeSum.data();
+    }
+
+    int rStatus = MPI_Reduce(sendbuf, nodeBuf, count, type, MPI_SUM, 0, info.nodeComm);
+    if(MPI_COMM_NULL != info.leaderComm) {
+      if(rootNode == node) {
+        MPI_Reduce(MPI_IN_PLACE, nodeBuf, count, type, MPI_SUM, rootNode, info.leaderComm);
+      } else {
+        MPI_Reduce(nodeBuf, nullptr, count, type, MPI_SUM, rootNode, info.leaderComm);
+      }
+    }
+
+    if(0 != rootNodeRank && rootNode == node) {
+      if(0 == info.nodeRank) {
+        MPI_Send(nodeBuf, count, type, rootNodeRank, 0, info.nodeComm);
+      } else if(info.rank == root) {
+        MPI_Recv(recvbuf, count, type, 0, 0, info.nodeComm, MPI_STATUS_IGNORE);
+      }
+    }
+
+    return rStatus;
+  }
+
+  /**
+   * @brief Broadcast of the values of the root.
+   *
+   * Same as MPI_Bcast. The node hierarchy is used if selected, see isCollectiveHierarchyUsed. The root sends the
+   * values to the first rank on its node, if the root is not the first rank.
+   */
+  inline int hierarchicalBcast(void* buf, int count, MPI_Datatype type, int root, MPI_Comm comm) {
+    if(!isCollectiveHierarchyUsed(comm, count, type)) {
+      return MPI_Bcast(buf, count, type, root, comm);
+    }
+
+    const CommInfo& info = getCommHierarchyInfo(comm);
+    int node = info.rankNodes[2 * info.rank];
+    int rootNode = info.rankNodes[2 * root];
+    int rootNodeRank = info.rankNodes[2 * root + 1];
+
+    if(0 != rootNodeRank && rootNode == node) {
+      if(info.rank == root) {
+        MPI_Send(buf, count, type, 0, 0, info.nodeComm);
+      } else if(0 == info.nodeRank) {
+        MPI_Recv(buf, count, type, rootNodeRank, 0, info.nodeComm, MPI_STATUS_IGNORE);
+      }
+    }
+
+    int rStatus = MPI_SUCCESS;
+    if(MPI_COMM_NULL != info.leaderComm) {
+      rStatus = MPI_Bcast(buf, count, type, rootNode, info.leaderComm);
+    }
+    MPI_Bcast(buf, count, type, 0, info.nodeComm);
+
+    return rStatus;
+  }
+}
@@ -29,6 +29,9 @@
 #pragma once
 
 #include <cstdlib>
+#include <cstring>
+#include <typeinfo>
+#include <vector>
 
 #include "../macros.h"
 #include "typeInterface.hpp"
@@ -48,6 +51,37 @@ namespace medi {
   class MpiStructType final : public MpiTypeInterface {
 
     private:
+
+      /**
+       * @brief A contiguous run of values in one element of the type.
+       *
+       * For active runs, length is the number of values of the leaf type. For passive runs, type is nullptr and
+       * length is the number of bytes.
+       */
+      struct CopyRun {
+          MpiTypeInterface* type;
+          size_t bufOffset;
+          size_t modOffset;
+          int length;
+          int activeElements;
+      };
+
+      /**
+       * @brief The flattened layout of one element, see createCopyPlan.
+       */
+      struct CopyPlan {
+          std::vector<CopyRun> activeRuns;
+          std::vector<CopyRun> passiveRuns;
+          bool isDense;  ///< One active run that covers all elements of the buffers.
+          bool isCreated;
+
+          CopyPlan() :
+            activeRuns(),
+            passiveRuns(),
+            isDense(false),
+            isCreated(false) {}
+      };
+
       bool modificationRequired;
       int valuesPerElement;
 
@@ -63,6 +97,7 @@ namespace medi {
       int* modifiedBlockOffsets;
       MpiTypeInterface** types;
 
+      mutable CopyPlan plan;
 
     public:
       typedef void Type;
@@ -118,6 +153,9 @@ namespace medi {
 
         setMpiTypes(type, modType);
 
+        if(other->plan.isCreated) {
+          createCopyPlan();
+        }
       }
 
       MpiStructType(const MpiStructType* other, size_t offset, size_t extent) :
@@ -145,6 +183,10 @@ namespace medi {
         }
 
         setMpiTypes(type, modType);
+
+        if(other->plan.isCreated) {
+          createCopyPlan();
+        }
       }
 
 
@@ -331,86 +373,185 @@ namespace medi {
         return *adInterface;
       }
 
+      /**
+       * @brief Flatten the layout of one element into runs of active values and runs of passive bytes.
+       *
+       * Nested struct types are expanded and adjacent runs are merged. The buffer methods then iterate over the runs
+       * instead of calling the member types recursively. The plan is created by AMPI_Type_commit or by the first
+       * buffer operation on the type.
+       */
+      void createCopyPlan() const {
+        plan = CopyPlan();
+        addToCopyPlan(this, 0, 0);
+
+        plan.isDense = false;
+        if(1 == plan.activeRuns.size() && plan.passiveRuns.empty()) {
+          CopyRun& run = plan.activeRuns[0];
+          plan.isDense = 0 == run.bufOffset && 0 == run.modOffset &&
+                         run.length * getExtent(run.type->getMpiType()) == typeExtent &&
+                         run.length * getExtent(run.type->getModifiedMpiType()) == modifiedExtent;
+        }
+        plan.isCreated = true;
+      }
+
       void copyIntoModifiedBuffer(const void* buf, size_t bufOffset, void* bufMod, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->copyIntoModifiedBuffer(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, computeBufferPointer(bufMod, computeModOffset(bufModOffset)), 0, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
           int totalModOffset = computeModOffset(i + bufModOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->copyIntoModifiedBuffer(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, computeBufferPointer(bufMod, totalModOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->copyIntoModifiedBuffer(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, computeBufferPointer(bufMod, totalModOffset + run.modOffset), 0, run.length);
+          }
+          for(const CopyRun& run : p.passiveRuns) {
+            memcpy(computeBufferPointer(bufMod, totalModOffset + run.modOffset), computeBufferPointer(buf, totalBufOffset + run.bufOffset), run.length);
           }
         }
       }
 
       void copyFromModifiedBuffer(void* buf, size_t bufOffset, const void* bufMod, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->copyFromModifiedBuffer(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, computeBufferPointer(bufMod, computeModOffset(bufModOffset)), 0, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
           int totalModOffset = computeModOffset(i + bufModOffset);
 
-
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->copyFromModifiedBuffer(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, computeBufferPointer(bufMod, totalModOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->copyFromModifiedBuffer(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, computeBufferPointer(bufMod, totalModOffset + run.modOffset), 0, run.length);
+          }
+          for(const CopyRun& run : p.passiveRuns) {
+            memcpy(computeBufferPointer(buf, totalBufOffset + run.bufOffset), computeBufferPointer(bufMod, totalModOffset + run.modOffset), run.length);
           }
         }
       }
 
       void getIndices(const void* buf, size_t bufOffset, void* indices, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
         int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
 
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->getIndices(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, indices, totalIndexOffset, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->getIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, totalIndexOffset, blockLengths[curType]);
-            totalIndexOffset += types[curType]->computeActiveElements(blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->getIndices(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, indices, totalIndexOffset, run.length);
+            totalIndexOffset += run.activeElements;
           }
         }
       }
 
       void registerValue(void* buf, size_t bufOffset, void* indices, void* oldPrimals, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
         int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
 
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->registerValue(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, indices, oldPrimals, totalIndexOffset, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->registerValue(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, oldPrimals, totalIndexOffset, blockLengths[curType]);
-            totalIndexOffset +=  types[curType]->computeActiveElements(blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->registerValue(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, indices, oldPrimals, totalIndexOffset, run.length);
+            totalIndexOffset += run.activeElements;
           }
         }
       }
 
       void clearIndices(void* buf, size_t bufOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->clearIndices(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->clearIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->clearIndices(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, run.length);
           }
         }
       }
 
       void createIndices(void* buf, size_t bufOffset, void* indices, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
         int totalIndexOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
 
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->createIndices(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, indices, totalIndexOffset, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->createIndices(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, indices, totalIndexOffset, blockLengths[curType]);
-            totalIndexOffset +=  types[curType]->computeActiveElements(blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->createIndices(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, indices, totalIndexOffset, run.length);
+            totalIndexOffset += run.activeElements;
           }
         }
       }
 
       void getValues(const void* buf, size_t bufOffset, void* primals, size_t bufModOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
         int totalPrimalsOffset = computeActiveElements(bufModOffset);  // indices are lineralized and counted up in the loop
+
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->getValues(computeBufferPointer(buf, computeBufOffset(bufOffset)), 0, primals, totalPrimalsOffset, elements * run.length);
+          return;
+        }
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->getValues(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, primals, totalPrimalsOffset, blockLengths[curType]);
-            totalPrimalsOffset += types[curType]->computeActiveElements(blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->getValues(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, primals, totalPrimalsOffset, run.length);
+            totalPrimalsOffset += run.activeElements;
+          }
+        }
+      }
+
+      void setModifiedValues(void* bufMod, size_t bufModOffset, const void* primals, size_t primalOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+        int totalPrimalsOffset = computeActiveElements(primalOffset);  // primals are lineralized and counted up in the loop
+
+        if(p.isDense) {
+          const CopyRun& run = p.activeRuns[0];
+          run.type->setModifiedValues(computeBufferPointer(bufMod, computeModOffset(bufModOffset)), 0, primals, totalPrimalsOffset, elements * run.length);
+          return;
+        }
+
+        for(int i = 0; i < elements; ++i) {
+          int totalModOffset = computeModOffset(i + bufModOffset);
+
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->setModifiedValues(computeBufferPointer(bufMod, totalModOffset + run.modOffset), 0, primals, totalPrimalsOffset, run.length);
+            totalPrimalsOffset += run.activeElements;
           }
         }
       }
@@ -428,32 +569,41 @@ namespace medi {
       }
 
       void copy(void* from, size_t fromOffset, void* to, size_t toOffset, int count) const {
+        const CopyPlan& p = getCopyPlan();
+
         for(int i = 0; i < count; ++i) {
           int totalFromOffset = computeBufOffset(i + fromOffset);
           int totalToOffset = computeBufOffset(i + toOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->copy(computeBufferPointer(from, totalFromOffset + blockOffsets[curType]), 0, computeBufferPointer(to, totalToOffset + modifiedBlockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->copy(computeBufferPointer(from, totalFromOffset + run.bufOffset), 0, computeBufferPointer(to, totalToOffset + run.bufOffset), 0, run.length);
+          }
+          for(const CopyRun& run : p.passiveRuns) {
+            memcpy(computeBufferPointer(to, totalToOffset + run.bufOffset), computeBufferPointer(from, totalFromOffset + run.bufOffset), run.length);
           }
         }
       }
 
       void initializeType(void* buf, size_t bufOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->initializeType(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->initializeType(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, run.length);
           }
         }
       }
 
       void freeType(void* buf, size_t bufOffset, int elements) const {
+        const CopyPlan& p = getCopyPlan();
+
         for(int i = 0; i < elements; ++i) {
           int totalBufOffset = computeBufOffset(i + bufOffset);
 
-          for(int curType = 0; curType < nTypes; ++curType) {
-            types[curType]->freeType(computeBufferPointer(buf, totalBufOffset + blockOffsets[curType]), 0, blockLengths[curType]);
+          for(const CopyRun& run : p.activeRuns) {
+            run.type->freeType(computeBufferPointer(buf, totalBufOffset + run.bufOffset), 0, run.length);
           }
         }
       }
@@ -488,6 +638,87 @@ namespace medi {
       MpiStructType* clone() const {
         return new MpiStructType(this);
       }
+
+    private:
+
+      const CopyPlan& getCopyPlan() const {
+        if(!plan.isCreated) {
+          createCopyPlan();
+        }
+
+        return plan;
+      }
+
+      static size_t getExtent(MPI_Datatype type) {
+        MPI_Aint lb = 0;
+        MPI_Aint ext = 0;
+#if MEDI_MPI_TARGET < MEDI_MPI_VERSION_2_0
+        MPI_Type_lb(type, &lb);
+        MPI_Type_extent(type, &ext);
+#else
+        MPI_Type_get_extent(type, &lb, &ext);
+#endif
+
+        return (size_t)ext;
+      }
+
+      void addToCopyPlan(const MpiStructType* type, size_t bufBase, size_t modBase) const {
+        for(int curType = 0; curType < type->nTypes; ++curType) {
+          size_t bufOffset = bufBase + type->blockOffsets[curType];
+          size_t modOffset = modBase + type->modifiedBlockOffsets[curType];
+          int length = type->blockLengths[curType];
+
+          const MpiStructType* nested = dynamic_cast<const MpiStructType*>(type->types[curType]);
+          if(nullptr != nested) {
+            for(int i = 0; i < length; ++i) {
+              addToCopyPlan(nested, bufOffset + nested->computeBufOffset(i), modOffset + nested->computeModOffset(i));
+            }
+          } else if(0 != length) {
+            MpiTypeInterface* leaf = type->types[curType];
+            if(leaf->getADTool().isActiveType()) {
+              addRun(plan.activeRuns, leaf, bufOffset, modOffset, length, getExtent(leaf->getMpiType()), getExtent(leaf->getModifiedMpiType()));
+            } else {
+              size_t bytes = length * getExtent(leaf->getMpiType());
+              addRun(plan.passiveRuns, nullptr, bufOffset, modOffset, (int)bytes, 1, 1);
+            }
+          }
+        }
+      }
+
+      static bool isSameLeafType(const MpiTypeInterface* a, const MpiTypeInterface* b) {
+        if(a == b) {
+          return true;
+        } else if(nullptr == a || nullptr == b) {
+          return false;
+        } else {
+          // the member types are clones, so compare what defines their behaviour
+          return typeid(*a) == typeid(*b) &&
+                 a->getMpiType() == b->getMpiType() &&
+                 a->getModifiedMpiType() == b->getModifiedMpiType() &&
+                 &a->getADTool() == &b->getADTool();
+        }
+      }
+
+      static void addRun(std::vector<CopyRun>& runs, MpiTypeInterface* type, size_t bufOffset, size_t modOffset, int length, size_t bufExtent, size_t modExtent) {
+        if(!runs.empty()) {
+          CopyRun& last = runs.back();
+          if(isSameLeafType(last.type, type) &&
+             last.bufOffset + last.length * bufExtent == bufOffset &&
+             last.modOffset + last.length * modExtent == modOffset) {
+            last.length += length;
+            last.activeElements = nullptr == type ? 0 : type->computeActiveElements(last.length);
+            return;
+          }
+        }
+
+        CopyRun run;
+        run.type = type;
+        run.bufOffset = bufOffset;
+        run.modOffset = modOffset;
+        run.length = length;
+        run.activeElements = nullptr == type ? 0 : type->computeActiveElements(length);
+        runs.push_back(run);
+      }
   };
 
   inline int AMPI_Type_create_contiguous(int count, MpiTypeInterface* oldtype, MpiTypeInterface** newtype) {
@@ -793,6 +1024,11 @@ namespace medi {
   inline int AMPI_Type_commit(MpiTypeInterface** d) {
     MpiTypeInterface* datatype = *d;
 
+    MpiStructType* structType = dynamic_cast<MpiStructType*>(datatype);
+    if(nullptr != structType) {
+      structType->createCopyPlan();
+    }
+
     if(datatype->isModifiedBufferRequired()) {
       MPI_Datatype modType = datatype->getModifiedMpiType();
       MPI_Type_commit(&modType);
@@ -33,7 +33,9 @@
 #include "ampiMisc.h"
 #include "async.hpp"
 #include "message.hpp"
+#include "collectiveHierarchy.hpp"
 #include "../displacementTools.hpp"
+#include "../exceptions.hpp"
 
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
@@ -155,7 +157,7 @@ namespace medi {
     if(root == getCommRank(comm)) {
       std::swap(sendbufAdjoints, recvbufAdjoints);
     }
-    MPI_Bcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+    hierarchicalBcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
   }
 #endif
 
@@ -343,9 +345,15 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Reduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MEDI_UNUSED(sendbufSize);
-    //TODO: MPI_Reduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, root, comm);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    hierarchicalReduce(sendbufAdjoints, recvbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
   }
 #endif
 
@@ -353,9 +361,15 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Ireduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MEDI_UNUSED(sendbufSize);
-    //TODO: MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, root, comm, &request->request);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, root, comm, &request->request);
   }
 #endif
 
@@ -363,10 +377,15 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Allreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     MEDI_UNUSED(count);
+    MEDI_UNUSED(op);
     MEDI_UNUSED(sendbufSize);
 
-    //TODO MPI_Allreduce(sendbufAdjoints, datatype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), TODO, comm);
-    std::cout << "Forward reduce not supported." << std::endl;
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    hierarchicalAllreduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), comm);
   }
 #endif
 
@@ -375,9 +394,182 @@ namespace medi {
   void AMPI_Iallreduce_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
+    MEDI_UNUSED(sendbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    MPI_Iallreduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    LinearDisplacements linDis(getCommSize(comm), recvcounts, sendbufSize);
+    MPI_Reduce_scatter(sendbufAdjoints, recvbufAdjoints, linDis.counts, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    LinearDisplacements* linDis = new LinearDisplacements(getCommSize(comm), recvcounts, sendbufSize);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+
+    MPI_Ireduce_scatter(sendbufAdjoints, recvbufAdjoints, linDis->counts, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(sendbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    MPI_Reduce_scatter_block(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_fwd(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(sendbufSize);
+
+    if(!datatype->getADTool().isAdjointSumSupported()) {
+      MEDI_EXCEPTION("Forward reduce requires MPI_SUM on the adjoint type.");
+    }
+
+    // The operator specific parts are evaluated locally by the post and pre adjoint operations, so the tangents are summed.
+    MPI_Ireduce_scatter_block(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, recvbufSize * getCommInDegree(comm), recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, recvbufSize * getCommInDegree(comm), recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, computeDisplacementsTotalSize(recvbufCounts, getCommInDegree(comm)), recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, computeDisplacementsTotalSize(recvbufCounts, getCommInDegree(comm)), recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, recvbufSize * getCommInDegree(comm), recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, recvbufSize * getCommInDegree(comm), recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, computeDisplacementsTotalSize(recvbufCounts, getCommInDegree(comm)), recvtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_fwd(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
 
-    //TODO MPI_Iallreduce(sendbufAdjoints, datatype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
-    std::cout << "Forward reduce not supported." << std::endl;
+    // the blocks of MPI_PROC_NULL neighbors are not received
+    setZero(recvbufAdjoints, computeDisplacementsTotalSize(recvbufCounts, getCommInDegree(comm)), recvtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), comm, &request->request);
   }
 #endif
 }
@@ -41,6 +41,46 @@ namespace medi {
   static void noPreAdjointOperation(void* adjoints, void* primals, int count, int dim) { MEDI_UNUSED(adjoints); MEDI_UNUSED(primals); MEDI_UNUSED(count); MEDI_UNUSED(dim); }
   static void noPostAdjointOperation(void* adjoints, void* primals, void* rootPrimals, int count, int dim) { MEDI_UNUSED(adjoints); MEDI_UNUSED(primals); MEDI_UNUSED(rootPrimals); MEDI_UNUSED(count); MEDI_UNUSED(dim); }
 
+  /**
+   * @brief The algorithms for reductions with operators that have no specialized adjoint handling.
+   *
+   * For these operators the AD tool records the local evaluation of the operator. The values are either gathered
+   * and reduced on each receiving rank or they are combined in a binomial tree (Reduce) or with recursive
+   * doubling (Allreduce). The tree requires log(P) steps and only two buffers of the size count on each rank.
+   */
+  enum class LocalReduceAlgorithm {
+    Default,  ///< Use the global algorithm, see setLocalReduceAlgorithm.
+    Gather,   ///< Gather all values and reduce them locally.
+    Tree      ///< Combine the values with point to point messages in log(P) steps.
+  };
+
+  /**
+   * @brief Access to the global algorithm for the reductions of operators without a specialized adjoint handling.
+   *
+   * @return Reference to the global algorithm.
+   */
+  inline LocalReduceAlgorithm& globalLocalReduceAlgorithm() {
+    static LocalReduceAlgorithm algorithm = LocalReduceAlgorithm::Gather;
+
+    return algorithm;
+  }
+
+  /**
+   * @brief Set the global algorithm for the reductions of operators without a specialized adjoint handling.
+   *
+   * The default is LocalReduceAlgorithm::Gather. The tree can be selected here for all operators or for one operator
+   * with AMPI_Op::localReduceAlgorithm. It changes the order in which the values are combined.
+   *
+   * @param[in] algorithm  The new algorithm. LocalReduceAlgorithm::Default selects the gather algorithm.
+   */
+  inline void setLocalReduceAlgorithm(LocalReduceAlgorithm algorithm) {
+    if(LocalReduceAlgorithm::Default == algorithm) {
+      algorithm = LocalReduceAlgorithm::Gather;
+    }
+
+    globalLocalReduceAlgorithm() = algorithm;
+  }
+
   /**
    * @brief Structure for the special handling of the MPI_Op structure.
    *
@@ -91,6 +131,13 @@ namespace medi {
        */
       bool hasAdjoint;
 
+      /**
+       * @brief The algorithm for the local reduction if the operator has no specialized adjoint handling.
+       *
+       * LocalReduceAlgorithm::Default uses the global algorithm, see setLocalReduceAlgorithm.
+       */
+      LocalReduceAlgorithm localReduceAlgorithm;
+
       /**
        * @brief Default constructor for static initialization.
        *
@@ -103,7 +150,8 @@ namespace medi {
         modifiedPrimalFunction(MPI_OP_NULL),
         preAdjointOperation(noPreAdjointOperation),
         postAdjointOperation(noPostAdjointOperation),
-        hasAdjoint(false) {}
+        hasAdjoint(false),
+        localReduceAlgorithm(LocalReduceAlgorithm::Default) {}
 
       /**
        * @brief Creates an operator with a specialized adjoint handling.
@@ -201,5 +249,20 @@ namespace medi {
     return !(a == b);
   }
 
+  /**
+   * @brief The algorithm for the local reduction of the operator.
+   *
+   * @param[in] op  The operator as given by the user.
+   *
+   * @return The algorithm of the operator or the global algorithm if the operator uses the default.
+   */
+  inline LocalReduceAlgorithm getLocalReduceAlgorithm(AMPI_Op const& op) {
+    if(LocalReduceAlgorithm::Default != op.localReduceAlgorithm) {
+      return op.localReduceAlgorithm;
+    } else {
+      return globalLocalReduceAlgorithm();
+    }
+  }
+
   extern const AMPI_Op AMPI_OP_NULL;
 }
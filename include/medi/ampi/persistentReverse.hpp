@@ -0,0 +1,182 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#pragma once
+
+#include "../macros.h"
+#include "async.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Counters for the persistent requests of the reverse point to point communication.
+   */
+  struct PersistentReverseStatistics {
+      long created;  ///< Number of persistent requests that were created.
+      long started;  ///< Number of starts of persistent requests.
+
+      PersistentReverseStatistics() :
+        created(0),
+        started(0) {}
+  };
+
+  /**
+   * @brief Settings for the persistent requests of the reverse point to point communication.
+   *
+   * If enabled, the adjoint communication of the nonblocking point to point functions creates a persistent MPI request
+   * on the first reverse evaluation of a handle. Further evaluations of the same handle, e.g. for multiple right hand
+   * sides or a fixed point iteration, only call MPI_Start. The request is bound to the adjoint buffer of the handle
+   * and is recreated if the AD tool provides a different buffer, the buffer arenas of the AD tools usually return the
+   * same block for each evaluation. The request is released when the handle is deleted.
+   *
+   * Messages which are sent as bytes or in aggregated transfers, see AdjointTransport, do not use persistent requests.
+   *
+   * The setting can be changed between evaluations of the tape.
+   */
+  struct PersistentReverseSettings {
+      bool enabled;  ///< If persistent requests are used.
+      PersistentReverseStatistics statistics;
+
+      PersistentReverseSettings() :
+        enabled(false),
+        statistics() {}
+  };
+
+  /**
+   * @brief Access to the global settings for the persistent reverse requests.
+   *
+   * @return Reference to the global settings.
+   */
+  inline PersistentReverseSettings& globalPersistentReverseSettings() {
+    static PersistentReverseSettings settings;
+
+    return settings;
+  }
+
+  /**
+   * @brief Enable or disable the persistent requests of the reverse point to point communication.
+   *
+   * @param[in] enabled  If persistent requests should be used.
+   */
+  inline void setPersistentReverseRequests(bool enabled) {
+    globalPersistentReverseSettings().enabled = enabled;
+  }
+
+  /**
+   * @return The counters of the persistent reverse requests on this process.
+   */
+  inline const PersistentReverseStatistics& getPersistentReverseStatistics() {
+    return globalPersistentReverseSettings().statistics;
+  }
+
+  /**
+   * @brief Set all counters of the persistent reverse requests to zero.
+   */
+  inline void resetPersistentReverseStatistics() {
+    globalPersistentReverseSettings().statistics = PersistentReverseStatistics();
+  }
+
+  /**
+   * @brief A persistent request of the reverse communication.
+   *
+   * It is stored as the persistent data of the reverse request of a handle.
+   */
+  struct PersistentReverseRequest {
+      MPI_Request request;
+
+      void* adjoints;
+      bool isSend;
+      int elements;
+      MPI_Datatype type;
+      int peer;
+      int tag;
+      MPI_Comm comm;
+
+      PersistentReverseRequest(void* adjoints, bool isSend, int elements, MPI_Datatype type, int peer, int tag,
+                               MPI_Comm comm) :
+        request(MPI_REQUEST_NULL),
+        adjoints(adjoints),
+        isSend(isSend),
+        elements(elements),
+        type(type),
+        peer(peer),
+        tag(tag),
+        comm(comm) {
+        if(isSend) {
+          MPI_Send_init(adjoints, elements, type, peer, tag, comm, &request);
+        } else {
+          MPI_Recv_init(adjoints, elements, type, peer, tag, comm, &request);
+        }
+        globalPersistentReverseSettings().statistics.created += 1;
+      }
+
+      ~PersistentReverseRequest() {
+        // the tape can be deleted after MPI_Finalize
+        int finalized;
+        MPI_Finalized(&finalized);
+        if(!finalized && MPI_REQUEST_NULL != request) {
+          MPI_Request_free(&request);
+        }
+      }
+
+      /**
+       * @return True if the request was created for the same message and buffer.
+       */
+      bool matches(void* adjoints, bool isSend, int elements, MPI_Datatype type, int peer, int tag,
+                   MPI_Comm comm) const {
+        return this->adjoints == adjoints && this->isSend == isSend && this->elements == elements
+            && this->type == type && this->peer == peer && this->tag == tag && this->comm == comm;
+      }
+
+      /**
+       * @brief Start the communication of the adjoints with the persistent request of the reverse request.
+       *
+       * The persistent request is created or recreated if the message or the buffer differs from the last one. The
+       * reverse request refers to the persistent request so that waitReverse can wait for it.
+       */
+      static void start(void* adjoints, int elements, MPI_Datatype type, int peer, int tag, MPI_Comm comm,
+                        bool isSend, AMPI_Request* request) {
+        PersistentReverseRequest* data = reinterpret_cast<PersistentReverseRequest*>(request->persistentData);
+        if(nullptr == data || !data->matches(adjoints, isSend, elements, type, peer, tag, comm)) {
+          request->deletePersistentData();
+          data = new PersistentReverseRequest(adjoints, isSend, elements, type, peer, tag, comm);
+          request->setPersistentData(data, deleteFunc);
+        }
+
+        MPI_Start(&data->request);
+        request->request = data->request;
+        globalPersistentReverseSettings().statistics.started += 1;
+      }
+
+      static void deleteFunc(void* data) {
+        delete reinterpret_cast<PersistentReverseRequest*>(data);
+      }
+  };
+}
@@ -34,6 +34,7 @@
 #include "async.hpp"
 #include "message.hpp"
 #include "../displacementTools.hpp"
+#include "../exceptions.hpp"
 
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
@@ -339,13 +340,43 @@ namespace medi {
   }
 #endif
 
+  /**
+   * @brief The mpi operator for the reduction of the primal values.
+   *
+   * Only the predefined operators can be evaluated on the primal mpi type. User defined operators work on the AD type.
+   * The AD tool may replace the predefined operators with its own ones, these are mapped back.
+   *
+   * @param[in]     op  The operator of the reduction.
+   * @param[in] adTool  The AD tool of the reduced datatype.
+   *
+   * @return The predefined mpi operator or MPI_OP_NULL.
+   */
+  inline MPI_Op getPrimalReduceOperator(AMPI_Op const& op, ADToolInterface const& adTool) {
+    if(MPI_SUM == op.primalFunction || adTool.convertOperator(AMPI_SUM) == op) {
+      return MPI_SUM;
+    } else if(MPI_PROD == op.primalFunction || adTool.convertOperator(AMPI_PROD) == op) {
+      return MPI_PROD;
+    } else if(MPI_MIN == op.primalFunction || adTool.convertOperator(AMPI_MIN) == op) {
+      return MPI_MIN;
+    } else if(MPI_MAX == op.primalFunction || adTool.convertOperator(AMPI_MAX) == op) {
+      return MPI_MAX;
+    } else {
+      return MPI_OP_NULL;
+    }
+  }
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
   void AMPI_Reduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MEDI_UNUSED(sendbufSize);
-    //TODO: MPI_Reduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), TODO, root, comm);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MEDI_UNUSED(recvbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Reduce(sendbufAdjoints, recvbufAdjoints, sendbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, root, comm);
   }
 #endif
 
@@ -353,9 +384,14 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Ireduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MEDI_UNUSED(sendbufSize);
-    //TODO: MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), TODO, root, comm, &request->request);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MEDI_UNUSED(recvbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Ireduce(sendbufAdjoints, recvbufAdjoints, sendbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, root, comm, &request->request);
   }
 #endif
 
@@ -365,19 +401,175 @@ namespace medi {
     MEDI_UNUSED(count);
     MEDI_UNUSED(sendbufSize);
 
-    //TODO MPI_Allreduce(sendbufAdjoints, datatype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), TODO, comm);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Allreduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, comm);
   }
 #endif
 
 #if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
   void AMPI_Iallreduce_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
-    MEDI_UNUSED(op);
     MEDI_UNUSED(count);
+    MEDI_UNUSED(sendbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Iallreduce(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(recvbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    LinearDisplacements linDis(getCommSize(comm), recvcounts, sendbufSize);
+    MPI_Reduce_scatter(sendbufAdjoints, recvbufAdjoints, linDis.counts, datatype->getADTool().getPrimalMpiType(), primalOp, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(recvbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    LinearDisplacements* linDis = new LinearDisplacements(getCommSize(comm), recvcounts, sendbufSize);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+
+    MPI_Ireduce_scatter(sendbufAdjoints, recvbufAdjoints, linDis->counts, datatype->getADTool().getPrimalMpiType(), primalOp, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(sendbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Reduce_scatter_block(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_pri(typename DATATYPE::PrimalType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(recvcount);
+    MEDI_UNUSED(sendbufSize);
+
+    MPI_Op primalOp = getPrimalReduceOperator(op, datatype->getADTool());
+    if(MPI_OP_NULL == primalOp) {
+      MEDI_EXCEPTION("Primal reduce is only supported for predefined operators.");
+    }
+
+    MPI_Ireduce_scatter_block(sendbufAdjoints, recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), primalOp, comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    MPI_Neighbor_allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    MPI_Ineighbor_allgather(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    MPI_Neighbor_allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    MPI_Ineighbor_allgatherv(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    MPI_Neighbor_alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    MPI_Ineighbor_alltoall(sendbufAdjoints, sendbufSize, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    MPI_Neighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_pri(typename SENDTYPE::PrimalType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::PrimalType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
 
-    //TODO MPI_Iallreduce(sendbufAdjoints, datatype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufSize, datatype->getADTool().getPrimalMpiType(), comm, &request->request);
-    std::cout << "Forward reduce not supported." << std::endl;
+    MPI_Ineighbor_alltoallv(sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getPrimalMpiType(), recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getPrimalMpiType(), comm, &request->request);
   }
 #endif
 }
@@ -0,0 +1,422 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstring>
+#include <list>
+#include <map>
+#include <utility>
+#include <vector>
+
+#include "../adToolInterface.h"
+#include "../exceptions.hpp"
+#include "../macros.h"
+#include "../typeDefinitions.h"
+#include "async.hpp"
+#include "reverseComm.hpp"
+
+#ifndef MEDI_ReverseAggregationTag
+  /**
+   * @brief The tag for the aggregated adjoint messages of the reverse point to point communication.
+   *
+   * The transfers are sent on the duplicate from createInternalComm, so the tag can not clash with the adjoint messages
+   * of the replay, which use the tags of the user.
+   *
+   * It can be set with the preprocessor macro MEDI_ReverseAggregationTag=<tag>
+   */
+  #define MEDI_ReverseAggregationTag 32766
+#endif
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Counters for the aggregated adjoint messages.
+   *
+   * The counters are only updated on the sending side of the adjoint messages.
+   */
+  struct ReverseAggregationStatistics {
+      long messages;   ///< Number of adjoint messages that were sent in an aggregated transfer.
+      long transfers;  ///< Number of aggregated transfers, that is MPI messages.
+      long bytes;      ///< Number of bytes in the aggregated transfers including the headers.
+
+      ReverseAggregationStatistics() :
+        messages(0),
+        transfers(0),
+        bytes(0) {}
+  };
+
+  /**
+   * @brief Settings for the aggregation of the adjoint messages in the reverse point to point communication.
+   *
+   * If enabled, the adjoint messages of the nonblocking point to point communication are not sent when the reverse
+   * communication is started. They are collected per destination and sent in one transfer after all requests of one
+   * AMPI_Wait, AMPI_Waitall, etc. are started. The receiver extracts the messages from the transfers and matches them
+   * with the started receives by the source and the tag, in the same order as MPI would match them.
+   *
+   * Blocking messages use the same transfers, so that their order with respect to the nonblocking messages is kept.
+   * Messages which are larger than maxMessageBytes are sent directly.
+   *
+   * The settings change the format of the messages, they need to be the same on all processes and during the recording
+   * and the evaluation of the tape.
+   */
+  struct ReverseAggregationSettings {
+      bool enabled;         ///< If the aggregation is enabled.
+      int maxMessageBytes;  ///< Maximum size of an adjoint message that is aggregated.
+      ReverseAggregationStatistics statistics;
+
+      ReverseAggregationSettings() :
+        enabled(false),
+        maxMessageBytes(4096),
+        statistics() {}
+  };
+
+  /**
+   * @brief Access to the global settings for the aggregation of adjoint messages.
+   *
+   * @return Reference to the global settings.
+   */
+  inline ReverseAggregationSettings& globalReverseAggregationSettings() {
+    static ReverseAggregationSettings settings;
+
+    return settings;
+  }
+
+  /**
+   * @brief Enable or disable the aggregation of the adjoint messages in the reverse point to point communication.
+   *
+   * Needs to be called with the same arguments on all processes, before the recording of the tape.
+   *
+   * @param[in]         enabled  If the adjoint messages should be aggregated.
+   * @param[in] maxMessageBytes  Maximum size of an adjoint message in bytes that is aggregated.
+   */
+  inline void setReverseAggregation(bool enabled, int maxMessageBytes = 4096) {
+    globalReverseAggregationSettings().enabled = enabled;
+    globalReverseAggregationSettings().maxMessageBytes = maxMessageBytes;
+  }
+
+  /**
+   * @return The counters of the aggregation on this process.
+   */
+  inline const ReverseAggregationStatistics& getReverseAggregationStatistics() {
+    return globalReverseAggregationSettings().statistics;
+  }
+
+  /**
+   * @brief Set all counters of the aggregation to zero.
+   */
+  inline void resetReverseAggregationStatistics() {
+    globalReverseAggregationSettings().statistics = ReverseAggregationStatistics();
+  }
+
+  /**
+   * @brief A started receive of an adjoint message that is part of an aggregated transfer.
+   */
+  struct AggregatedRecv {
+      MPI_Comm comm;
+      int source;
+      int tag;
+      char* buffer;   ///< Buffer for the message.
+      int capacity;   ///< Size of the buffer in bytes.
+      int bytes;      ///< Size of the received message in bytes.
+      bool done;      ///< True if the message was received.
+
+      AggregatedRecv() :
+        comm(MPI_COMM_NULL),
+        source(MPI_PROC_NULL),
+        tag(0),
+        buffer(nullptr),
+        capacity(0),
+        bytes(0),
+        done(false) {}
+
+      AggregatedRecv(MPI_Comm comm, int source, int tag, char* buffer, int capacity) :
+        comm(comm),
+        source(source),
+        tag(tag),
+        buffer(buffer),
+        capacity(capacity),
+        bytes(0),
+        done(false) {}
+  };
+
+  /**
+   * @brief Collects the adjoint messages per destination and distributes the received transfers to the receives.
+   *
+   * A transfer is a sequence of messages in the format [int tag][int bytes][message].
+   */
+  class ReverseAggregation {
+    private:
+
+      struct Transfer {
+          std::vector<char> data;
+          MPI_Request request;
+      };
+
+      struct UnexpectedMessage {
+          MPI_Comm comm;
+          int source;
+          int tag;
+          std::vector<char> data;
+      };
+
+      typedef std::pair<MPI_Comm, int> Destination;
+
+      std::map<Destination, std::vector<char>> pendingSends;
+      std::list<Transfer> transfers;
+      std::list<AggregatedRecv*> postedRecvs;
+      std::list<UnexpectedMessage> unexpectedMessages;
+
+    public:
+
+      /**
+       * @brief Access to the global aggregation.
+       */
+      static ReverseAggregation& global() {
+        static ReverseAggregation aggregation;
+
+        return aggregation;
+      }
+
+      /**
+       * @return True if a message to or from the given process with the given size is aggregated.
+       */
+      static bool isAggregated(int peer, int bytes) {
+        ReverseAggregationSettings& settings = globalReverseAggregationSettings();
+
+        return settings.enabled && MPI_PROC_NULL != peer && bytes <= settings.maxMessageBytes;
+      }
+
+      /**
+       * @brief Add a message to the pending transfer for the destination. The data is copied.
+       */
+      void addSend(MPI_Comm comm, int dest, int tag, const void* data, int bytes) {
+        std::vector<char>& pending = pendingSends[Destination(comm, dest)];
+
+        size_t pos = pending.size();
+        pending.resize(pos + 2 * sizeof(int) + bytes);
+        std::memcpy(&pending[pos], &tag, sizeof(int));
+        std::memcpy(&pending[pos + sizeof(int)], &bytes, sizeof(int));
+        std::memcpy(&pending[pos + 2 * sizeof(int)], data, bytes);
+
+        globalReverseAggregationSettings().statistics.messages += 1;
+      }
+
+      /**
+       * @brief Send all pending transfers.
+       *
+       * The transfers are completed in the following calls, the sender never waits for the receiver.
+       */
+      void flush() {
+        ReverseAggregationStatistics& statistics = globalReverseAggregationSettings().statistics;
+
+        for(std::map<Destination, std::vector<char>>::iterator iter = pendingSends.begin();
+            iter != pendingSends.end(); ++iter) {
+          transfers.push_back(Transfer());
+          Transfer& transfer = transfers.back();
+          transfer.data.swap(iter->second);
+
+          MPI_Isend(transfer.data.data(), (int)transfer.data.size(), MPI_BYTE, iter->first.second,
+                    MEDI_ReverseAggregationTag, getInternalComm(iter->first.first), &transfer.request);
+
+          statistics.transfers += 1;
+          statistics.bytes += transfer.data.size();
+        }
+        pendingSends.clear();
+
+        completeTransfers();
+      }
+
+      /**
+       * @brief Start the receive of a message.
+       *
+       * If the message was already received with a transfer, it is copied into the buffer immediately.
+       */
+      void postRecv(AggregatedRecv* recv) {
+        for(std::list<UnexpectedMessage>::iterator iter = unexpectedMessages.begin();
+            iter != unexpectedMessages.end(); ++iter) {
+          if(iter->comm == recv->comm && iter->source == recv->source && iter->tag == recv->tag) {
+            deliver(recv, iter->data.data(), (int)iter->data.size());
+            unexpectedMessages.erase(iter);
+
+            return;
+          }
+        }
+
+        postedRecvs.push_back(recv);
+      }
+
+      /**
+       * @brief Receive transfers from the source of the message until the message has arrived.
+       *
+       * All pending transfers are sent first, so that the other processes can continue.
+       */
+      void waitRecv(AggregatedRecv* recv) {
+        flush();
+
+        MPI_Comm transferComm = getInternalComm(recv->comm);
+        while(!recv->done) {
+          MPI_Status status;
+          MPI_Probe(recv->source, MEDI_ReverseAggregationTag, transferComm, &status);
+
+          int bytes;
+          MPI_Get_count(&status, MPI_BYTE, &bytes);
+          std::vector<char> data(bytes);
+          MPI_Recv(data.data(), bytes, MPI_BYTE, recv->source, MEDI_ReverseAggregationTag, transferComm,
+                   MPI_STATUS_IGNORE);
+
+          dispatch(recv->comm, recv->source, data);
+        }
+      }
+
+      /**
+       * @brief Send all pending transfers and wait for their completion.
+       *
+       * Called in AMPI_Finalize.
+       */
+      void finalize() {
+        flush();
+
+        for(std::list<Transfer>::iterator iter = transfers.begin(); iter != transfers.end(); ++iter) {
+          MPI_Wait(&iter->request, MPI_STATUS_IGNORE);
+        }
+        transfers.clear();
+
+        postedRecvs.clear();
+        unexpectedMessages.clear();
+      }
+
+    private:
+
+      void completeTransfers() {
+        std::list<Transfer>::iterator iter = transfers.begin();
+        while(iter != transfers.end()) {
+          int flag;
+          MPI_Test(&iter->request, &flag, MPI_STATUS_IGNORE);
+
+          if(flag) {
+            iter = transfers.erase(iter);
+          } else {
+            ++iter;
+          }
+        }
+      }
+
+      void dispatch(MPI_Comm comm, int source, const std::vector<char>& data) {
+        size_t pos = 0;
+        while(pos < data.size()) {
+          int tag;
+          int bytes;
+          std::memcpy(&tag, &data[pos], sizeof(int));
+          std::memcpy(&bytes, &data[pos + sizeof(int)], sizeof(int));
+          const char* message = &data[pos + 2 * sizeof(int)];
+          pos += 2 * sizeof(int) + bytes;
+
+          bool found = false;
+          for(std::list<AggregatedRecv*>::iterator iter = postedRecvs.begin(); iter != postedRecvs.end();
+              ++iter) {
+            AggregatedRecv* recv = *iter;
+            if(recv->comm == comm && recv->source == source && recv->tag == tag) {
+              deliver(recv, message, bytes);
+              postedRecvs.erase(iter);
+              found = true;
+
+              break;
+            }
+          }
+
+          if(!found) {
+            unexpectedMessages.push_back(UnexpectedMessage());
+            UnexpectedMessage& unexpected = unexpectedMessages.back();
+            unexpected.comm = comm;
+            unexpected.source = source;
+            unexpected.tag = tag;
+            unexpected.data.assign(message, message + bytes);
+          }
+        }
+      }
+
+      static void deliver(AggregatedRecv* recv, const char* message, int bytes) {
+        if(bytes > recv->capacity) {
+          MEDI_EXCEPTION("Aggregated adjoint message with %d bytes does not fit into the receive buffer with %d bytes.",
+                         bytes, recv->capacity);
+        }
+
+        std::memcpy(recv->buffer, message, bytes);
+        recv->bytes = bytes;
+        recv->done = true;
+      }
+  };
+
+  /**
+   * @brief Tape entry that sends the aggregated adjoint messages in the reverse evaluation.
+   *
+   * It is recorded before the reverse handles of the requests in AMPI_Wait, AMPI_Waitall, etc., so that it is
+   * evaluated after all reverse messages of these requests are started.
+   */
+  struct ReverseAggregationFlushHandle : public HandleBase {
+
+      ReverseAggregationFlushHandle() :
+        HandleBase() {
+        this->funcReverse = (ReverseFunction)ReverseAggregationFlushHandle::flush;
+        this->funcForward = (ForwardFunction)ReverseAggregationFlushHandle::skip;
+        this->funcPrimal = (PrimalFunction)ReverseAggregationFlushHandle::skip;
+      }
+
+    private:
+
+      static void flush(HandleBase* handle, AdjointInterface* adjointInterface) {
+        MEDI_UNUSED(handle);
+        MEDI_UNUSED(adjointInterface);
+
+        ReverseAggregation::global().flush();
+      }
+
+      static void skip(HandleBase* handle, AdjointInterface* adjointInterface) {
+        MEDI_UNUSED(handle);
+        MEDI_UNUSED(adjointInterface);
+      }
+  };
+
+  /**
+   * @brief Record the flush of the aggregated adjoint messages for the first request that is finished in AMPI_Wait,
+   * AMPI_Waitall, etc.
+   *
+   * @param[in] adTool  The AD tool of the request.
+   * @param[in]      h  The handle of the request, nullptr if the tape is not active.
+   */
+  inline void recordReverseAggregationFlush(const ADToolInterface& adTool, HandleBase* h) {
+    if(nullptr != h && isWaitBoundaryOpen() && globalReverseAggregationSettings().enabled) {
+      adTool.addToolAction(new (adTool.getHandleSlab()) ReverseAggregationFlushHandle());
+      isWaitBoundaryOpen() = false;
+    }
+  }
+}
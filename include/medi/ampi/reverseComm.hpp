@@ -0,0 +1,311 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <vector>
+
+#include "../macros.h"
+
+#ifndef MEDI_ReverseComm
+  /**
+   * @brief If the replay of the tape communicates on a duplicate of the user communicator.
+   *
+   * It can be set with the preprocessor macro MEDI_ReverseComm=<0/1>
+   */
+  #define MEDI_ReverseComm 1
+#endif
+
+#ifndef MEDI_ReverseCommNoWildcards
+  /**
+   * @brief Assert that the communication of active types uses neither MPI_ANY_SOURCE nor MPI_ANY_TAG.
+   *
+   * If enabled, the duplicated communicators are created with the MPI 4 info hints mpi_assert_no_any_source and
+   * mpi_assert_no_any_tag. The forward and primal replay repeat the wildcards of the recording, so the hints are
+   * only valid if the program uses no wildcards for active types.
+   *
+   * It can be set with the preprocessor macro MEDI_ReverseCommNoWildcards=<0/1>
+   */
+  #define MEDI_ReverseCommNoWildcards 0
+#endif
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Duplicated communicators for the messages that MeDiPack sends itself.
+   *
+   * Some operations are implemented with point to point messages, e.g. the tree reductions. These messages are sent
+   * on a duplicate of the communicator with a fixed tag, so that they can not be matched with the messages of the user
+   * or of the replay, which may use any tag. The duplicate is stored in an attribute of the communicator and freed
+   * together with it or in AMPI_Finalize.
+   */
+  struct InternalComm {
+
+      /**
+       * @return The key for the attribute with the duplicate, MPI_KEYVAL_INVALID if not yet created.
+       */
+      static int& getKeyval() {
+        static int keyval = MPI_KEYVAL_INVALID;
+
+        return keyval;
+      }
+
+      /**
+       * @return The communicators that have a duplicate.
+       */
+      static std::vector<MPI_Comm>& getComms() {
+        static std::vector<MPI_Comm> comms;
+
+        return comms;
+      }
+
+      /**
+       * @brief Frees the duplicate if the communicator is freed or the attribute is deleted.
+       */
+      static int deleteAttribute(MPI_Comm comm, int keyval, void* value, void* extraState) {
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        MPI_Comm* internalComm = reinterpret_cast<MPI_Comm*>(value);
+        MPI_Comm_free(internalComm);
+        delete internalComm;
+
+        std::vector<MPI_Comm>& comms = getComms();
+        comms.erase(std::remove(comms.begin(), comms.end(), comm), comms.end());
+
+        return MPI_SUCCESS;
+      }
+  };
+
+  /**
+   * @brief Create the duplicate of a communicator for the messages of MeDiPack.
+   *
+   * Needs to be called by all processes of the communicator. Does nothing if the communicator has already a
+   * duplicate or is MPI_COMM_NULL.
+   *
+   * @param[in] comm  The communicator.
+   */
+  inline void createInternalComm(MPI_Comm comm) {
+    if(MPI_COMM_NULL == comm) {
+      return;
+    }
+
+    int& keyval = InternalComm::getKeyval();
+    if(MPI_KEYVAL_INVALID == keyval) {
+      MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, InternalComm::deleteAttribute, &keyval, nullptr);
+    }
+
+    void* value;
+    int flag = 0;
+    MPI_Comm_get_attr(comm, keyval, &value, &flag);
+    if(flag) {
+      return;
+    }
+
+    MPI_Comm* internalComm = new MPI_Comm;
+    MPI_Comm_dup(comm, internalComm);
+
+    MPI_Comm_set_attr(comm, keyval, internalComm);
+    InternalComm::getComms().push_back(comm);
+  }
+
+  /**
+   * @brief The communicator for the messages of MeDiPack.
+   *
+   * @param[in] comm  The communicator.
+   *
+   * @return The duplicate from createInternalComm or the communicator itself if it has no duplicate.
+   */
+  inline MPI_Comm getInternalComm(MPI_Comm comm) {
+    int keyval = InternalComm::getKeyval();
+    if(MPI_KEYVAL_INVALID != keyval && MPI_COMM_NULL != comm) {
+      void* value;
+      int flag = 0;
+      MPI_Comm_get_attr(comm, keyval, &value, &flag);
+      if(flag) {
+        return *reinterpret_cast<MPI_Comm*>(value);
+      }
+    }
+
+    return comm;
+  }
+
+  /**
+   * @brief Duplicated communicators for the communication in the replay of the tape.
+   *
+   * The adjoint, forward and primal replay functions communicate on a duplicate of the user communicator, so that
+   * their messages can not be matched with user messages that are still in flight. The duplicate is stored in an
+   * attribute of the user communicator.
+   *
+   * Since MPI_Comm_dup is collective, the duplicate is created when the communicator is created with the AMPI
+   * functions, e.g. AMPI_Comm_split, and for MPI_COMM_WORLD in AMPI_Init. It is freed together with the user
+   * communicator or in AMPI_Finalize. Communicators which are created directly with MPI have no duplicate and are
+   * used in the replay as they are.
+   */
+  struct ReverseComm {
+
+      /**
+       * @return The key for the attribute with the duplicate, MPI_KEYVAL_INVALID if not yet created.
+       */
+      static int& getKeyval() {
+        static int keyval = MPI_KEYVAL_INVALID;
+
+        return keyval;
+      }
+
+      /**
+       * @return The user communicators that have a duplicate.
+       */
+      static std::vector<MPI_Comm>& getComms() {
+        static std::vector<MPI_Comm> comms;
+
+        return comms;
+      }
+
+      /**
+       * @brief Frees the duplicate if the user communicator is freed or the attribute is deleted.
+       */
+      static int deleteAttribute(MPI_Comm comm, int keyval, void* value, void* extraState) {
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        MPI_Comm* reverseComm = reinterpret_cast<MPI_Comm*>(value);
+        MPI_Comm_free(reverseComm);
+        delete reverseComm;
+
+        std::vector<MPI_Comm>& comms = getComms();
+        comms.erase(std::remove(comms.begin(), comms.end(), comm), comms.end());
+
+        return MPI_SUCCESS;
+      }
+  };
+
+  /**
+   * @brief Create the duplicate of a communicator for the replay of the tape.
+   *
+   * Needs to be called by all processes of the communicator. Does nothing if the communicator has already a
+   * duplicate or is MPI_COMM_NULL.
+   *
+   * @param[in] comm  The user communicator.
+   */
+  inline void createReverseComm(MPI_Comm comm) {
+#if MEDI_ReverseComm
+    if(MPI_COMM_NULL == comm) {
+      return;
+    }
+
+    int& keyval = ReverseComm::getKeyval();
+    if(MPI_KEYVAL_INVALID == keyval) {
+      MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, ReverseComm::deleteAttribute, &keyval, nullptr);
+    }
+
+    void* value;
+    int flag = 0;
+    MPI_Comm_get_attr(comm, keyval, &value, &flag);
+    if(flag) {
+      return;
+    }
+
+    MPI_Comm* reverseComm = new MPI_Comm;
+#if MEDI_ReverseCommNoWildcards && MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    MPI_Info info;
+    MPI_Info_create(&info);
+    MPI_Info_set(info, "mpi_assert_no_any_source", "true");
+    MPI_Info_set(info, "mpi_assert_no_any_tag", "true");
+    MPI_Comm_dup_with_info(comm, info, reverseComm);
+    MPI_Info_free(&info);
+#else
+    MPI_Comm_dup(comm, reverseComm);
+#endif
+
+    MPI_Comm_set_attr(comm, keyval, reverseComm);
+    ReverseComm::getComms().push_back(comm);
+
+    // for the aggregated adjoint messages of the replay
+    createInternalComm(*reverseComm);
+#else
+    createInternalComm(comm);
+#endif
+  }
+
+  /**
+   * @brief The communicator for the replay of the tape.
+   *
+   * @param[in] comm  The user communicator.
+   *
+   * @return The duplicate of the communicator or the communicator itself if it has no duplicate.
+   */
+  inline MPI_Comm getReverseComm(MPI_Comm comm) {
+#if MEDI_ReverseComm
+    int keyval = ReverseComm::getKeyval();
+    if(MPI_KEYVAL_INVALID != keyval && MPI_COMM_NULL != comm) {
+      void* value;
+      int flag = 0;
+      MPI_Comm_get_attr(comm, keyval, &value, &flag);
+      if(flag) {
+        return *reinterpret_cast<MPI_Comm*>(value);
+      }
+    }
+#endif
+
+    return comm;
+  }
+
+  /**
+   * @brief Free all duplicates of ReverseComm and InternalComm that are still alive.
+   *
+   * Called in AMPI_Finalize.
+   */
+  inline void freeReverseComms() {
+    int& keyval = ReverseComm::getKeyval();
+    if(MPI_KEYVAL_INVALID != keyval) {
+      // copy the list, the delete callback removes the entries
+      std::vector<MPI_Comm> comms = ReverseComm::getComms();
+      for(size_t i = 0; i < comms.size(); ++i) {
+        MPI_Comm_delete_attr(comms[i], keyval);
+      }
+
+      MPI_Comm_free_keyval(&keyval);
+    }
+
+    // the duplicates of the freed communicators are already gone
+    int& internalKeyval = InternalComm::getKeyval();
+    if(MPI_KEYVAL_INVALID != internalKeyval) {
+      std::vector<MPI_Comm> comms = InternalComm::getComms();
+      for(size_t i = 0; i < comms.size(); ++i) {
+        MPI_Comm_delete_attr(comms[i], internalKeyval);
+      }
+
+      MPI_Comm_free_keyval(&internalKeyval);
+    }
+  }
+}
@@ -31,6 +31,9 @@
 #include "ampiMisc.h"
 #include "async.hpp"
 #include "message.hpp"
+#include "reverseComm.hpp"
+#include "adjointTransport.hpp"
+#include "collectiveHierarchy.hpp"
 #include "../displacementTools.hpp"
 
 /**
@@ -38,11 +41,45 @@
  */
 namespace medi {
 
+  /**
+   * @brief The number of rank contributions in the adjoint buffer of a reverse reduction.
+   *
+   * If the AD tool supports MPI_SUM on the adjoint type, the contributions are summed during the communication and
+   * the buffer holds only one contribution. Otherwise the contributions of all ranks are gathered and need to be
+   * combined with AdjointInterface::combineAdjoints.
+   *
+   * @param[in] datatype  The data type of the reduction.
+   * @param[in]     comm  The communicator of the reduction.
+   *
+   * @return 1 or the size of the communicator.
+   */
+  template<typename DATATYPE>
+  inline int getAdjointCombineRanks(DATATYPE* datatype, AMPI_Comm comm) {
+    if(datatype->getADTool().isAdjointSumSupported()) {
+      return 1;
+    } else {
+      return getCommSize(comm);
+    }
+  }
+
+  /**
+   * @brief The number of neighbor contributions in the adjoint buffer of a reverse neighborhood gather.
+   *
+   * The buffer has at least one contribution, so that ranks without destinations get a zero adjoint.
+   *
+   * @param[in] comm  The communicator with the process topology.
+   *
+   * @return The out degree of this process or 1 if it has no destinations.
+   */
+  inline int getAdjointCombineNeighbors(AMPI_Comm comm) {
+    return std::max(1, getCommOutDegree(comm));
+  }
+
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
   template<typename DATATYPE>
   void AMPI_Send_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
   }
 #endif
 
@@ -50,7 +87,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Isend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, request);
   }
 #endif
 
@@ -58,7 +95,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Bsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
   }
 #endif
 
@@ -66,7 +103,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Ibsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, request);
   }
 #endif
 
@@ -74,7 +111,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Ssend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
   }
 #endif
 
@@ -82,7 +119,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Issend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, request);
   }
 #endif
 
@@ -90,7 +127,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Rsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm) {
     MEDI_UNUSED(count);
-    MPI_Recv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, MPI_STATUS_IGNORE);
+    recvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm);
   }
 #endif
 
@@ -98,7 +135,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Irsend_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Irecv(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, &request->request);
+    irecvAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), dest, tag, comm, request);
   }
 #endif
 
@@ -107,7 +144,7 @@ namespace medi {
   void AMPI_Recv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Status* status) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(status);
-    MPI_Send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
+    sendAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm);
   }
 #endif
 
@@ -116,7 +153,7 @@ namespace medi {
   void AMPI_Mrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Status* status) {
     MEDI_UNUSED(count);
     MEDI_UNUSED(status);
-    MPI_Send(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), message->src, message->tag, message->comm);
+    sendAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), message->src, message->tag, getReverseComm(message->comm));
   }
 #endif
 
@@ -124,7 +161,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Irecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, int src, int tag, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Isend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, &request->request);
+    isendAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), src, tag, comm, request);
   }
 #endif
 
@@ -132,7 +169,7 @@ namespace medi {
   template<typename DATATYPE>
   void AMPI_Imrecv_adj(typename DATATYPE::AdjointType* bufAdjoints, int bufSize, int count, DATATYPE* datatype, AMPI_Message* message, AMPI_Request* request) {
     MEDI_UNUSED(count);
-    MPI_Isend(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), message->src, message->tag, message->comm, &request->request);
+    isendAdjoints(bufAdjoints, bufSize, datatype->getADTool().getAdjointMpiType(), message->src, message->tag, getReverseComm(message->comm), request);
   }
 #endif
 
@@ -144,7 +181,7 @@ namespace medi {
 
     MEDI_UNUSED(sendcount);
     MEDI_UNUSED(recvcount);
-    MPI_Sendrecv(recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType(), source, recvtag, sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType(), dest, sendtag, comm, status);
+    sendrecvAdjoints(recvbuf, recvbufSize, recvtype->getADTool().getAdjointMpiType(), source, recvtag, sendbuf, sendbufSize, sendtype->getADTool().getAdjointMpiType(), dest, sendtag, comm, status);
   }
 
 #if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
@@ -152,7 +189,11 @@ namespace medi {
   void AMPI_Bcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
 
-    MPI_Gather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+    if(datatype->getADTool().isAdjointSumSupported()) {
+      hierarchicalReduce(recvbufAdjoints, sendbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+    } else {
+      MPI_Gather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+    }
   }
 #endif
 
@@ -161,7 +202,11 @@ namespace medi {
   void AMPI_Ibcast_wrap_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Request* request) {
     MEDI_UNUSED(count);
 
-    MPI_Igather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    if(datatype->getADTool().isAdjointSumSupported()) {
+      MPI_Ireduce(recvbufAdjoints, sendbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, root, comm, &request->request);
+    } else {
+      MPI_Igather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm, &request->request);
+    }
   }
 #endif
 
@@ -343,10 +388,10 @@ namespace medi {
   void AMPI_Reduce_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     MEDI_UNUSED(count);
     if(root == getCommRank(comm)) {
-      MPI_Bcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+      hierarchicalBcast(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
       std::swap(sendbufAdjoints, recvbufAdjoints);
     } else {
-      MPI_Bcast(sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
+      hierarchicalBcast(sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), root, comm);
     }
   }
 #endif
@@ -370,7 +415,12 @@ namespace medi {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
 
-    MPI_Allgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm);
+    // The adjoint combination is always a sum, pre and post adjoint operations are applied locally.
+    if(datatype->getADTool().isAdjointSumSupported()) {
+      hierarchicalAllreduce(recvbufAdjoints, sendbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), comm);
+    } else {
+      MPI_Allgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm);
+    }
   }
 #endif
 
@@ -380,7 +430,165 @@ namespace medi {
     MEDI_UNUSED(op);
     MEDI_UNUSED(count);
 
+    // The adjoint combination is always a sum, pre and post adjoint operations are applied locally.
+    if(datatype->getADTool().isAdjointSumSupported()) {
+      MPI_Iallreduce(recvbufAdjoints, sendbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), MPI_SUM, comm, &request->request);
+    } else {
+      MPI_Iallgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
+    }
+  }
+#endif
+
+#if MEDI_MPI_VERSION_1_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(op);
+
+    // each rank sends its block back to all ranks, the operator specific parts are evaluated locally
+    LinearDisplacements linDis(getCommSize(comm), recvcounts, sendbufSize);
+    MPI_Allgatherv(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis.counts, linDis.displs, datatype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(op);
+
+    // each rank sends its block back to all ranks, the operator specific parts are evaluated locally
+    LinearDisplacements* linDis = new LinearDisplacements(getCommSize(comm), recvcounts, sendbufSize);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+
+    MPI_Iallgatherv(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis->counts, linDis->displs, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Reduce_scatter_block_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvcount);
+
+    // each rank sends its block back to all ranks, the operator specific parts are evaluated locally
+    MPI_Allgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  void AMPI_Ireduce_scatter_block_global_adj(typename DATATYPE::AdjointType* &sendbufAdjoints, int sendbufSize, typename DATATYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(recvcount);
+
+    // each rank sends its block back to all ranks, the operator specific parts are evaluated locally
     MPI_Iallgather(recvbufAdjoints, recvbufSize, datatype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, datatype->getADTool().getAdjointMpiType(), comm, &request->request);
   }
 #endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getAdjointCombineNeighbors(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm));
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgather_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getAdjointCombineNeighbors(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm), &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    LinearDisplacements linDis(getCommOutDegree(comm), sendbufSize);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getAdjointCombineNeighbors(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis.counts, linDis.displs, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm));
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_allgatherv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* displs, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(displs);
+
+    LinearDisplacements* linDis = new LinearDisplacements(getCommOutDegree(comm), sendbufSize);
+    request->setReverseData(reinterpret_cast<void*>(linDis), LinearDisplacements::deleteFunc);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getAdjointCombineNeighbors(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, linDis->counts, linDis->displs, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm), &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getCommOutDegree(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm));
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoall_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int sendbufSize, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int recvbufSize, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcount);
+    MEDI_UNUSED(recvcount);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, sendbufSize * getCommOutDegree(comm), sendtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoall(recvbufAdjoints, recvbufSize, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufSize, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm), &request->request);
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Neighbor_alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, computeDisplacementsTotalSize(sendbufCounts, getCommOutDegree(comm)), sendtype->getADTool().getAdjointMpiType());
+    MPI_Neighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm));
+  }
+#endif
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  void AMPI_Ineighbor_alltoallv_adj(typename SENDTYPE::AdjointType* &sendbufAdjoints, int* sendbufCounts, MEDI_OPTIONAL_CONST int* sendbufDispls, MEDI_OPTIONAL_CONST int* sendcounts, MEDI_OPTIONAL_CONST int* sdispls, SENDTYPE* sendtype, typename RECVTYPE::AdjointType* &recvbufAdjoints, int* recvbufCounts, MEDI_OPTIONAL_CONST int* recvbufDispls, MEDI_OPTIONAL_CONST int* recvcounts, MEDI_OPTIONAL_CONST int* rdispls, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request) {
+    MEDI_UNUSED(sendcounts);
+    MEDI_UNUSED(sdispls);
+    MEDI_UNUSED(recvcounts);
+    MEDI_UNUSED(rdispls);
+
+    // the adjoints are sent back along the edges of the topology, blocks of missing neighbors stay zero
+    setZero(sendbufAdjoints, computeDisplacementsTotalSize(sendbufCounts, getCommOutDegree(comm)), sendtype->getADTool().getAdjointMpiType());
+    MPI_Ineighbor_alltoallv(recvbufAdjoints, recvbufCounts, recvbufDispls, recvtype->getADTool().getAdjointMpiType(), sendbufAdjoints, sendbufCounts, sendbufDispls, sendtype->getADTool().getAdjointMpiType(), getCommTransposed(comm), &request->request);
+  }
+#endif
 }
@@ -0,0 +1,236 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstring>
+
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Counters for the adjoint messages of the point to point communication.
+   *
+   * The counters are only updated on the sending side of the adjoint messages and if the sparse transfer is enabled.
+   */
+  struct SparseAdjointStatistics {
+      long messages;        ///< Number of adjoint messages.
+      long sparseMessages;  ///< Number of adjoint messages that were sent in the sparse format.
+      long denseBytes;      ///< Number of bytes that the messages would have with the dense format.
+      long sentBytes;       ///< Number of bytes that were actually sent.
+
+      SparseAdjointStatistics() :
+        messages(0),
+        sparseMessages(0),
+        denseBytes(0),
+        sentBytes(0) {}
+
+      /**
+       * @return The number of bytes that were saved by the sparse format.
+       */
+      long getSavedBytes() const {
+        return denseBytes - sentBytes;
+      }
+  };
+
+  /**
+   * @brief Settings for the sparse transfer of the adjoints in the reverse point to point communication.
+   *
+   * If enabled, the sender of the adjoints checks the density of the nonzero entries. If it is below the threshold,
+   * the adjoints are sent as (index, value) pairs and the receiver expands them into the adjoint buffer. Entries are
+   * zero if all their bytes are zero.
+   *
+   * The settings change the format of the messages, they need to be the same on all processes.
+   */
+  struct SparseAdjointSettings {
+      bool enabled;             ///< If the sparse transfer is enabled.
+      double densityThreshold;  ///< Maximum ratio of nonzero entries for the sparse format.
+      SparseAdjointStatistics statistics;
+
+      SparseAdjointSettings() :
+        enabled(false),
+        densityThreshold(0.5),
+        statistics() {}
+  };
+
+  /**
+   * @brief Access to the global settings for the sparse transfer of adjoints.
+   *
+   * @return Reference to the global settings.
+   */
+  inline SparseAdjointSettings& globalSparseAdjointSettings() {
+    static SparseAdjointSettings settings;
+
+    return settings;
+  }
+
+  /**
+   * @brief Enable or disable the sparse transfer of adjoints in the reverse point to point communication.
+   *
+   * Needs to be called with the same arguments on all processes, before the reverse evaluation.
+   *
+   * @param[in]          enabled  If the sparse transfer should be used.
+   * @param[in] densityThreshold  Maximum ratio of nonzero entries for which the sparse format is used.
+   */
+  inline void setSparseAdjointTransfer(bool enabled, double densityThreshold = 0.5) {
+    globalSparseAdjointSettings().enabled = enabled;
+    globalSparseAdjointSettings().densityThreshold = densityThreshold;
+  }
+
+  /**
+   * @return The counters of the sparse transfer on this process.
+   */
+  inline const SparseAdjointStatistics& getSparseAdjointStatistics() {
+    return globalSparseAdjointSettings().statistics;
+  }
+
+  /**
+   * @brief Set all counters of the sparse transfer to zero.
+   */
+  inline void resetSparseAdjointStatistics() {
+    globalSparseAdjointSettings().statistics = SparseAdjointStatistics();
+  }
+
+  /**
+   * @brief Encoding and decoding of the sparse adjoint messages.
+   *
+   * The sparse format is [int nonzeros][int indices[nonzeros]][entries of the nonzero elements]. It is only used if it
+   * is smaller than the dense format, so the receiver can always post the dense size and identify the format by the
+   * number of received bytes.
+   */
+  struct SparseAdjoints {
+
+      /**
+       * @brief Create the message for the adjoints.
+       *
+       * @param[in]     adjoints  The adjoint buffer.
+       * @param[in]     elements  The number of elements in the adjoint buffer.
+       * @param[in]  elementSize  The size of one element in bytes.
+       * @param[out]       bytes  The size of the message in bytes.
+       *
+       * @return The sparse message which needs to be deleted with delete [] or nullptr if the dense buffer should be
+       *         sent.
+       */
+      static char* encode(const void* adjoints, int elements, int elementSize, int& bytes) {
+        SparseAdjointSettings& settings = globalSparseAdjointSettings();
+        const char* data = reinterpret_cast<const char*>(adjoints);
+        int denseBytes = elements * elementSize;
+
+        int maxNonzeros = (int)(settings.densityThreshold * elements);
+        int nonzeros = 0;
+        for(int i = 0; i < elements && nonzeros <= maxNonzeros; ++i) {
+          if(!isZero(&data[i * elementSize], elementSize)) {
+            nonzeros += 1;
+          }
+        }
+
+        int sparseBytes = (int)sizeof(int) * (1 + nonzeros) + nonzeros * elementSize;
+
+        char* message = nullptr;
+        if(nonzeros <= maxNonzeros && sparseBytes < denseBytes) {
+          message = new char[sparseBytes];
+          char* values = &message[sizeof(int) * (1 + nonzeros)];
+
+          std::memcpy(message, &nonzeros, sizeof(int));
+          int pos = 0;
+          for(int i = 0; i < elements; ++i) {
+            if(!isZero(&data[i * elementSize], elementSize)) {
+              std::memcpy(&message[sizeof(int) * (1 + pos)], &i, sizeof(int));
+              std::memcpy(&values[pos * elementSize], &data[i * elementSize], elementSize);
+              pos += 1;
+            }
+          }
+
+          bytes = sparseBytes;
+          settings.statistics.sparseMessages += 1;
+        } else {
+          bytes = denseBytes;
+        }
+
+        settings.statistics.messages += 1;
+        settings.statistics.denseBytes += denseBytes;
+        settings.statistics.sentBytes += bytes;
+
+        return message;
+      }
+
+      /**
+       * @brief Expand a received sparse message in place.
+       *
+       * @param[in,out]  adjoints  The adjoint buffer that received the message.
+       * @param[in]      elements  The number of elements in the adjoint buffer.
+       * @param[in]   elementSize  The size of one element in bytes.
+       * @param[in]         bytes  The number of received bytes.
+       */
+      static void decode(void* adjoints, int elements, int elementSize, int bytes) {
+        if(bytes != elements * elementSize) {
+          char* data = reinterpret_cast<char*>(adjoints);
+          char* message = new char[bytes];
+          std::memcpy(message, data, bytes);
+          std::memset(data, 0, elements * elementSize);
+
+          int nonzeros;
+          std::memcpy(&nonzeros, message, sizeof(int));
+          const char* values = &message[sizeof(int) * (1 + nonzeros)];
+          for(int pos = 0; pos < nonzeros; ++pos) {
+            int index;
+            std::memcpy(&index, &message[sizeof(int) * (1 + pos)], sizeof(int));
+            std::memcpy(&data[index * elementSize], &values[pos * elementSize], elementSize);
+          }
+
+          delete [] message;
+        }
+      }
+
+      /**
+       * @return The size of one element of the adjoint data type in bytes.
+       */
+      static int getElementSize(MPI_Datatype adjointType) {
+        int size;
+        MPI_Type_size(adjointType, &size);
+
+        return size;
+      }
+
+    private:
+
+      static bool isZero(const char* element, int elementSize) {
+        for(int i = 0; i < elementSize; ++i) {
+          if(0 != element[i]) {
+            return false;
+          }
+        }
+
+        return true;
+      }
+  };
+}
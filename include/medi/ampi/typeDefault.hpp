@@ -31,7 +31,9 @@
 #include <new>
 
 #include "../macros.h"
+#include "../adToolBulkHooks.hpp"
 #include "typeInterface.hpp"
+#include "typeTraits.hpp"
 #include "op.hpp"
 
 /**
@@ -64,6 +66,9 @@ namespace medi {
 
       typedef ADTool Tool;
 
+      /** @brief Array versions of the tool methods, see ADToolBulkHooks for the optional hooks. */
+      typedef ADToolBulkHooks<ADTool> Bulk;
+
       bool isClone;
 
       Tool* adTool;
@@ -107,56 +112,48 @@ namespace medi {
 
       inline void copyIntoModifiedBuffer(const Type* buf, size_t bufOffset, ModifiedType* bufMod, size_t bufModOffset, int elements) const {
         if(adTool->isModifiedBufferRequired()) {
-          for(int i = 0; i < elements; ++i) {
-            ADTool::setIntoModifyBuffer(bufMod[bufModOffset + i], buf[bufOffset + i]);
-          }
+          Bulk::setIntoModifyBuffer(&bufMod[bufModOffset], &buf[bufOffset], elements);
         }
       }
 
       inline void copyFromModifiedBuffer(Type* buf, size_t bufOffset, const ModifiedType* bufMod, size_t bufModOffset, int elements) const {
         if(adTool->isModifiedBufferRequired()) {
-          for(int i = 0; i < elements; ++i) {
-            ADTool::getFromModifyBuffer(bufMod[bufModOffset + i], buf[bufOffset + i]);
-          }
+          Bulk::getFromModifyBuffer(&bufMod[bufModOffset], &buf[bufOffset], elements);
         }
       }
 
       inline void getIndices(const Type* buf, size_t bufOffset, IndexType* indices, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
-          indices[indexOffset + i] = ADTool::getIndex(buf[bufOffset + i]);
-        }
+        Bulk::getIndex(&buf[bufOffset], &indices[indexOffset], elements);
       }
 
       inline void registerValue(Type* buf, size_t bufOffset, IndexType* indices, PrimalType* oldPrimals, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
-          ADTool::registerValue(buf[bufOffset + i], oldPrimals[indexOffset + i], indices[indexOffset + i]);
-        }
+        Bulk::registerValue(&buf[bufOffset], &oldPrimals[indexOffset], &indices[indexOffset], elements);
       }
 
       inline void clearIndices(Type* buf, size_t bufOffset, int elements) const {
-        for(int i = 0; i < elements; ++i) {
-          ADTool::clearIndex(buf[bufOffset + i]);
-        }
+        Bulk::clearIndex(&buf[bufOffset], elements);
       }
 
       inline void createIndices(Type* buf, size_t bufOffset, IndexType* indices, size_t bufModOffset, int elements) const {
         int indexOffset = computeActiveElements((int)bufModOffset);
 
-        for(int i = 0; i < elements; ++i) {
-          ADTool::createIndex(buf[bufOffset + i], indices[indexOffset + i]);
-        }
+        Bulk::createIndex(&buf[bufOffset], &indices[indexOffset], elements);
       }
 
       inline void getValues(const Type* buf, size_t bufOffset, PrimalType* primals, size_t bufModOffset, int elements) const {
         int primalOffset = computeActiveElements((int)bufModOffset);
 
-        for(int pos = 0; pos < elements; ++pos) {
-          primals[primalOffset + pos] = ADTool::getValue(buf[bufOffset + pos]);
-        }
+        Bulk::getValue(&buf[bufOffset], &primals[primalOffset], elements);
+      }
+
+      inline void setModifiedValues(ModifiedType* bufMod, size_t bufModOffset, const PrimalType* primals, size_t primalOffset, int elements) const {
+        int linearOffset = computeActiveElements((int)primalOffset);
+
+        Bulk::setModifiedValue(&bufMod[bufModOffset], &primals[linearOffset], elements);
       }
 
       inline void performReduce(Type* buf, Type* target, int count, AMPI_Op op, int ranks) const {
@@ -189,27 +186,21 @@ namespace medi {
       }
 
       inline void createTypeBuffer(Type* &buf, size_t size) const {
-        buf = new Type[size];
+        buf = adTool->getBufferArena().template createArray<Type>(size);
       }
 
       inline void createModifiedTypeBuffer(ModifiedType* &buf, size_t size) const {
-        buf = new ModifiedType[size];
+        buf = adTool->getBufferArena().template createArray<ModifiedType>(size);
       }
 
       inline void deleteTypeBuffer(Type* &buf, size_t size) const {
         MEDI_UNUSED(size);
 
-        if(NULL != buf) {
-          delete [] buf;
-          buf = NULL;
-        }
+        adTool->getBufferArena().deleteArray(buf);
       }
 
       inline void deleteModifiedTypeBuffer(ModifiedType* &buf) const {
-        if(NULL != buf) {
-          delete [] buf;
-          buf = NULL;
-        }
+        adTool->getBufferArena().deleteArray(buf);
       }
 
       inline MpiTypeDefault* clone() const {
@@ -226,4 +217,10 @@ namespace medi {
         return new MpiTypeDefault(adTool, this->getMpiType(), this->getModifiedMpiType(), true);
       }
   };
+
+  /**
+   * @brief The properties are defined by the AD tool.
+   */
+  template<typename ADTool>
+  struct DatatypeTraits<MpiTypeDefault<ADTool>> : public ADToolTraits<ADTool> {};
 }
@@ -236,6 +236,20 @@ namespace medi {
        */
       virtual void getValues(const void* buf, size_t bufOffset, void* primals, size_t bufModOffset, int elements) const = 0;
 
+      /**
+       * @brief Set the primal values of the elements in a modified buffer.
+       *
+       * The other data of the elements in the modified buffer is not changed. If the AD tool does not require a
+       * modified buffer, the modified buffer is a copy of the user buffer.
+       *
+       * @param[in,out]       bufMod  The modified buffer.
+       * @param[in]     bufModOffset  The offset into the modified buffer.
+       * @param[in]          primals  The primal values for the elements. Values are stored in a linearized fashion.
+       * @param[in]     primalOffset  The linearized displacement for the primal values.
+       * @param[in]         elements  The number of elements that are set.
+       */
+      virtual void setModifiedValues(void* bufMod, size_t bufModOffset, const void* primals, size_t primalOffset, int elements) const = 0;
+
       /**
        * @brief Perform a local reduce operation.
        *
@@ -362,6 +376,10 @@ namespace medi {
         cast().getValues(castBuffer<TypeB>(buf), bufOffset, castBuffer<PrimalTypeB>(primals), bufModOffset, elements);
       }
 
+      void setModifiedValues(void* bufMod, size_t bufModOffset, const void* primals, size_t primalOffset, int elements) const {
+        cast().setModifiedValues(castBuffer<ModifiedTypeB>(bufMod), bufModOffset, castBuffer<PrimalTypeB>(primals), primalOffset, elements);
+      }
+
       void performReduce(void* buf, void* target, int count, AMPI_Op op, int ranks) const {
         cast().performReduce(castBuffer<TypeB>(buf), castBuffer<TypeB>(target), count, op, ranks);
       }
@@ -35,6 +35,7 @@
 #include "../adToolPassive.hpp"
 #include "../macros.h"
 #include "typeInterface.hpp"
+#include "typeTraits.hpp"
 #include "op.hpp"
 
 /**
@@ -148,6 +149,14 @@ namespace medi {
         MEDI_UNUSED(elements);
       }
 
+      inline void setModifiedValues(ModifiedType* bufMod, size_t bufModOffset, const PrimalType* primals, size_t primalOffset, int elements) const {
+        MEDI_UNUSED(bufMod);
+        MEDI_UNUSED(bufModOffset);
+        MEDI_UNUSED(primals);
+        MEDI_UNUSED(primalOffset);
+        MEDI_UNUSED(elements);
+      }
+
       inline void performReduce(Type* buf, Type* target, int count, AMPI_Op op, int ranks) const {
         MEDI_UNUSED(buf);
         MEDI_UNUSED(target);
@@ -203,4 +212,10 @@ namespace medi {
         return new MpiTypePassive(type, true);
       }
   };
+
+  /**
+   * @brief Passive types are never AD types.
+   */
+  template<typename T>
+  struct DatatypeTraits<MpiTypePassive<T>> : public ADToolTraits<ADToolPassive> {};
 }
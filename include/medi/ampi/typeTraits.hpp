@@ -0,0 +1,121 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include "../adToolInterface.h"
+#include "../macros.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Properties of a MPI type interface that are known at compile time.
+   *
+   * See ADToolTraits for details. The default leaves all decisions to the run time. The implementations of the
+   * MpiTypeInterface specialize the structure if their AD tool is known at compile time.
+   *
+   * @tparam DATATYPE  The implementation of the MpiTypeInterface.
+   */
+  template<typename DATATYPE>
+  struct DatatypeTraits : public ADToolTraits<ADToolInterface> {};
+
+  /**
+   * @brief Checks if the type is an AD type.
+   *
+   * Evaluated at compile time if the traits of the type are static.
+   *
+   * @param[in] datatype  The type of the communication.
+   *
+   * @return See ADToolInterface::isActiveType.
+   */
+  template<typename DATATYPE>
+  inline bool isActiveType(const DATATYPE* datatype) {
+    if(DatatypeTraits<DATATYPE>::isStatic()) {
+      return DatatypeTraits<DATATYPE>::isActive();
+    } else {
+      return datatype->getADTool().isActiveType();
+    }
+  }
+
+  /**
+   * @brief Checks if a handle needs to be recorded.
+   *
+   * Evaluated at compile time if the traits of the type are static and the type is not active.
+   *
+   * @param[in] datatype  The type of the communication.
+   *
+   * @return See ADToolInterface::isHandleRequired.
+   */
+  template<typename DATATYPE>
+  inline bool isHandleRequired(const DATATYPE* datatype) {
+    if(DatatypeTraits<DATATYPE>::isStatic() && !DatatypeTraits<DATATYPE>::isActive()) {
+      return false;
+    } else {
+      return datatype->getADTool().isHandleRequired();
+    }
+  }
+
+  /**
+   * @brief Checks if the buffers need to be copied into modified buffers.
+   *
+   * Evaluated at compile time if the traits of the type are static.
+   *
+   * @param[in] datatype  The type of the communication.
+   *
+   * @return See MpiTypeInterface::isModifiedBufferRequired.
+   */
+  template<typename DATATYPE>
+  inline bool isModifiedBufferRequired(const DATATYPE* datatype) {
+    if(DatatypeTraits<DATATYPE>::isStatic()) {
+      return DatatypeTraits<DATATYPE>::needsModifiedBuffer();
+    } else {
+      return datatype->isModifiedBufferRequired();
+    }
+  }
+
+  /**
+   * @brief Checks if the overwritten primal values need to be stored.
+   *
+   * Evaluated at compile time if the traits of the type are static.
+   *
+   * @param[in] datatype  The type of the communication.
+   *
+   * @return See ADToolInterface::isOldPrimalsRequired.
+   */
+  template<typename DATATYPE>
+  inline bool isOldPrimalsRequired(const DATATYPE* datatype) {
+    if(DatatypeTraits<DATATYPE>::isStatic()) {
+      return DatatypeTraits<DATATYPE>::needsOldPrimals();
+    } else {
+      return datatype->getADTool().isOldPrimalsRequired();
+    }
+  }
+}
@@ -0,0 +1,1505 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <climits>
+#include <cstddef>
+#include <cstring>
+#include <list>
+#include <map>
+#include <vector>
+
+#include "../adjointInterface.hpp"
+#include "../adToolInterface.h"
+#include "../exceptions.hpp"
+#include "../macros.h"
+#include "../mpiTools.h"
+#include "../typeDefinitions.h"
+#include "ampiMisc.h"
+#include "op.hpp"
+#include "reverseComm.hpp"
+#include "typeInterface.hpp"
+#include "typeTraits.hpp"
+
+#include "../../../generated/medi/ampiDefinitions.h"
+
+#ifndef MEDI_WinSharedMemory
+  /**
+   * @brief If active windows use shared memory for the ranks of the window that are on the same node.
+   *
+   * It can be set with the preprocessor macro MEDI_WinSharedMemory=<0/1>
+   */
+  #define MEDI_WinSharedMemory 1
+#endif
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+#if MEDI_MPI_VERSION_2_0 <= MEDI_MPI_TARGET
+
+  /**
+   * @brief Checks if the memory of a window can be allocated with MPI_Win_allocate_shared on each node.
+   *
+   * The first call for a communicator is collective, see getCommNodeInfo.
+   *
+   * @param[in] comm  The communicator of the window.
+   * @return True if the communicator is split into the ranks of each node.
+   */
+  inline bool isWinSharedPossible(MPI_Comm comm) {
+#if MEDI_WinSharedMemory && MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    const CommInfo& info = getCommNodeInfo(comm);
+
+    return !info.isInter && MPI_COMM_NULL != info.nodeComm;
+#else
+    MEDI_UNUSED(comm);
+
+    return false;
+#endif
+  }
+
+  /**
+   * @brief Collective allocation of the memory of a window.
+   *
+   * With shared memory, the memory is allocated with MPI_Win_allocate_shared on the node communicator, see
+   * getCommNodeInfo, and the window on the whole communicator exposes it. The shared window stays in a passive target
+   * epoch of all ranks, so that the direct accesses can be synchronized with MPI_Win_sync. The addresses of the memory
+   * of the ranks on the node are stored in segments, the entries of the other ranks are nullptr. Otherwise the memory
+   * is allocated with MPI_Alloc_mem. The window is released with freeWin.
+   *
+   * @param[in]      size  Size of the memory in bytes.
+   * @param[in]  dispUnit  See MPI_Win_create.
+   * @param[in]      info  See MPI_Win_create.
+   * @param[in]      comm  See MPI_Win_create.
+   * @param[in]    shared  If the memory is allocated with MPI_Win_allocate_shared, see isWinSharedPossible.
+   * @param[out]     base  The memory of this process.
+   * @param[out] segments  The memory of all processes, empty if the memory is not shared.
+   * @param[out] sharedWin  The window of the shared memory on the node.
+   * @param[out]      win  The created window.
+   */
+  inline int allocateWin(MPI_Aint size, int dispUnit, MPI_Info info, MPI_Comm comm, bool shared, void* base,
+                         std::vector<char*>& segments, MPI_Win* sharedWin, MPI_Win* win) {
+    segments.clear();
+    *sharedWin = MPI_WIN_NULL;
+
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+    if(shared) {
+      const CommInfo& commInfo = getCommNodeInfo(comm);
+      MPI_Win_allocate_shared(size, dispUnit, info, commInfo.nodeComm, base, sharedWin);
+      MPI_Win_lock_all(MPI_MODE_NOCHECK, *sharedWin);
+
+      // the ranks of the communicator on the node
+      std::vector<int> ranks(commInfo.size);
+      std::vector<int> nodeRanks(commInfo.size);
+      for(int i = 0; i < commInfo.size; ++i) {
+        ranks[i] = i;
+      }
+      MPI_Group group;
+      MPI_Group nodeGroup;
+      MPI_Comm_group(comm, &group);
+      MPI_Comm_group(commInfo.nodeComm, &nodeGroup);
+      MPI_Group_translate_ranks(group, commInfo.size, ranks.data(), nodeGroup, nodeRanks.data());
+      MPI_Group_free(&nodeGroup);
+      MPI_Group_free(&group);
+
+      segments.assign(commInfo.size, nullptr);
+      for(int i = 0; i < commInfo.size; ++i) {
+        if(MPI_UNDEFINED != nodeRanks[i]) {
+          MPI_Aint segmentSize;
+          int segmentDispUnit;
+          MPI_Win_shared_query(*sharedWin, nodeRanks[i], &segmentSize, &segmentDispUnit, &segments[i]);
+        }
+      }
+    } else
+#else
+    MEDI_UNUSED(shared);
+#endif
+    {
+      MPI_Alloc_mem(size, MPI_INFO_NULL, base);
+    }
+
+    return MPI_Win_create(*reinterpret_cast<void**>(base), size, dispUnit, info, comm, win);
+  }
+
+  /**
+   * @brief Collective release of a window from allocateWin.
+   *
+   * @param[in]         base  The memory of this process.
+   * @param[in,out] sharedWin  The window of the shared memory on the node, MPI_WIN_NULL if the memory is not shared.
+   * @param[in,out]      win  The window.
+   */
+  inline int freeWin(void* base, MPI_Win* sharedWin, MPI_Win* win) {
+    int rStatus = MPI_Win_free(win);
+
+    if(MPI_WIN_NULL != *sharedWin) {
+      MPI_Win_unlock_all(*sharedWin);
+      MPI_Win_free(sharedWin);
+    } else {
+      MPI_Free_mem(base);
+    }
+
+    return rStatus;
+  }
+
+  /**
+   * @brief The access of a one sided operation to the elements of an active window.
+   */
+  enum class WinAccess {
+    None = 0,
+    Put = 1,
+    Accumulate = 2,
+    Get = 3
+  };
+
+  /**
+   * @brief Elements of a window with the same access in one epoch.
+   */
+  struct WinRun {
+      WinAccess access;
+      int start;   ///< First element of the run.
+      int length;  ///< Number of elements in the run.
+
+      /**
+       * @return True if the elements are overwritten by the access.
+       */
+      bool isWritten() const {
+        return WinAccess::Put == access || WinAccess::Accumulate == access;
+      }
+
+      /**
+       * @return True if the adjoints of the old values receive updates from the access.
+       */
+      bool isRead() const {
+        return WinAccess::Accumulate == access || WinAccess::Get == access;
+      }
+  };
+
+  /**
+   * @brief The accesses of one epoch on the elements of an active window, as recorded at the closing synchronization.
+   *
+   * The written elements have new identifiers, the read elements keep the identifiers of their old values.
+   */
+  struct WinEpoch {
+      const MpiTypeInterface* datatype;
+      int epoch;
+      std::vector<WinRun> runs;
+      int writtenCount;  ///< Number of active elements in the written runs.
+      int readCount;     ///< Number of active elements in the read runs.
+      void* writtenIndices;
+      void* readIndices;
+      void* oldPrimals;  ///< The old primal values of the written elements, if the AD tool requires them.
+
+      WinEpoch() :
+        datatype(nullptr),
+        epoch(0),
+        runs(),
+        writtenCount(0),
+        readCount(0),
+        writtenIndices(nullptr),
+        readIndices(nullptr),
+        oldPrimals(nullptr) {}
+
+      ~WinEpoch() {
+        if(nullptr != writtenIndices) {
+          datatype->getADTool().deleteIndexTypeBuffer(writtenIndices);
+        }
+        if(nullptr != readIndices) {
+          datatype->getADTool().deleteIndexTypeBuffer(readIndices);
+        }
+        if(nullptr != oldPrimals) {
+          datatype->getADTool().deletePrimalTypeBuffer(oldPrimals);
+        }
+      }
+  };
+
+  /**
+   * @brief Completion of a reverse one sided operation at the next synchronization of the adjoint window.
+   */
+  struct WinReverseOp {
+      int rank;
+      HandleBase* handle;
+      ReverseFunction finish;
+  };
+
+  /**
+   * @brief The adjoint window of an active window, which is used in the reverse evaluation.
+   *
+   * The adjoint window has two halves with the adjoint values of all active elements of the window. The target
+   * publishes the adjoints of the written elements of an epoch in the half of the epoch, before the origins of the
+   * epoch access it. Two halves are required, since the adjoint updates of an epoch are applied after the next
+   * synchronization, where the adjoints of the preceding epoch are already published.
+   *
+   * The adjoint window is created in the reverse of AMPI_Win_free and released in the reverse of AMPI_Win_create.
+   * The structure is shared by all handles of the window and deleted with the last one.
+   *
+   * If the forward window uses shared memory, the adjoint window does too. The reverse of a put to a rank on the same
+   * node then reads the published adjoints directly from the memory of the target. The adjoint sums of the reverse get are still
+   * performed by MPI_Accumulate, since several origins may update the same element.
+   */
+  struct WinReverse {
+      int references;
+      MPI_Comm comm;
+      MPI_Aint activeElements;
+      MPI_Datatype adjointMpiType;
+      int vectorSize;
+      MPI_Aint adjointBytes;  ///< Size of the adjoint values of one active element.
+      void* adjoints;
+      MPI_Win win;
+      bool shared;
+      std::vector<char*> segments;  ///< Adjoint memory of the ranks on the node if the window is shared.
+      MPI_Win sharedWin;  ///< Window of the shared adjoint memory on the node.
+      WinEpoch* stash;  ///< The epoch whose adjoint updates are applied at the next synchronization.
+      std::vector<WinReverseOp> pending;
+
+      WinReverse(MPI_Comm comm, MPI_Aint activeElements, MPI_Datatype adjointMpiType, bool shared) :
+        references(1),
+        comm(comm),
+        activeElements(activeElements),
+        adjointMpiType(adjointMpiType),
+        vectorSize(0),
+        adjointBytes(0),
+        adjoints(nullptr),
+        win(MPI_WIN_NULL),
+        shared(shared),
+        segments(),
+        sharedWin(MPI_WIN_NULL),
+        stash(nullptr),
+        pending() {}
+
+      void retain() {
+        references += 1;
+      }
+
+      void release() {
+        references -= 1;
+        if(0 == references) {
+          delete this;
+        }
+      }
+
+      /**
+       * @return The displacement of the adjoints of an active element in the adjoint window.
+       */
+      MPI_Aint computeDisplacement(int epoch, MPI_Aint activeOffset) const {
+        return (MPI_Aint)(epoch % 2) * activeElements + activeOffset;
+      }
+
+      char* computeAdjointPointer(int epoch, MPI_Aint activeOffset) const {
+        return reinterpret_cast<char*>(adjoints) + computeDisplacement(epoch, activeOffset) * adjointBytes;
+      }
+
+      /**
+       * @return The adjoints of an active element in the shared memory of the rank.
+       */
+      char* computeSharedPointer(int rank, int epoch, MPI_Aint activeOffset) const {
+        return segments[rank] + computeDisplacement(epoch, activeOffset) * adjointBytes;
+      }
+
+      /**
+       * @return True if the adjoints of the rank can be accessed directly.
+       */
+      bool isDirect(int rank) const {
+        return shared && MPI_PROC_NULL != rank && nullptr != segments[rank];
+      }
+
+      /**
+       * @brief Memory barrier for the direct accesses to the shared memory of the node.
+       */
+      void syncShared() {
+        if(shared) {
+          MPI_Win_sync(sharedWin);
+        }
+      }
+
+      void checkWindow() const {
+        if(MPI_WIN_NULL == win) {
+          MEDI_EXCEPTION("The adjoint window does not exist, the creation and the release of an active window need to be recorded.");
+        }
+      }
+
+      /**
+       * @brief Collective creation of the adjoint window.
+       */
+      void create(AdjointInterface* adjointInterface) {
+        vectorSize = adjointInterface->getVectorSize();
+        adjointBytes = getExtent(adjointMpiType) * vectorSize;
+
+        MPI_Aint bytes = 2 * activeElements * adjointBytes;
+        if(shared) {
+          allocateWin(bytes, (int)adjointBytes, MPI_INFO_NULL, comm, true, &adjoints, segments, &sharedWin, &win);
+        } else {
+          adjointInterface->createAdjointTypeBuffer(adjoints, (size_t)(2 * activeElements));
+          MPI_Win_create(adjoints, bytes, (int)adjointBytes, MPI_INFO_NULL, comm, &win);
+        }
+        if(0 != activeElements) {
+          std::memset(adjoints, 0, bytes);
+        }
+        stash = nullptr;
+      }
+
+      /**
+       * @brief Collective release of the adjoint window, closes the first epoch.
+       */
+      void free(AdjointInterface* adjointInterface) {
+        checkWindow();
+
+        MPI_Win_fence(MPI_MODE_NOSUCCEED, win);
+        finishPending(adjointInterface, MPI_ANY_SOURCE);
+        applyStash(adjointInterface);
+
+        if(shared) {
+          freeWin(adjoints, &sharedWin, &win);
+        } else {
+          MPI_Win_free(&win);
+          adjointInterface->deleteAdjointTypeBuffer(adjoints);
+        }
+      }
+
+      /**
+       * @brief Reverse of the closing synchronization of an epoch.
+       *
+       * Publishes the adjoints of the written elements, starts the reverse of the epoch and completes the reverse of
+       * the following epoch.
+       */
+      void fence(AdjointInterface* adjointInterface, WinEpoch* epoch, int assert) {
+        checkWindow();
+
+        publish(adjointInterface, *epoch);
+        syncShared();
+        MPI_Win_fence(assert, win);
+        syncShared();
+        finishPending(adjointInterface, MPI_ANY_SOURCE);
+        applyStash(adjointInterface);
+        stash = epoch;
+      }
+
+      /**
+       * @brief Complete the reverse operations to the rank, all operations for MPI_ANY_SOURCE.
+       */
+      void finishPending(AdjointInterface* adjointInterface, int rank) {
+        size_t kept = 0;
+        for(size_t i = 0; i < pending.size(); ++i) {
+          if(MPI_ANY_SOURCE == rank || pending[i].rank == rank) {
+            pending[i].finish(pending[i].handle, adjointInterface);
+          } else {
+            pending[kept] = pending[i];
+            kept += 1;
+          }
+        }
+        pending.resize(kept);
+      }
+
+    private:
+
+      void publish(AdjointInterface* adjointInterface, const WinEpoch& epoch) {
+        if(0 == epoch.writtenCount) {
+          return;
+        }
+
+        void* written = nullptr;
+        adjointInterface->createAdjointTypeBuffer(written, epoch.writtenCount);
+        adjointInterface->getAdjoints(epoch.writtenIndices, written, epoch.writtenCount);
+
+        if(isOldPrimalsRequired(epoch.datatype)) {
+          adjointInterface->setPrimals(epoch.writtenIndices, epoch.oldPrimals, epoch.writtenCount);
+        }
+
+        int pos = 0;
+        for(const WinRun& run : epoch.runs) {
+          if(run.isWritten()) {
+            int length = epoch.datatype->computeActiveElements(run.length);
+            std::memcpy(computeAdjointPointer(epoch.epoch, epoch.datatype->computeActiveElements(run.start)),
+                        reinterpret_cast<char*>(written) + pos * adjointBytes, length * adjointBytes);
+            pos += length;
+          }
+        }
+
+        adjointInterface->deleteAdjointTypeBuffer(written);
+      }
+
+      void applyStash(AdjointInterface* adjointInterface) {
+        if(nullptr == stash) {
+          return;
+        }
+
+        const WinEpoch& epoch = *stash;
+        void* read = nullptr;
+        if(0 != epoch.readCount) {
+          adjointInterface->createAdjointTypeBuffer(read, epoch.readCount);
+        }
+
+        int pos = 0;
+        for(const WinRun& run : epoch.runs) {
+          int length = epoch.datatype->computeActiveElements(run.length);
+          char* adjointPointer = computeAdjointPointer(epoch.epoch, epoch.datatype->computeActiveElements(run.start));
+          if(run.isRead()) {
+            std::memcpy(reinterpret_cast<char*>(read) + pos * adjointBytes, adjointPointer, length * adjointBytes);
+            pos += length;
+          }
+          std::memset(adjointPointer, 0, length * adjointBytes);
+        }
+
+        if(0 != epoch.readCount) {
+          adjointInterface->updateAdjoints(epoch.readIndices, read, epoch.readCount);
+          adjointInterface->deleteAdjointTypeBuffer(read);
+        }
+
+        stash = nullptr;
+      }
+  };
+
+  /**
+   * @brief Base for the handles of the one sided communication.
+   *
+   * Only the reverse evaluation is implemented, the forward and primal evaluation abort.
+   */
+  struct WinHandle : public HandleBase {
+      WinReverse* reverse;
+
+      WinHandle(WinReverse* reverse) :
+        HandleBase(),
+        reverse(reverse) {
+        reverse->retain();
+        this->funcForward = (ForwardFunction)WinHandle::unsupported;
+        this->funcPrimal = (PrimalFunction)WinHandle::unsupported;
+      }
+
+      ~WinHandle() {
+        reverse->release();
+      }
+
+    private:
+
+      static void unsupported(HandleBase* handle, AdjointInterface* adjointInterface) {
+        MEDI_UNUSED(handle);
+        MEDI_UNUSED(adjointInterface);
+
+        MEDI_EXCEPTION("One sided communication is only supported in the reverse evaluation of the tape.");
+      }
+  };
+
+  /**
+   * @brief Reverse of AMPI_Win_create, releases the adjoint window.
+   */
+  struct WinCreateHandle : public WinHandle {
+
+      WinCreateHandle(WinReverse* reverse) :
+        WinHandle(reverse) {
+        this->funcReverse = (ReverseFunction)WinCreateHandle::reverseFunc;
+      }
+
+    private:
+
+      static void reverseFunc(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinCreateHandle* h = static_cast<WinCreateHandle*>(handle);
+
+        h->reverse->free(adjointInterface);
+      }
+  };
+
+  /**
+   * @brief Reverse of AMPI_Win_free, creates the adjoint window.
+   */
+  struct WinFreeHandle : public WinHandle {
+
+      WinFreeHandle(WinReverse* reverse) :
+        WinHandle(reverse) {
+        this->funcReverse = (ReverseFunction)WinFreeHandle::reverseFunc;
+      }
+
+    private:
+
+      static void reverseFunc(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinFreeHandle* h = static_cast<WinFreeHandle*>(handle);
+
+        h->reverse->create(adjointInterface);
+      }
+  };
+
+  /**
+   * @brief Reverse of the synchronization that closes an epoch, see WinReverse::fence.
+   */
+  struct WinFenceHandle : public WinHandle {
+      WinEpoch epoch;
+      int previousAssert;  ///< Assertion of the synchronization that started the epoch.
+
+      WinFenceHandle(WinReverse* reverse) :
+        WinHandle(reverse),
+        epoch(),
+        previousAssert(0) {
+        this->funcReverse = (ReverseFunction)WinFenceHandle::reverseFunc;
+      }
+
+      ~WinFenceHandle() {
+        if(&epoch == reverse->stash) {
+          reverse->stash = nullptr;
+        }
+      }
+
+    private:
+
+      static void reverseFunc(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinFenceHandle* h = static_cast<WinFenceHandle*>(handle);
+
+        // the reverse epoch uses the synchronization of the forward epoch
+        int assert = 0;
+        if(0 != (h->previousAssert & MPI_MODE_NOSUCCEED)) {
+          assert = MPI_MODE_NOSUCCEED;
+        }
+
+        h->reverse->fence(adjointInterface, &h->epoch, assert);
+      }
+  };
+
+  /**
+   * @brief Reverse of AMPI_Win_lock and AMPI_Win_unlock, unlocks and locks the adjoint window.
+   */
+  struct WinLockHandle : public WinHandle {
+      int lockType;
+      int rank;
+
+      WinLockHandle(WinReverse* reverse, int lockType, int rank, bool isLock) :
+        WinHandle(reverse),
+        lockType(lockType),
+        rank(rank) {
+        if(isLock) {
+          this->funcReverse = (ReverseFunction)WinLockHandle::unlock;
+        } else {
+          this->funcReverse = (ReverseFunction)WinLockHandle::lock;
+        }
+      }
+
+    private:
+
+      static void lock(HandleBase* handle, AdjointInterface* adjointInterface) {
+        MEDI_UNUSED(adjointInterface);
+
+        WinLockHandle* h = static_cast<WinLockHandle*>(handle);
+
+        h->reverse->checkWindow();
+        MPI_Win_lock(h->lockType, h->rank, 0, h->reverse->win);
+        h->reverse->syncShared();
+      }
+
+      static void unlock(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinLockHandle* h = static_cast<WinLockHandle*>(handle);
+
+        h->reverse->syncShared();
+        MPI_Win_unlock(h->rank, h->reverse->win);
+        h->reverse->finishPending(adjointInterface, h->rank);
+      }
+  };
+
+  /**
+   * @brief Reverse of AMPI_Put and AMPI_Accumulate with MPI_SUM.
+   *
+   * The origin gets the adjoints of the target elements and updates the adjoints of the origin buffer.
+   */
+  struct WinPutHandle : public WinHandle {
+      const MpiTypeInterface* datatype;
+      int count;  ///< Number of active elements.
+      void* indices;
+      /* required for async */ void* adjoints;
+      int rank;
+      MPI_Aint disp;  ///< Displacement of the first active element in the target window.
+      int epoch;
+
+      WinPutHandle(WinReverse* reverse, const MpiTypeInterface* datatype) :
+        WinHandle(reverse),
+        datatype(datatype),
+        count(0),
+        indices(nullptr),
+        adjoints(nullptr),
+        rank(MPI_PROC_NULL),
+        disp(0),
+        epoch(0) {
+        this->funcReverse = (ReverseFunction)WinPutHandle::reverseFunc;
+      }
+
+      ~WinPutHandle() {
+        if(nullptr != indices) {
+          datatype->getADTool().deleteIndexTypeBuffer(indices);
+        }
+      }
+
+    private:
+
+      static void reverseFunc(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinPutHandle* h = static_cast<WinPutHandle*>(handle);
+        WinReverse& r = *h->reverse;
+
+        r.checkWindow();
+        if(r.isDirect(h->rank)) {
+          // the adjoints are published by the target before the synchronization of the epoch
+          adjointInterface->updateAdjoints(h->indices, r.computeSharedPointer(h->rank, h->epoch, h->disp),
+                                           h->count);
+
+          return;
+        }
+
+        adjointInterface->createAdjointTypeBuffer(h->adjoints, h->count);
+
+        int elements = h->count * r.vectorSize;
+        MPI_Get(h->adjoints, elements, r.adjointMpiType, h->rank, r.computeDisplacement(h->epoch, h->disp),
+                elements, r.adjointMpiType, r.win);
+
+        r.pending.push_back(WinReverseOp{h->rank, h, (ReverseFunction)WinPutHandle::finish});
+      }
+
+      static void finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinPutHandle* h = static_cast<WinPutHandle*>(handle);
+
+        adjointInterface->updateAdjoints(h->indices, h->adjoints, h->count);
+        adjointInterface->deleteAdjointTypeBuffer(h->adjoints);
+      }
+  };
+
+  /**
+   * @brief Reverse of AMPI_Get.
+   *
+   * The origin sums the adjoints of the origin buffer onto the adjoints of the target elements.
+   */
+  struct WinGetHandle : public WinHandle {
+      const MpiTypeInterface* datatype;
+      int count;  ///< Number of active elements.
+      void* indices;
+      void* oldPrimals;
+      /* required for async */ void* adjoints;
+      int rank;
+      MPI_Aint disp;  ///< Displacement of the first active element in the target window.
+      int epoch;
+
+      WinGetHandle(WinReverse* reverse, const MpiTypeInterface* datatype) :
+        WinHandle(reverse),
+        datatype(datatype),
+        count(0),
+        indices(nullptr),
+        oldPrimals(nullptr),
+        adjoints(nullptr),
+        rank(MPI_PROC_NULL),
+        disp(0),
+        epoch(0) {
+        this->funcReverse = (ReverseFunction)WinGetHandle::reverseFunc;
+      }
+
+      ~WinGetHandle() {
+        if(nullptr != indices) {
+          datatype->getADTool().deleteIndexTypeBuffer(indices);
+        }
+        if(nullptr != oldPrimals) {
+          datatype->getADTool().deletePrimalTypeBuffer(oldPrimals);
+        }
+      }
+
+    private:
+
+      static void reverseFunc(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinGetHandle* h = static_cast<WinGetHandle*>(handle);
+        WinReverse& r = *h->reverse;
+
+        r.checkWindow();
+        if(!h->datatype->getADTool().isAdjointSumSupported()) {
+          MEDI_EXCEPTION("The reverse of AMPI_Get requires that the adjoint values can be summed with MPI_SUM.");
+        }
+
+        adjointInterface->createAdjointTypeBuffer(h->adjoints, h->count);
+        adjointInterface->getAdjoints(h->indices, h->adjoints, h->count);
+
+        if(isOldPrimalsRequired(h->datatype)) {
+          adjointInterface->setPrimals(h->indices, h->oldPrimals, h->count);
+        }
+
+        int elements = h->count * r.vectorSize;
+        MPI_Accumulate(h->adjoints, elements, r.adjointMpiType, h->rank, r.computeDisplacement(h->epoch, h->disp),
+                       elements, r.adjointMpiType, MPI_SUM, r.win);
+
+        r.pending.push_back(WinReverseOp{h->rank, h, (ReverseFunction)WinGetHandle::finish});
+      }
+
+      static void finish(HandleBase* handle, AdjointInterface* adjointInterface) {
+        WinGetHandle* h = static_cast<WinGetHandle*>(handle);
+
+        adjointInterface->deleteAdjointTypeBuffer(h->adjoints);
+      }
+  };
+
+  /**
+   * @brief A one sided operation of this process as origin, which is completed at the next synchronization.
+   */
+  struct WinOriginOp {
+      WinAccess access;
+      const MpiTypeInterface* datatype;
+      void* buf;      ///< The user buffer of a get.
+      int count;
+      int rank;
+      MPI_Aint disp;
+      int epoch;
+      void* bufMod;   ///< The modified buffer, if one was created.
+      void* primals;  ///< The primal values of an accumulate.
+      std::vector<int> marks;
+
+      WinOriginOp(WinAccess access, const MpiTypeInterface* datatype, void* buf, int count, int rank, MPI_Aint disp,
+                  int epoch) :
+        access(access),
+        datatype(datatype),
+        buf(buf),
+        count(count),
+        rank(rank),
+        disp(disp),
+        epoch(epoch),
+        bufMod(nullptr),
+        primals(nullptr),
+        marks() {}
+  };
+
+  /**
+   * @brief The data of an active window, stored in an attribute of the MPI window.
+   *
+   * The window behaves like a window in the separate memory model of MPI. The MPI window does not expose the user
+   * buffer but a copy of it, the public copy, which has the layout of the modified buffer. The two copies are
+   * synchronized by AMPI_Win_fence:
+   *  - The elements that were written in the epoch are copied into the user buffer and get new identifiers.
+   *  - All elements of the user buffer are copied into the public copy.
+   * The accesses are recorded in the window with one mark per element, the epoch is encoded in the value of the mark.
+   * Passive target epochs become visible at the target at the next fence.
+   *
+   * AMPI_Accumulate sums the primal values in a separate part of the window, which holds the primal values of the
+   * elements at the start of the epoch. The public copy of the elements is combined with the bits of the origin
+   * buffers, so that the element is active if the old value or one of the summands is active. This requires that the
+   * identifiers of passive values have all bits zero.
+   *
+   * In one epoch, an element must only be accessed by one kind of operation, that is Put, Accumulate or Get.
+   *
+   * If the ranks of the window can share the memory of their node, see isWinSharedPossible, the memory is allocated
+   * with MPI_Win_allocate_shared on each node, see allocateWin. Put and get to the ranks on the same node copy the
+   * modified buffers directly from and to the memory of the target, the other ranks are accessed with MPI.
+   */
+  class WinData {
+    private:
+
+      const MpiTypeInterface* datatype;
+      void* base;
+      int count;
+      MPI_Comm comm;
+      MPI_Win win;
+
+      char* exposed;
+      MPI_Aint elementBytes;  ///< Size of an element in the public copy.
+      MPI_Aint primalBytes;
+      MPI_Aint sumOffset;
+      MPI_Aint markOffset;
+      MPI_Aint exposedBytes;
+      bool shared;
+      std::vector<char*> segments;  ///< Exposed memory of the ranks on the node if the window is shared.
+      MPI_Win sharedWin;  ///< Window of the shared memory on the node.
+
+      int epoch;
+      int lastAssert;
+      std::list<WinOriginOp> pending;
+      std::map<int, int> lockTypes;  ///< Lock type of the passive target epochs, required for the reverse of the unlock.
+      WinReverse* reverse;
+
+    public:
+
+      /**
+       * @brief The keyval of the attribute with the window data.
+       */
+      static int getKeyval() {
+        static int keyval = MPI_KEYVAL_INVALID;
+        if(MPI_KEYVAL_INVALID == keyval) {
+          MEDI_CHECK_ERROR(MPI_Win_create_keyval(MPI_WIN_NULL_COPY_FN, MPI_WIN_NULL_DELETE_FN, &keyval, nullptr));
+        }
+
+        return keyval;
+      }
+
+      /**
+       * @return The data of the window or nullptr if the window is not active.
+       */
+      static WinData* get(MPI_Win win) {
+        WinData* data = nullptr;
+        int flag = 0;
+        if(MPI_WIN_NULL != win) {
+          MPI_Win_get_attr(win, getKeyval(), &data, &flag);
+        }
+
+        return flag ? data : nullptr;
+      }
+
+      /**
+       * @brief Collective creation of an active window for the elements of the user buffer.
+       */
+      static int create(void* base, int count, const MpiTypeInterface* datatype, MPI_Info info, MPI_Comm comm,
+                        MPI_Win* win) {
+        WinData* data = new WinData(base, count, datatype, comm);
+
+        int rStatus = allocateWin(data->exposedBytes, 1, info, comm, data->shared, &data->exposed, data->segments,
+                                  &data->sharedWin, win);
+        data->win = *win;
+        MPI_Win_set_attr(*win, getKeyval(), data);
+
+        std::memset(data->exposed, 0, data->exposedBytes);
+        data->copyIntoExposed(0, count);
+        // passive target epochs of other ranks may start right after the creation
+        data->syncShared();
+        MPI_Barrier(comm);
+
+        const ADToolInterface& adTool = datatype->getADTool();
+        WinCreateHandle* h = nullptr;
+        if(adTool.isHandleRequired()) {
+          data->reverse = new WinReverse(getReverseComm(comm), data->computeActiveDisplacement(count),
+                                         adTool.getAdjointMpiType(), data->shared);
+          h = new (adTool.getHandleSlab()) WinCreateHandle(data->reverse);
+        }
+        adTool.startAssembly(h);
+        adTool.addToolAction(h);
+        adTool.stopAssembly(h);
+
+        return rStatus;
+      }
+
+      /**
+       * @brief Collective release of the window, performs a last synchronization.
+       */
+      int free(MPI_Win* win) {
+        syncShared();
+        MPI_Win_fence(MPI_MODE_NOSUCCEED, this->win);
+        syncShared();
+        synchronize(MPI_MODE_NOSUCCEED);
+
+        const ADToolInterface& adTool = datatype->getADTool();
+        WinFreeHandle* h = nullptr;
+        if(isRecording()) {
+          h = new (adTool.getHandleSlab()) WinFreeHandle(reverse);
+        }
+        adTool.startAssembly(h);
+        adTool.addToolAction(h);
+        adTool.stopAssembly(h);
+
+        int rStatus = freeWin(exposed, &sharedWin, win);
+        delete this;
+
+        return rStatus;
+      }
+
+      int fence(int assert) {
+        // always close with a barrier, since passive target epochs may have accessed the window
+        syncShared();
+        int rStatus = MPI_Win_fence(MPI_MODE_NOSUCCEED, win);
+        syncShared();
+        synchronize(assert);
+
+        // the public copy is updated, start the next epoch
+        syncShared();
+        if(0 != (assert & MPI_MODE_NOSUCCEED)) {
+          MPI_Barrier(comm);
+        } else {
+          MPI_Win_fence(MPI_MODE_NOPRECEDE, win);
+        }
+        syncShared();
+
+        return rStatus;
+      }
+
+      int lock(int lockType, int rank, int assert) {
+        int rStatus = MPI_Win_lock(lockType, rank, assert, win);
+        syncShared();
+
+        lockTypes[rank] = lockType;
+        recordLock(lockType, rank, true);
+
+        return rStatus;
+      }
+
+      int unlock(int rank) {
+        syncShared();
+        int rStatus = MPI_Win_unlock(rank, win);
+
+        finishPending(rank);
+        recordLock(lockTypes[rank], rank, false);
+        lockTypes.erase(rank);
+
+        return rStatus;
+      }
+
+      /**
+       * @brief Put or accumulate with MPI_SUM of the origin buffer into the target elements.
+       */
+      int put(WinAccess access, const void* buf, int count, const MpiTypeInterface* datatype, int rank, MPI_Aint disp) {
+        checkOrigin(datatype);
+
+        const ADToolInterface& adTool = datatype->getADTool();
+        WinPutHandle* h = nullptr;
+        if(isRecording()) {
+          h = new (adTool.getHandleSlab()) WinPutHandle(reverse, datatype);
+        }
+        adTool.startAssembly(h);
+
+        if(nullptr != h) {
+          h->count = datatype->computeActiveElements(count);
+          adTool.createIndexTypeBuffer(h->indices, h->count);
+          datatype->getIndices(buf, 0, h->indices, 0, count);
+
+          h->rank = rank;
+          h->disp = computeActiveDisplacement(disp);
+          h->epoch = epoch;
+        }
+
+        pending.push_back(WinOriginOp(access, datatype, nullptr, count, rank, disp, epoch));
+        WinOriginOp& op = pending.back();
+
+        const void* bufMod = buf;
+        if(datatype->isModifiedBufferRequired()) {
+          datatype->createModifiedTypeBuffer(op.bufMod, count);
+          datatype->copyIntoModifiedBuffer(buf, 0, op.bufMod, 0, count);
+          bufMod = op.bufMod;
+        }
+
+        int rStatus = MPI_SUCCESS;
+        if(WinAccess::Put == access && isDirect(rank)) {
+          std::memcpy(segments[rank] + disp * elementBytes, bufMod, count * elementBytes);
+        } else if(WinAccess::Put == access) {
+          rStatus = MPI_Put(bufMod, count, datatype->getModifiedMpiType(), rank, disp * elementBytes, count,
+                            this->datatype->getModifiedMpiType(), win);
+        } else {
+          int activeCount = datatype->computeActiveElements(count);
+          adTool.createPrimalTypeBuffer(op.primals, activeCount);
+          datatype->getValues(buf, 0, op.primals, 0, count);
+
+          rStatus = MPI_Accumulate(op.primals, activeCount, adTool.getPrimalMpiType(), rank,
+                                   sumOffset + computeActiveDisplacement(disp) * primalBytes,
+                                   activeCount, adTool.getPrimalMpiType(), MPI_SUM, win);
+          // combine the activity of the values
+          MPI_Accumulate(bufMod, (int)(count * elementBytes), MPI_BYTE, rank, disp * elementBytes,
+                         (int)(count * elementBytes), MPI_BYTE, MPI_BOR, win);
+        }
+        mark(op);
+
+        adTool.addToolAction(h);
+        adTool.stopAssembly(h);
+
+        return rStatus;
+      }
+
+      /**
+       * @brief Get the target elements into the origin buffer, the buffer is updated at the next synchronization.
+       */
+      int get(void* buf, int count, const MpiTypeInterface* datatype, int rank, MPI_Aint disp) {
+        checkOrigin(datatype);
+
+        pending.push_back(WinOriginOp(WinAccess::Get, datatype, buf, count, rank, disp, epoch));
+        WinOriginOp& op = pending.back();
+
+        datatype->createModifiedTypeBuffer(op.bufMod, count);
+        int rStatus = MPI_SUCCESS;
+        if(isDirect(rank)) {
+          std::memcpy(op.bufMod, segments[rank] + disp * elementBytes, count * elementBytes);
+        } else {
+          rStatus = MPI_Get(op.bufMod, count, datatype->getModifiedMpiType(), rank, disp * elementBytes, count,
+                            this->datatype->getModifiedMpiType(), win);
+        }
+        mark(op);
+
+        return rStatus;
+      }
+
+      /**
+       * @return True if the memory of the rank can be accessed directly.
+       */
+      bool isDirect(int rank) const {
+        return shared && MPI_PROC_NULL != rank && nullptr != segments[rank];
+      }
+
+    private:
+
+      WinData(void* base, int count, const MpiTypeInterface* datatype, MPI_Comm comm) :
+        datatype(datatype),
+        base(base),
+        count(count),
+        comm(comm),
+        win(MPI_WIN_NULL),
+        exposed(nullptr),
+        elementBytes(getExtent(datatype->getModifiedMpiType())),
+        primalBytes(getExtent(datatype->getADTool().getPrimalMpiType())),
+        sumOffset(0),
+        markOffset(0),
+        exposedBytes(0),
+        shared(isWinSharedPossible(comm)),
+        segments(),
+        sharedWin(MPI_WIN_NULL),
+        epoch(0),
+        lastAssert(MPI_MODE_NOSUCCEED),
+        pending(),
+        lockTypes(),
+        reverse(nullptr) {
+
+        // layout: [public copy][primal sums][marks], each part aligned to the largest member
+        sumOffset = alignOffset(count * elementBytes);
+        markOffset = alignOffset(sumOffset + computeActiveDisplacement(count) * primalBytes);
+        exposedBytes = markOffset + count * sizeof(int);
+      }
+
+      ~WinData() {
+        if(nullptr != reverse) {
+          reverse->release();
+        }
+      }
+
+      /**
+       * @brief Number of active elements in front of an element of the window.
+       *
+       * Computed without the int interface of computeActiveElements, so that large displacements are not truncated.
+       */
+      MPI_Aint computeActiveDisplacement(MPI_Aint disp) const {
+        return disp * datatype->computeActiveElements(1);
+      }
+
+      static MPI_Aint alignOffset(MPI_Aint offset) {
+        const MPI_Aint alignment = alignof(std::max_align_t);
+
+        return (offset + alignment - 1) / alignment * alignment;
+      }
+
+      /**
+       * @brief All synchronizations and operations of an active window need to be recorded, if its creation was.
+       */
+      bool isRecording() const {
+        bool recording = datatype->getADTool().isHandleRequired();
+        if(recording != (nullptr != reverse)) {
+          MEDI_EXCEPTION("The tape needs to record during the whole lifetime of an active window or not at all.");
+        }
+
+        return recording;
+      }
+
+      /**
+       * @brief Memory barrier for the direct accesses to the shared memory of the node.
+       */
+      void syncShared() {
+        if(shared) {
+          MPI_Win_sync(sharedWin);
+        }
+      }
+
+      void checkOrigin(const MpiTypeInterface* datatype) const {
+        if(!datatype->getADTool().isActiveType()) {
+          MEDI_EXCEPTION("The one sided operations on an active window require an active datatype.");
+        }
+        if(getExtent(datatype->getModifiedMpiType()) != elementBytes) {
+          MEDI_EXCEPTION("The datatype of the one sided operation has to match the datatype of the window.");
+        }
+      }
+
+      int* getMarks() {
+        return reinterpret_cast<int*>(exposed + markOffset);
+      }
+
+      void mark(WinOriginOp& op) {
+        op.marks.assign(op.count, 4 * op.epoch + (int)op.access);
+
+        MPI_Accumulate(op.marks.data(), op.count, MPI_INT, op.rank, markOffset + op.disp * (MPI_Aint)sizeof(int),
+                       op.count, MPI_INT, MPI_MAX, win);
+      }
+
+      /**
+       * @brief Copies the user buffer into the public copy, the sums start with the primal values of the elements.
+       */
+      void copyIntoExposed(int start, int length) {
+        if(datatype->isModifiedBufferRequired()) {
+          datatype->copyIntoModifiedBuffer(base, start, exposed, start, length);
+        } else {
+          std::memcpy(exposed + start * elementBytes, reinterpret_cast<char*>(base) + start * elementBytes,
+                      length * elementBytes);
+        }
+        datatype->getValues(base, start, exposed + sumOffset, start, length);
+      }
+
+      void copyFromExposed(int start, int length) {
+        if(datatype->isModifiedBufferRequired()) {
+          datatype->copyFromModifiedBuffer(base, start, exposed, start, length);
+        } else {
+          std::memcpy(reinterpret_cast<char*>(base) + start * elementBytes, exposed + start * elementBytes,
+                      length * elementBytes);
+        }
+      }
+
+      /**
+       * @brief Sets the sums of the accumulated elements in the public copy.
+       */
+      void accumulateIntoExposed(int start, int length) {
+        datatype->setModifiedValues(exposed, start, exposed + sumOffset, start, length);
+      }
+
+      /**
+       * @brief Complete the operations to the rank, all operations for MPI_ANY_SOURCE.
+       */
+      void finishPending(int rank) {
+        std::list<WinOriginOp>::iterator iter = pending.begin();
+        while(iter != pending.end()) {
+          if(MPI_ANY_SOURCE == rank || iter->rank == rank) {
+            finish(*iter);
+            iter = pending.erase(iter);
+          } else {
+            ++iter;
+          }
+        }
+      }
+
+      void finish(WinOriginOp& op) {
+        const ADToolInterface& adTool = op.datatype->getADTool();
+
+        if(WinAccess::Get == op.access) {
+          WinGetHandle* h = nullptr;
+          if(isRecording()) {
+            h = new (adTool.getHandleSlab()) WinGetHandle(reverse, op.datatype);
+          }
+          adTool.startAssembly(h);
+
+          if(nullptr != h) {
+            h->count = op.datatype->computeActiveElements(op.count);
+            adTool.createIndexTypeBuffer(h->indices, h->count);
+
+            if(isOldPrimalsRequired(op.datatype)) {
+              adTool.createPrimalTypeBuffer(h->oldPrimals, h->count);
+              op.datatype->getValues(op.buf, 0, h->oldPrimals, 0, op.count);
+            }
+
+            op.datatype->createIndices(op.buf, 0, h->indices, 0, op.count);
+
+            h->rank = op.rank;
+            h->disp = computeActiveDisplacement(op.disp);
+            h->epoch = op.epoch;
+          }
+
+          if(!op.datatype->isModifiedBufferRequired()) {
+            op.datatype->clearIndices(op.buf, 0, op.count);
+          }
+
+          adTool.addToolAction(h);
+
+          if(op.datatype->isModifiedBufferRequired()) {
+            op.datatype->copyFromModifiedBuffer(op.buf, 0, op.bufMod, 0, op.count);
+          } else {
+            std::memcpy(op.buf, op.bufMod, op.count * elementBytes);
+          }
+
+          if(nullptr != h) {
+            op.datatype->registerValue(op.buf, 0, h->indices, h->oldPrimals, 0, op.count);
+          }
+
+          adTool.stopAssembly(h);
+        }
+
+        if(nullptr != op.bufMod) {
+          op.datatype->deleteModifiedTypeBuffer(op.bufMod);
+        }
+        if(nullptr != op.primals) {
+          adTool.deletePrimalTypeBuffer(op.primals);
+        }
+      }
+
+      void recordLock(int lockType, int rank, bool isLock) {
+        const ADToolInterface& adTool = datatype->getADTool();
+        WinLockHandle* h = nullptr;
+        if(isRecording()) {
+          h = new (adTool.getHandleSlab()) WinLockHandle(reverse, lockType, rank, isLock);
+        }
+        adTool.startAssembly(h);
+        adTool.addToolAction(h);
+        adTool.stopAssembly(h);
+      }
+
+      /**
+       * @brief Closes the epoch and updates the user buffer and the public copy.
+       *
+       * The window is not accessed by other processes during the call.
+       */
+      void synchronize(int assert) {
+        finishPending(MPI_ANY_SOURCE);
+
+        const ADToolInterface& adTool = datatype->getADTool();
+        WinFenceHandle* h = nullptr;
+        if(isRecording()) {
+          h = new (adTool.getHandleSlab()) WinFenceHandle(reverse);
+          h->previousAssert = lastAssert;
+        }
+        adTool.startAssembly(h);
+
+        // extract the accesses of this epoch from the marks
+        std::vector<WinRun> runs;
+        int* marks = getMarks();
+        for(int i = 0; i < count; ++i) {
+          WinAccess access = WinAccess::None;
+          if(marks[i] > 4 * epoch) {
+            access = (WinAccess)(marks[i] - 4 * epoch);
+          }
+
+          if(!runs.empty() && runs.back().access == access && runs.back().start + runs.back().length == i) {
+            runs.back().length += 1;
+          } else if(WinAccess::None != access) {
+            runs.push_back(WinRun{access, i, 1});
+          }
+        }
+
+        int writtenElements = 0;
+        int readElements = 0;
+        for(const WinRun& run : runs) {
+          if(run.isWritten()) {
+            writtenElements += run.length;
+          }
+          if(run.isRead()) {
+            readElements += run.length;
+          }
+        }
+
+        if(nullptr != h) {
+          WinEpoch& e = h->epoch;
+          e.datatype = datatype;
+          e.epoch = epoch;
+          e.writtenCount = datatype->computeActiveElements(writtenElements);
+          e.readCount = datatype->computeActiveElements(readElements);
+          adTool.createIndexTypeBuffer(e.writtenIndices, e.writtenCount);
+          adTool.createIndexTypeBuffer(e.readIndices, e.readCount);
+          if(isOldPrimalsRequired(datatype)) {
+            adTool.createPrimalTypeBuffer(e.oldPrimals, e.writtenCount);
+          }
+
+          int writtenPos = 0;
+          int readPos = 0;
+          for(const WinRun& run : runs) {
+            if(run.isRead()) {
+              datatype->getIndices(base, run.start, e.readIndices, readPos, run.length);
+              readPos += run.length;
+            }
+            if(run.isWritten()) {
+              if(isOldPrimalsRequired(datatype)) {
+                datatype->getValues(base, run.start, e.oldPrimals, writtenPos, run.length);
+              }
+              datatype->createIndices(base, run.start, e.writtenIndices, writtenPos, run.length);
+              writtenPos += run.length;
+            }
+          }
+        }
+
+        adTool.addToolAction(h);
+
+        // copy the written elements into the user buffer
+        int writtenPos = 0;
+        for(const WinRun& run : runs) {
+          if(run.isWritten()) {
+            if(WinAccess::Accumulate == run.access) {
+              accumulateIntoExposed(run.start, run.length);
+            }
+
+            if(!datatype->isModifiedBufferRequired()) {
+              datatype->clearIndices(base, run.start, run.length);
+            }
+            copyFromExposed(run.start, run.length);
+
+            if(nullptr != h) {
+              datatype->registerValue(base, run.start, h->epoch.writtenIndices, h->epoch.oldPrimals, writtenPos,
+                                      run.length);
+            }
+            writtenPos += run.length;
+          }
+        }
+
+        if(nullptr != h) {
+          h->epoch.runs.swap(runs);
+        }
+        adTool.stopAssembly(h);
+
+        // local stores and the new values are visible in the next epoch
+        copyIntoExposed(0, count);
+
+        lastAssert = assert;
+        epoch += 1;
+      }
+  };
+
+  /**
+   * @brief Checks if put and get to a rank of an active window access the shared memory of the node directly.
+   *
+   * @param[in]  win  The window.
+   * @param[in] rank  The target rank in the communicator of the window.
+   * @return True if the memory of the rank is accessed directly, false for windows without AD handling.
+   */
+  inline bool isWinTargetDirect(AMPI_Win win, int rank) {
+    WinData* data = WinData::get(win);
+
+    return nullptr != data && data->isDirect(rank);
+  }
+
+  /**
+   * @brief Creates a window without AD handling, see MPI_Win_create.
+   */
+  inline int AMPI_Win_create(void* base, AMPI_Aint size, int disp_unit, AMPI_Info info, AMPI_Comm comm, AMPI_Win* win) {
+    return MPI_Win_create(base, size, disp_unit, info, comm, win);
+  }
+
+  /**
+   * @brief Creates a window for the elements of an AD type, see WinData for the semantics.
+   *
+   * The displacement unit has to be the extent of the datatype. For passive datatypes, a regular window is created.
+   *
+   * @param[in]      base  The user buffer.
+   * @param[in]      size  Size of the user buffer in bytes.
+   * @param[in] disp_unit  The extent of the datatype.
+   * @param[in]  datatype  The datatype of the elements in the window.
+   * @param[in]      info  See MPI_Win_create.
+   * @param[in]      comm  See MPI_Win_create.
+   * @param[out]      win  The created window.
+   */
+  template<typename DATATYPE>
+  inline int AMPI_Win_create(typename DATATYPE::Type* base, AMPI_Aint size, int disp_unit, DATATYPE* datatype,
+                             AMPI_Info info, AMPI_Comm comm, AMPI_Win* win) {
+    if(!isActiveType(datatype)) {
+      return MPI_Win_create(base, size, disp_unit, info, comm, win);
+    }
+
+    if(getExtent(datatype->getMpiType()) != disp_unit) {
+      MEDI_EXCEPTION("The displacement unit of an active window has to be the extent of the datatype.");
+    }
+
+    // the datatype interface counts the elements of a buffer with int
+    if(size / disp_unit > (AMPI_Aint)INT_MAX) {
+      MEDI_EXCEPTION("The number of elements of an active window has to fit into an int.");
+    }
+
+    return WinData::create(base, (int)(size / disp_unit), datatype, info, comm, win);
+  }
+
+  inline int AMPI_Win_free(AMPI_Win* win) {
+    WinData* data = WinData::get(*win);
+    if(nullptr == data) {
+      return MPI_Win_free(win);
+    }
+
+    return data->free(win);
+  }
+
+  inline int AMPI_Win_fence(int assert, AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Win_fence(assert, win);
+    }
+
+    return data->fence(assert);
+  }
+
+  inline int AMPI_Win_lock(int lock_type, int rank, int assert, AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Win_lock(lock_type, rank, assert, win);
+    }
+
+    return data->lock(lock_type, rank, assert);
+  }
+
+  inline int AMPI_Win_unlock(int rank, AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Win_unlock(rank, win);
+    }
+
+    return data->unlock(rank);
+  }
+
+  /**
+   * @brief Checks the arguments of a one sided operation on an active window.
+   */
+  template<typename ORIGINTYPE, typename TARGETTYPE>
+  inline void checkWinArguments(int origin_count, ORIGINTYPE* origin_datatype, int target_count,
+                                TARGETTYPE* target_datatype) {
+    if(!isActiveType(origin_datatype) || !isActiveType(target_datatype)) {
+      MEDI_EXCEPTION("The one sided operations on an active window require active datatypes.");
+    }
+    if(origin_count != target_count) {
+      MEDI_EXCEPTION("The origin and target counts of a one sided operation on an active window have to be equal.");
+    }
+  }
+
+  template<typename ORIGINTYPE, typename TARGETTYPE>
+  inline int AMPI_Put(const typename ORIGINTYPE::Type* origin_addr, int origin_count, ORIGINTYPE* origin_datatype,
+                      int target_rank, AMPI_Aint target_disp, int target_count, TARGETTYPE* target_datatype,
+                      AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Put(origin_addr, origin_count, origin_datatype->getMpiType(), target_rank, target_disp, target_count,
+                     target_datatype->getMpiType(), win);
+    }
+
+    checkWinArguments(origin_count, origin_datatype, target_count, target_datatype);
+    return data->put(WinAccess::Put, origin_addr, origin_count, origin_datatype, target_rank, target_disp);
+  }
+
+  template<typename ORIGINTYPE, typename TARGETTYPE>
+  inline int AMPI_Get(typename ORIGINTYPE::Type* origin_addr, int origin_count, ORIGINTYPE* origin_datatype,
+                      int target_rank, AMPI_Aint target_disp, int target_count, TARGETTYPE* target_datatype,
+                      AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Get(origin_addr, origin_count, origin_datatype->getMpiType(), target_rank, target_disp, target_count,
+                     target_datatype->getMpiType(), win);
+    }
+
+    checkWinArguments(origin_count, origin_datatype, target_count, target_datatype);
+    return data->get(origin_addr, origin_count, origin_datatype, target_rank, target_disp);
+  }
+
+  /**
+   * @brief Accumulate on a window.
+   *
+   * On active windows only MPI_SUM and MPI_REPLACE are supported. The primal mpi type of the AD tool needs to consist
+   * of one predefined type, since the primal values are summed by MPI.
+   */
+  template<typename ORIGINTYPE, typename TARGETTYPE>
+  inline int AMPI_Accumulate(const typename ORIGINTYPE::Type* origin_addr, int origin_count,
+                             ORIGINTYPE* origin_datatype, int target_rank, AMPI_Aint target_disp, int target_count,
+                             TARGETTYPE* target_datatype, AMPI_Op op, AMPI_Win win) {
+    WinData* data = WinData::get(win);
+    if(nullptr == data) {
+      return MPI_Accumulate(origin_addr, origin_count, origin_datatype->getMpiType(), target_rank, target_disp,
+                            target_count, target_datatype->getMpiType(), op.primalFunction, win);
+    }
+
+    checkWinArguments(origin_count, origin_datatype, target_count, target_datatype);
+    if(MPI_SUM == op.primalFunction) {
+      return data->put(WinAccess::Accumulate, origin_addr, origin_count, origin_datatype, target_rank, target_disp);
+    } else if(MPI_REPLACE == op.primalFunction) {
+      return data->put(WinAccess::Put, origin_addr, origin_count, origin_datatype, target_rank, target_disp);
+    } else {
+      MEDI_EXCEPTION("Only MPI_SUM and MPI_REPLACE are supported for AMPI_Accumulate on active windows.");
+
+      return MPI_ERR_OP;
+    }
+  }
+#endif
+}
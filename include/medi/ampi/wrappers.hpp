@@ -31,10 +31,25 @@
 #include "async.hpp"
 #include "ampiMisc.h"
 #include "inPlace.hpp"
+#include "reverseAggregation.hpp"
+#include "reverseComm.hpp"
+#include "typeTraits.hpp"
+#include "../displacementTools.hpp"
 #include "../mpiTools.h"
 
 #include "../../../generated/medi/ampiDefinitions.h"
 
+#ifndef MEDI_TreeReduceTag
+  /**
+   * @brief The tag for the point to point messages of the tree reductions.
+   *
+   * The messages are sent on the duplicate from createInternalComm, so the tag can not clash with user messages.
+   *
+   * It can be set with the preprocessor macro MEDI_TreeReduceTag=<tag>
+   */
+  #define MEDI_TreeReduceTag 32767
+#endif
+
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
  */
@@ -71,6 +86,22 @@ namespace medi {
   }
 #endif
 
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+
+  template<typename DATATYPE>
+  int AMPI_Bcast_init_wrap(typename DATATYPE::Type* bufferSend, typename DATATYPE::Type* bufferRecv, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request);
+
+  template<typename DATATYPE>
+  inline int AMPI_Bcast_init(typename DATATYPE::Type* buffer, int count, DATATYPE* datatype, int root, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    return AMPI_Bcast_init_wrap<DATATYPE>(AMPI_IN_PLACE, buffer, count, datatype, root, comm, info, request);
+  }
+
+  inline int MPI_Bcast_init_wrap(void* bufferSend, void* bufferRecv, int count, MPI_Datatype type, int root, MPI_Comm comm, MPI_Info info, MPI_Request* request) {
+    MEDI_UNUSED(bufferSend);
+    return MPI_Bcast_init(bufferRecv, count, type, root, comm, info, request);
+  }
+#endif
+
   template<typename DATATYPE>
   struct AMPI_Ireduce_local_Handle : public AsyncHandle {
       AMPI_Comm comm;
@@ -86,6 +117,14 @@ namespace medi {
       int reduceSize;
   };
 
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  struct AMPI_Allreduce_init_local_Handle : public AMPI_Ireduce_local_Handle<DATATYPE> {
+      ContinueFunction origStart;
+      ContinueFunction origEnd;
+  };
+#endif
+
   template<typename DATATYPE>
   int AMPI_Reduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm);
   template<typename SENDTYPE, typename RECVTYPE>
@@ -102,6 +141,27 @@ namespace medi {
   int AMPI_Iallreduce_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request);
   template<typename SENDTYPE, typename RECVTYPE>
   int AMPI_Iallgather(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Request* request);
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm);
+  template<typename DATATYPE>
+  int AMPI_Reduce_scatter_block_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm);
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request);
+  template<typename DATATYPE>
+  int AMPI_Ireduce_scatter_block_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request);
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Allgather_init(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request);
+  template<typename DATATYPE>
+  int AMPI_Allreduce_init_global(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request);
+#endif
+
+  template<typename DATATYPE>
+  int AMPI_Send(MEDI_OPTIONAL_CONST typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int dest, int tag, AMPI_Comm comm);
+  template<typename DATATYPE>
+  int AMPI_Recv(typename DATATYPE::Type* buf, int count, DATATYPE* datatype, int source, int tag, AMPI_Comm comm, AMPI_Status* status);
+  template<typename SENDTYPE, typename RECVTYPE>
+  int AMPI_Sendrecv(MEDI_OPTIONAL_CONST typename SENDTYPE::Type* sendbuf, int sendcount, SENDTYPE* sendtype, int dest, int sendtag, typename RECVTYPE::Type* recvbuf, int recvcount, RECVTYPE* recvtype, int source, int recvtag, AMPI_Comm comm, AMPI_Status* status);
 
   template<typename DATATYPE>
   inline void performReduce(typename DATATYPE::Type* tempbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, int reduceSize) {
@@ -143,6 +203,137 @@ namespace medi {
     return rValue;
   }
 
+  /**
+   * @brief Checks if the reduction with the operator can be evaluated with TreeAndPerformOperationLocal.
+   *
+   * The tree changes the order in which the values are combined, therefore only commutative operators are supported.
+   *
+   * @param[in]     op  The operator as given by the user.
+   * @param[in] convOp  The operator converted by the AD tool.
+   *
+   * @return true if the tree reduction is selected and possible.
+   */
+  inline bool isTreeReduce(AMPI_Op const& op, AMPI_Op const& convOp) {
+    int commute = 0;
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+    if(LocalReduceAlgorithm::Tree == getLocalReduceAlgorithm(op)) {
+      MPI_Op_commutative(convOp.primalFunction, &commute);
+    }
+#else
+    MEDI_UNUSED(op);
+    MEDI_UNUSED(convOp);
+#endif
+
+    return 0 != commute;
+  }
+
+  /**
+   * @brief Reduction with point to point messages of the AD types and local evaluations of the operator.
+   *
+   * The AD tool records each message and each evaluation of the operator. For a root a binomial tree is used, for
+   * root == -1 (Allreduce) the values are combined with recursive doubling. The operator needs to be commutative.
+   */
+  template<typename DATATYPE>
+  inline int TreeAndPerformOperationLocal(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
+    int commSize = getCommSize(comm);
+    int commRank = getCommRank(comm);
+
+    // the messages of the tree are sent on a duplicate, they can not be matched with the messages of the user
+    MPI_Comm treeComm = getReverseComm(comm);
+    createInternalComm(treeComm);
+    treeComm = getInternalComm(treeComm);
+
+    typename DATATYPE::Type* accbuf = NULL;
+    typename DATATYPE::Type* tempbuf = NULL;
+    if(-1 == root || root == commRank) {
+      // accumulate directly in the receive buffer
+      accbuf = recvbuf;
+      if(AMPI_IN_PLACE != sendbuf) {
+        datatype->copy(const_cast<typename DATATYPE::Type*>(sendbuf), 0, accbuf, 0, count);
+      }
+    }
+
+    int rValue = MPI_SUCCESS;
+    if(-1 == root) {
+      if(1 != commSize) {
+        datatype->createTypeBuffer(tempbuf, count);
+      }
+
+      // fold the ranks above the largest power of two into their neighbours
+      int pof2 = 1;
+      while(pof2 * 2 <= commSize) {
+        pof2 *= 2;
+      }
+      int rem = commSize - pof2;
+
+      int newRank = commRank - rem;
+      if(commRank < 2 * rem) {
+        if(0 == commRank % 2) {
+          rValue = AMPI_Send<DATATYPE>(accbuf, count, datatype, commRank + 1, MEDI_TreeReduceTag, treeComm);
+          newRank = -1;
+        } else {
+          rValue = AMPI_Recv<DATATYPE>(tempbuf, count, datatype, commRank - 1, MEDI_TreeReduceTag, treeComm, AMPI_STATUS_IGNORE);
+          MPI_Reduce_local(tempbuf, accbuf, count, datatype->getMpiType(), op.primalFunction);
+          newRank = commRank / 2;
+        }
+      }
+
+      if(-1 != newRank) {
+        for(int mask = 1; mask < pof2; mask <<= 1) {
+          int newPartner = newRank ^ mask;
+          int partner = newPartner < rem ? newPartner * 2 + 1 : newPartner + rem;
+
+          rValue = AMPI_Sendrecv<DATATYPE, DATATYPE>(accbuf, count, datatype, partner, MEDI_TreeReduceTag, tempbuf, count, datatype, partner, MEDI_TreeReduceTag, treeComm, AMPI_STATUS_IGNORE);
+          MPI_Reduce_local(tempbuf, accbuf, count, datatype->getMpiType(), op.primalFunction);
+        }
+      }
+
+      if(commRank < 2 * rem) {
+        if(0 == commRank % 2) {
+          rValue = AMPI_Recv<DATATYPE>(accbuf, count, datatype, commRank + 1, MEDI_TreeReduceTag, treeComm, AMPI_STATUS_IGNORE);
+        } else {
+          rValue = AMPI_Send<DATATYPE>(accbuf, count, datatype, commRank - 1, MEDI_TreeReduceTag, treeComm);
+        }
+      }
+    } else {
+      int relRank = (commRank - root + commSize) % commSize;
+
+      MEDI_OPTIONAL_CONST typename DATATYPE::Type* curbuf = sendbuf;
+      if(NULL != accbuf) {
+        curbuf = accbuf;
+      }
+
+      for(int mask = 1; mask < commSize; mask <<= 1) {
+        if(0 != (relRank & mask)) {
+          rValue = AMPI_Send<DATATYPE>(curbuf, count, datatype, (relRank - mask + root) % commSize, MEDI_TreeReduceTag, treeComm);
+          break;
+        } else if(relRank + mask < commSize) {
+          if(NULL == tempbuf) {
+            datatype->createTypeBuffer(tempbuf, count);
+            if(NULL == accbuf) {
+              datatype->createTypeBuffer(accbuf, count);
+              datatype->copy(const_cast<typename DATATYPE::Type*>(sendbuf), 0, accbuf, 0, count);
+              curbuf = accbuf;
+            }
+          }
+
+          rValue = AMPI_Recv<DATATYPE>(tempbuf, count, datatype, (relRank + mask + root) % commSize, MEDI_TreeReduceTag, treeComm, AMPI_STATUS_IGNORE);
+          MPI_Reduce_local(tempbuf, accbuf, count, datatype->getMpiType(), op.primalFunction);
+        }
+      }
+
+      if(root != commRank && NULL != accbuf) {
+        datatype->deleteTypeBuffer(accbuf, count);
+      }
+    }
+
+    if(NULL != tempbuf) {
+      datatype->deleteTypeBuffer(tempbuf, count);
+    }
+
+    return rValue;
+  }
+
   template<typename DATATYPE>
   inline int IgatherAndPerformOperationLocal_finish(HandleBase* handle) {
 
@@ -205,6 +396,80 @@ namespace medi {
     return rValue;
   }
 
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  inline int AllgatherAndPerformOperationLocal_init_start(HandleBase* handle) {
+    AMPI_Allreduce_init_local_Handle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_local_Handle<DATATYPE>*>(handle);
+
+    return h->origStart(h->origHandle);
+  }
+
+  template<typename DATATYPE>
+  inline int AllgatherAndPerformOperationLocal_init_finish(HandleBase* handle) {
+    AMPI_Allreduce_init_local_Handle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_local_Handle<DATATYPE>*>(handle);
+    // first call the orignal function
+    h->origFunc(h->origHandle);
+
+    performReduce<DATATYPE>(h->tempbuf, h->recvbuf, h->count, h->datatype, h->op, h->root, h->comm, h->reduceSize);
+
+    return 0;
+  }
+
+  template<typename DATATYPE>
+  inline int AllgatherAndPerformOperationLocal_init_end(HandleBase* handle) {
+    AMPI_Allreduce_init_local_Handle<DATATYPE>* h = static_cast<AMPI_Allreduce_init_local_Handle<DATATYPE>*>(handle);
+    h->origEnd(h->origHandle);
+
+    h->datatype->deleteTypeBuffer(h->tempbuf, h->count * getCommSize(h->comm));
+
+    delete h;
+
+    return 0;
+  }
+
+  /**
+   * @brief Persistent version of IgatherAndPerformOperationLocal for root == -1.
+   *
+   * The gather is a persistent Allgather into a temporary buffer which lives as long as the request. The operator is
+   * evaluated locally each time the request is completed.
+   */
+  template<typename DATATYPE>
+  inline int AllgatherAndPerformOperationLocal_init(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    typename DATATYPE::Type* tempbuf = NULL;
+    datatype->createTypeBuffer(tempbuf, count * getCommSize(comm));
+
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufGather = sendbuf;
+    if(AMPI_IN_PLACE == sendbuf) {
+      sendbufGather = recvbuf;
+    }
+
+    int rValue = AMPI_Allgather_init<DATATYPE, DATATYPE>(sendbufGather, count, datatype, tempbuf, count, datatype, comm, info, request);
+
+    AMPI_Allreduce_init_local_Handle<DATATYPE>* curHandle = new AMPI_Allreduce_init_local_Handle<DATATYPE>();
+    curHandle->comm = comm;
+    curHandle->root = -1;
+    curHandle->count = count;
+    curHandle->op = op;
+    curHandle->datatype = datatype;
+    curHandle->recvbuf = recvbuf;
+    curHandle->tempbuf = tempbuf;
+    curHandle->origHandle = request->handle;
+    curHandle->origFunc = request->func;
+    curHandle->origStart = request->start;
+    curHandle->origEnd = request->end;
+    curHandle->reduceSize = getCommSize(comm);
+    curHandle->toolHandle = request->handle->toolHandle;
+
+    // set our own handle now to the request
+    request->handle = curHandle;
+    request->func = (ContinueFunction)AllgatherAndPerformOperationLocal_init_finish<DATATYPE>;
+    request->start = (ContinueFunction)AllgatherAndPerformOperationLocal_init_start<DATATYPE>;
+    request->end = (ContinueFunction)AllgatherAndPerformOperationLocal_init_end<DATATYPE>;
+
+    return rValue;
+  }
+#endif
+
   template<typename DATATYPE>
   struct AMPI_Ireduce_modified_Handle : public AsyncHandle {
       typename DATATYPE::Type* tempBuf;
@@ -237,8 +502,8 @@ namespace medi {
   inline int AMPI_Reduce(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
-      return AMPI_Reduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, root, comm);
+    if(!isActiveType(datatype)) {
+      return AMPI_Reduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, root, comm);
     } else if(convOp.hasAdjoint) {
       // operator has an adjoint formulation
       if(convOp.requiresPrimalSend) {
@@ -247,7 +512,7 @@ namespace medi {
         if(root != getCommRank(comm)) {
           datatype->createTypeBuffer(tempBuf, count);
         }
-        int result = AMPI_Allreduce_global<DATATYPE>(sendbuf, tempBuf, count, datatype, convOp, comm);
+        int result = AMPI_Allreduce_global<DATATYPE>(sendbuf, tempBuf, count, datatype, op, comm);
         if(root != getCommRank(comm)) {
           datatype->deleteTypeBuffer(tempBuf, count);
         }
@@ -255,11 +520,16 @@ namespace medi {
         return result;
       } else {
         // just perfrom the normal call
-        return AMPI_Reduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, root, comm);
+        return AMPI_Reduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, root, comm);
       }
     } else {
-      // perform a gather and apply the operator locally
-      return GatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, root, comm, getCommSize(comm));
+      if(isTreeReduce(op, convOp)) {
+        // combine the values in a binomial tree
+        return TreeAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, root, comm);
+      } else {
+        // perform a gather and apply the operator locally
+        return GatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, root, comm, getCommSize(comm));
+      }
     }
   }
 
@@ -267,8 +537,8 @@ namespace medi {
   inline int AMPI_Ireduce(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, int root, AMPI_Comm comm, AMPI_Request* request) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
-      return AMPI_Ireduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, root, comm, request);
+    if(!isActiveType(datatype)) {
+      return AMPI_Ireduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, root, comm, request);
     } else if(convOp.hasAdjoint) {
       if(convOp.requiresPrimalSend) {
         // need to modify the call to an allreduce
@@ -276,7 +546,7 @@ namespace medi {
         if(root != getCommRank(comm)) {
           datatype->createTypeBuffer(tempBuf, count);
         }
-        int result = AMPI_Iallreduce_global<DATATYPE>(sendbuf, tempBuf, count, datatype, convOp, comm, request);
+        int result = AMPI_Iallreduce_global<DATATYPE>(sendbuf, tempBuf, count, datatype, op, comm, request);
         AMPI_Ireduce_modified_Handle<DATATYPE>* curHandle = new AMPI_Ireduce_modified_Handle<DATATYPE>();
         curHandle->tempBuf = tempBuf;
         curHandle->comm = comm;
@@ -294,7 +564,7 @@ namespace medi {
         return result;
       } else {
         // just perfrom the normal call
-        return AMPI_Ireduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, root, comm, request);
+        return AMPI_Ireduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, root, comm, request);
       }
     } else {
       // perform a gather and apply the operator locally
@@ -306,8 +576,11 @@ namespace medi {
   inline int AMPI_Allreduce(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(convOp.hasAdjoint || !datatype->getADTool().isActiveType()) {
-      return AMPI_Allreduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, comm);
+    if(convOp.hasAdjoint || !isActiveType(datatype)) {
+      return AMPI_Allreduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, comm);
+    } else if(isTreeReduce(op, convOp)) {
+      // combine the values with recursive doubling
+      return TreeAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, -1, comm);
     } else {
       // perform a gather and apply the operator locally
       return GatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, -1, comm, getCommSize(comm));
@@ -318,19 +591,182 @@ namespace medi {
   inline int AMPI_Iallreduce(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(convOp.hasAdjoint || !datatype->getADTool().isActiveType()) {
-      return AMPI_Iallreduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, convOp, comm, request);
+    if(convOp.hasAdjoint || !isActiveType(datatype)) {
+      return AMPI_Iallreduce_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, comm, request);
     } else {
       // perform a gather and apply the operator locally
       return IgatherAndPerformOperationLocal(sendbuf, recvbuf, count, datatype, convOp, -1, comm, request, getCommSize(comm));
     }
   }
 
+  template<typename DATATYPE>
+  struct AMPI_Ireduce_scatter_local_Handle : public AsyncHandle {
+      DATATYPE* datatype;
+      typename DATATYPE::Type* recvbuf;
+      typename DATATYPE::Type* tempbuf;
+      int totalCount;
+      int offset;
+      int count;
+
+      HandleBase* origHandle;
+      ContinueFunction origFunc;
+  };
+
+  /**
+   * @brief Checks if a reduce scatter can be recorded with the adjoint handling of the operator.
+   *
+   * The reverse of the reduce scatter is an allgather of the adjoint blocks. This rank has then only the primal
+   * results of its own block, therefore operators that require the primal values need the full result.
+   *
+   * @param[in] convOp  The operator converted by the AD tool.
+   *
+   * @return true if the operator has an adjoint that does not require the primal values.
+   */
+  inline bool isReduceScatterGlobal(AMPI_Op const& convOp) {
+    return convOp.hasAdjoint && !convOp.requiresPrimal;
+  }
+
+  /**
+   * @brief Reduce scatter for operators which need the full result in the reverse sweep.
+   *
+   * All blocks are reduced with AMPI_Allreduce, which uses the adjoint of the operator or the local gather path.
+   * Afterwards the block of this rank is copied into the receive buffer.
+   */
+  template<typename DATATYPE>
+  inline int AllreduceAndCopyLocal(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int totalCount, int offset, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    typename DATATYPE::Type* tempbuf = NULL;
+    datatype->createTypeBuffer(tempbuf, totalCount);
+
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufReduce = sendbuf;
+    if(AMPI_IN_PLACE == sendbuf) {
+      sendbufReduce = recvbuf;
+    }
+
+    int rValue = AMPI_Allreduce<DATATYPE>(sendbufReduce, tempbuf, totalCount, datatype, op, comm);
+
+    datatype->copy(tempbuf, offset, recvbuf, 0, count);
+    datatype->deleteTypeBuffer(tempbuf, totalCount);
+
+    return rValue;
+  }
+
+  template<typename DATATYPE>
+  inline int IallreduceAndCopyLocal_finish(HandleBase* handle) {
+
+    AMPI_Ireduce_scatter_local_Handle<DATATYPE>* h = static_cast<AMPI_Ireduce_scatter_local_Handle<DATATYPE>*>(handle);
+    // first call the orignal function
+    h->origFunc(h->origHandle);
+
+    h->datatype->copy(h->tempbuf, h->offset, h->recvbuf, 0, h->count);
+    h->datatype->deleteTypeBuffer(h->tempbuf, h->totalCount);
+
+    delete h;
+
+    return 0;
+  }
+
+  /**
+   * @brief Nonblocking version of AllreduceAndCopyLocal. The block is copied when the request is completed.
+   */
+  template<typename DATATYPE>
+  inline int IallreduceAndCopyLocal(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int totalCount, int offset, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    typename DATATYPE::Type* tempbuf = NULL;
+    datatype->createTypeBuffer(tempbuf, totalCount);
+
+    MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbufReduce = sendbuf;
+    if(AMPI_IN_PLACE == sendbuf) {
+      sendbufReduce = recvbuf;
+    }
+
+    int rValue = AMPI_Iallreduce<DATATYPE>(sendbufReduce, tempbuf, totalCount, datatype, op, comm, request);
+
+    AMPI_Ireduce_scatter_local_Handle<DATATYPE>* curHandle = new AMPI_Ireduce_scatter_local_Handle<DATATYPE>();
+    curHandle->datatype = datatype;
+    curHandle->recvbuf = recvbuf;
+    curHandle->tempbuf = tempbuf;
+    curHandle->totalCount = totalCount;
+    curHandle->offset = offset;
+    curHandle->count = count;
+    curHandle->origHandle = request->handle;
+    curHandle->origFunc = request->func;
+    curHandle->toolHandle = request->handle->toolHandle;
+
+    // set our own handle now to the request
+    request->handle = curHandle;
+    request->func = (ContinueFunction)IallreduceAndCopyLocal_finish<DATATYPE>;
+
+    return rValue;
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Reduce_scatter(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(!isActiveType(datatype) || (isReduceScatterGlobal(convOp) && AMPI_IN_PLACE != sendbuf)) {
+      return AMPI_Reduce_scatter_global<DATATYPE>(sendbuf, recvbuf, recvcounts, datatype, op, comm);
+    } else {
+      // reduce all blocks and extract the block of this rank
+      int commRank = getCommRank(comm);
+      return AllreduceAndCopyLocal(sendbuf, recvbuf, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)), computeDisplacementsTotalSize(recvcounts, commRank), recvcounts[commRank], datatype, op, comm);
+    }
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Ireduce_scatter(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, const int* recvcounts, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(!isActiveType(datatype) || (isReduceScatterGlobal(convOp) && AMPI_IN_PLACE != sendbuf)) {
+      return AMPI_Ireduce_scatter_global<DATATYPE>(sendbuf, recvbuf, recvcounts, datatype, op, comm, request);
+    } else {
+      // reduce all blocks and extract the block of this rank
+      int commRank = getCommRank(comm);
+      return IallreduceAndCopyLocal(sendbuf, recvbuf, computeDisplacementsTotalSize(recvcounts, getCommSize(comm)), computeDisplacementsTotalSize(recvcounts, commRank), recvcounts[commRank], datatype, op, comm, request);
+    }
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Reduce_scatter_block(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(!isActiveType(datatype) || (isReduceScatterGlobal(convOp) && AMPI_IN_PLACE != sendbuf)) {
+      return AMPI_Reduce_scatter_block_global<DATATYPE>(sendbuf, recvbuf, recvcount, datatype, op, comm);
+    } else {
+      // reduce all blocks and extract the block of this rank
+      return AllreduceAndCopyLocal(sendbuf, recvbuf, recvcount * getCommSize(comm), recvcount * getCommRank(comm), recvcount, datatype, op, comm);
+    }
+  }
+
+  template<typename DATATYPE>
+  inline int AMPI_Ireduce_scatter_block(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int recvcount, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(!isActiveType(datatype) || (isReduceScatterGlobal(convOp) && AMPI_IN_PLACE != sendbuf)) {
+      return AMPI_Ireduce_scatter_block_global<DATATYPE>(sendbuf, recvbuf, recvcount, datatype, op, comm, request);
+    } else {
+      // reduce all blocks and extract the block of this rank
+      return IallreduceAndCopyLocal(sendbuf, recvbuf, recvcount * getCommSize(comm), recvcount * getCommRank(comm), recvcount, datatype, op, comm, request);
+    }
+  }
+
+#if MEDI_MPI_VERSION_4_0 <= MEDI_MPI_TARGET
+  template<typename DATATYPE>
+  inline int AMPI_Allreduce_init(MEDI_OPTIONAL_CONST typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Info info, AMPI_Request* request) {
+    AMPI_Op convOp = datatype->getADTool().convertOperator(op);
+
+    if(convOp.hasAdjoint || !isActiveType(datatype)) {
+      return AMPI_Allreduce_init_global<DATATYPE>(sendbuf, recvbuf, count, datatype, op, comm, info, request);
+    } else {
+      // perform a gather and apply the operator locally
+      return AllgatherAndPerformOperationLocal_init(sendbuf, recvbuf, count, datatype, convOp, comm, info, request);
+    }
+  }
+#endif
+
   template<typename DATATYPE>
   inline int AMPI_Exscan(const typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       return MPI_Exscan(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm);
     } else {
       // perform a gather and apply the operator locally
@@ -342,7 +778,7 @@ namespace medi {
   inline int AMPI_Iexscan(const typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       return MPI_Iexscan(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm, &request->request);
     } else {
       // perform a gather and apply the operator locally
@@ -354,7 +790,7 @@ namespace medi {
   inline int AMPI_Scan(const typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       return MPI_Scan(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm);
     } else {
       // perform a gather and apply the operator locally
@@ -366,7 +802,7 @@ namespace medi {
   inline int AMPI_Iscan(const typename DATATYPE::Type* sendbuf, typename DATATYPE::Type* recvbuf, int count, DATATYPE* datatype, AMPI_Op op, AMPI_Comm comm, AMPI_Request* request) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
 
-    if(!datatype->getADTool().isActiveType()) {
+    if(!isActiveType(datatype)) {
       return MPI_Iscan(sendbuf, recvbuf, count, datatype->getMpiType(), convOp.primalFunction, comm, &request->request);
     } else {
       // perform a gather and apply the operator locally
@@ -377,6 +813,7 @@ namespace medi {
   inline void AMPI_Init_common() {
     initTypes();
     initializeOperators();
+    createReverseComm(MPI_COMM_WORLD);
   }
 
 
@@ -396,6 +833,13 @@ namespace medi {
     return result;
   }
 
+  inline int AMPI_Finalize() {
+    ReverseAggregation::global().finalize();
+    freeReverseComms();
+
+    return MPI_Finalize();
+  }
+
   template<typename DATATYPE>
   inline int AMPI_Reduce_local(MEDI_OPTIONAL_CONST typename DATATYPE::Type* inbuf, typename DATATYPE::Type* inoutbuf, int count, DATATYPE* datatype, AMPI_Comm comm, AMPI_Op op) {
     AMPI_Op convOp = datatype->getADTool().convertOperator(op);
@@ -0,0 +1,440 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "macros.h"
+#include "exceptions.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Defines how the memory of a BufferArena is managed.
+   */
+  enum class BufferArenaMode {
+    Recycle,      ///< Each block is allocated separately. Returned blocks are cached until release() is called.
+    TapeLifetime  ///< Blocks are cut from large chunks. All chunks are freed in bulk with reset().
+  };
+
+  /**
+   * @brief Statistics of a BufferArena.
+   *
+   * All byte values count the payload of the blocks, that is the size of the size class and not the requested size.
+   */
+  struct BufferArenaStats {
+      size_t allocations;       ///< Number of allocations.
+      size_t hits;              ///< Number of allocations that were served from a cached block.
+      size_t bytesInUse;        ///< Bytes that are currently handed out.
+      size_t peakBytesInUse;    ///< Maximum of bytesInUse.
+      size_t bytesReserved;     ///< Bytes that are currently allocated from the system.
+      size_t peakBytesReserved; ///< Maximum of bytesReserved.
+
+      BufferArenaStats() :
+        allocations(0),
+        hits(0),
+        bytesInUse(0),
+        peakBytesInUse(0),
+        bytesReserved(0),
+        peakBytesReserved(0) {}
+
+      /**
+       * @brief The fraction of allocations that have been served without a system allocation.
+       *
+       * @return A value in [0, 1].
+       */
+      double getHitRate() const {
+        if(0 == allocations) {
+          return 0.0;
+        } else {
+          return (double)hits / (double)allocations;
+        }
+      }
+  };
+
+  /**
+   * @brief A size class allocator for the temporary buffers of MeDiPack.
+   *
+   * Every AD active MPI call creates index, primal, adjoint and modified buffers which are only used for the duration
+   * of the call or until the handle is deleted by the AD tool. The arena rounds all requests up to a power of two and
+   * keeps the returned blocks in a free list per size class. Subsequent requests of the same size class are served from
+   * these lists without a system allocation.
+   *
+   * In the mode BufferArenaMode::TapeLifetime the blocks are cut from large chunks. The chunks are only returned to the
+   * system when reset() is called. MeDiPack never calls reset() itself, the AD tool that owns the arena has to call it
+   * together with the reset of its tape. If blocks are still in use during the reset, the release is postponed until
+   * the last block is returned.
+   *
+   * The handles on the tape keep their buffers until they are deleted. The arena must therefore outlive the tape: the
+   * AD tool has to delete all recorded handles, usually by resetting the tape, before the arena is destroyed.
+   *
+   * Requests larger than the largest size class are always forwarded to the system.
+   *
+   * The arena is not thread safe. Each AD tool has its own arena, see ADToolInterface::getBufferArena.
+   */
+  class BufferArena {
+    private:
+
+      struct BlockHeader {
+          size_t size;
+          size_t elements;
+          int sizeClass;
+      };
+
+      static const size_t Alignment = alignof(std::max_align_t);
+      static const size_t HeaderSize = (sizeof(BlockHeader) + Alignment - 1) / Alignment * Alignment;
+
+      static const size_t MinBlockSizeLog = 6;
+      static const int SizeClasses = 22;
+      static const size_t ChunkSize = 1 << 20;
+
+      BufferArenaMode mode;
+      std::vector<BlockHeader*> freeLists[SizeClasses];
+
+      std::vector<char*> chunks;
+      char* chunkPos;
+      size_t chunkRemaining;
+
+      size_t blocksInUse;
+      bool releasePending;
+
+      BufferArenaStats stats;
+
+    public:
+
+      /**
+       * @brief Create an empty arena.
+       *
+       * @param[in] mode  The memory management mode.
+       */
+      explicit BufferArena(BufferArenaMode mode = BufferArenaMode::Recycle) :
+        mode(mode),
+        freeLists(),
+        chunks(),
+        chunkPos(nullptr),
+        chunkRemaining(0),
+        blocksInUse(0),
+        releasePending(false),
+        stats() {}
+
+      /**
+       * @brief Gives all memory back to the system.
+       *
+       * Blocks that are still in use, e.g. by handles on a tape that was not reset, become invalid.
+       */
+      ~BufferArena() {
+        releaseCachedBlocks();
+        releaseChunks();
+      }
+
+      BufferArena(const BufferArena&) = delete;
+      BufferArena& operator=(const BufferArena&) = delete;
+
+      /**
+       * @brief The current memory management mode.
+       *
+       * @return The mode.
+       */
+      BufferArenaMode getMode() const {
+        return mode;
+      }
+
+      /**
+       * @brief Change the memory management mode.
+       *
+       * The mode can only be changed if no blocks are in use. All cached memory is released.
+       *
+       * @param[in] newMode  The new memory management mode.
+       */
+      void setMode(BufferArenaMode newMode) {
+        if(0 != blocksInUse) {
+          MEDI_EXCEPTION("The arena mode can not be changed while %d blocks are in use.", (int)blocksInUse);
+        }
+
+        release();
+        mode = newMode;
+      }
+
+      /**
+       * @brief The statistics since the creation of the arena or the last call to resetStats().
+       *
+       * @return The statistics.
+       */
+      const BufferArenaStats& getStats() const {
+        return stats;
+      }
+
+      /**
+       * @brief Reset the counters of the statistics.
+       *
+       * The byte values which describe the current state are kept.
+       */
+      void resetStats() {
+        stats.allocations = 0;
+        stats.hits = 0;
+        stats.peakBytesInUse = stats.bytesInUse;
+        stats.peakBytesReserved = stats.bytesReserved;
+      }
+
+      /**
+       * @brief Allocate an uninitialized memory block.
+       *
+       * @param[in] bytes  The minimum size of the block.
+       *
+       * @return The start of the block. The alignment is suitable for all fundamental types.
+       */
+      void* allocate(size_t bytes) {
+        return allocateBlock(bytes, 0);
+      }
+
+      /**
+       * @brief Return a block from allocate() to the arena.
+       *
+       * @param[in] ptr  A pointer from allocate() or nullptr.
+       */
+      void deallocate(void* ptr) {
+        if(nullptr != ptr) {
+          freeBlock(getHeader(ptr));
+        }
+      }
+
+      /**
+       * @brief Allocate an array and default construct the elements.
+       *
+       * @param[in] size  The number of elements.
+       *
+       * @return The start of the array.
+       *
+       * @tparam T  The type of the elements.
+       */
+      template<typename T>
+      T* createArray(size_t size) {
+        T* buf = reinterpret_cast<T*>(allocateBlock(sizeof(T) * size, size));
+
+        if(!std::is_trivially_default_constructible<T>::value) {
+          for(size_t i = 0; i < size; ++i) {
+            new(&buf[i]) T;
+          }
+        }
+
+        return buf;
+      }
+
+      /**
+       * @brief Destruct the elements of an array from createArray() and return the memory to the arena.
+       *
+       * @param[in,out] buf  The array, it is set to nullptr.
+       *
+       * @tparam T  The type of the elements.
+       */
+      template<typename T>
+      void deleteArray(T* &buf) {
+        if(nullptr != buf) {
+          BlockHeader* header = getHeader(buf);
+
+          if(!std::is_trivially_destructible<T>::value) {
+            for(size_t i = 0; i < header->elements; ++i) {
+              buf[i].~T();
+            }
+          }
+
+          freeBlock(header);
+          buf = nullptr;
+        }
+      }
+
+      /**
+       * @brief Indicates the end of the tape lifetime.
+       *
+       * In the mode BufferArenaMode::TapeLifetime all memory is given back to the system. If blocks are still in use,
+       * this is done after the last block has been returned. In the mode BufferArenaMode::Recycle nothing happens.
+       */
+      void reset() {
+        if(BufferArenaMode::TapeLifetime == mode) {
+          release();
+        }
+      }
+
+      /**
+       * @brief Give all memory that is not in use back to the system.
+       *
+       * In the mode BufferArenaMode::TapeLifetime the chunks can only be released if no blocks are in use. Otherwise
+       * the release is postponed until the last block has been returned.
+       */
+      void release() {
+        if(BufferArenaMode::Recycle == mode) {
+          releaseCachedBlocks();
+        } else if(0 == blocksInUse) {
+          releaseChunks();
+        } else {
+          releasePending = true;
+        }
+      }
+
+    private:
+
+      static BlockHeader* getHeader(void* ptr) {
+        return reinterpret_cast<BlockHeader*>(reinterpret_cast<char*>(ptr) - HeaderSize);
+      }
+
+      static int computeSizeClass(size_t bytes) {
+        int sizeClass = 0;
+        size_t classSize = (size_t)1 << MinBlockSizeLog;
+        while(classSize < bytes && sizeClass < SizeClasses) {
+          classSize <<= 1;
+          sizeClass += 1;
+        }
+
+        if(SizeClasses == sizeClass) {
+          return -1;
+        } else {
+          return sizeClass;
+        }
+      }
+
+      void* allocateBlock(size_t bytes, size_t elements) {
+        int sizeClass = computeSizeClass(bytes);
+        BlockHeader* header;
+
+        stats.allocations += 1;
+        if(0 <= sizeClass && !freeLists[sizeClass].empty()) {
+          header = freeLists[sizeClass].back();
+          freeLists[sizeClass].pop_back();
+
+          stats.hits += 1;
+        } else if(0 <= sizeClass) {
+          header = createBlock((size_t)1 << (MinBlockSizeLog + sizeClass));
+        } else {
+          header = reinterpret_cast<BlockHeader*>(systemAllocate(HeaderSize + bytes));
+          header->size = bytes;
+        }
+
+        header->sizeClass = sizeClass;
+        header->elements = elements;
+
+        blocksInUse += 1;
+        stats.bytesInUse += header->size;
+        if(stats.peakBytesInUse < stats.bytesInUse) {
+          stats.peakBytesInUse = stats.bytesInUse;
+        }
+
+        return reinterpret_cast<char*>(header) + HeaderSize;
+      }
+
+      void freeBlock(BlockHeader* header) {
+        blocksInUse -= 1;
+        stats.bytesInUse -= header->size;
+
+        if(0 <= header->sizeClass) {
+          freeLists[header->sizeClass].push_back(header);
+        } else {
+          systemFree(reinterpret_cast<char*>(header), HeaderSize + header->size);
+        }
+
+        if(releasePending && 0 == blocksInUse) {
+          releaseChunks();
+        }
+      }
+
+      BlockHeader* createBlock(size_t size) {
+        size_t blockSize = HeaderSize + size;
+        char* block;
+
+        if(BufferArenaMode::Recycle == mode) {
+          block = systemAllocate(blockSize);
+        } else if(blockSize > ChunkSize) {
+          block = systemAllocate(blockSize);
+          chunks.push_back(block);
+        } else {
+          if(chunkRemaining < blockSize) {
+            chunkPos = systemAllocate(ChunkSize);
+            chunkRemaining = ChunkSize;
+            chunks.push_back(chunkPos);
+          }
+
+          block = chunkPos;
+          chunkPos += blockSize;
+          chunkRemaining -= blockSize;
+        }
+
+        BlockHeader* header = reinterpret_cast<BlockHeader*>(block);
+        header->size = size;
+
+        return header;
+      }
+
+      char* systemAllocate(size_t bytes) {
+        stats.bytesReserved += bytes;
+        if(stats.peakBytesReserved < stats.bytesReserved) {
+          stats.peakBytesReserved = stats.bytesReserved;
+        }
+
+        return reinterpret_cast<char*>(::operator new(bytes));
+      }
+
+      void systemFree(char* block, size_t bytes) {
+        stats.bytesReserved -= bytes;
+
+        ::operator delete(block);
+      }
+
+      void releaseCachedBlocks() {
+        if(BufferArenaMode::Recycle == mode) {
+          for(int i = 0; i < SizeClasses; ++i) {
+            for(BlockHeader* header : freeLists[i]) {
+              systemFree(reinterpret_cast<char*>(header), HeaderSize + header->size);
+            }
+            freeLists[i].clear();
+          }
+        }
+      }
+
+      void releaseChunks() {
+        for(int i = 0; i < SizeClasses; ++i) {
+          freeLists[i].clear();
+        }
+
+        for(char* chunk : chunks) {
+          ::operator delete(chunk);
+        }
+        chunks.clear();
+
+        chunkPos = nullptr;
+        chunkRemaining = 0;
+        releasePending = false;
+        stats.bytesReserved = 0;
+      }
+  };
+}
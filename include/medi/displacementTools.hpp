@@ -29,6 +29,9 @@
 #pragma once
 
 
+#include <cstring>
+#include <vector>
+
 #include "macros.h"
 
 /**
@@ -74,6 +77,40 @@ namespace medi {
         }
       }
 
+      /**
+       * @brief Create contiguous displacements for a linearized buffer which is split into blocks of the given sizes.
+       *
+       * All sizes are scaled by the same factor such that their sum is totalLength.
+       *
+       * displs[0] = 0;
+       * displs[1] = counts[0];
+       * displs[2] = counts[0] + counts[1];
+       * ...
+       *
+       * counts[i] = sizes[i] * totalLength / sum(sizes);
+       *
+       * @param[in]    commSize  The size of the communication object.
+       * @param[in]       sizes  The size of each block, e.g. the element counts as provided by the user.
+       * @param[in] totalLength  The length of the linearized buffer.
+       */
+      inline LinearDisplacements(int commSize, const int* sizes, int totalLength) {
+        counts = new int[commSize];
+        displs = new int[commSize];
+
+        int totalSize = 0;
+        for(int i = 0; i < commSize; ++i) {
+          totalSize += sizes[i];
+        }
+        int factor = 0 == totalSize ? 0 : totalLength / totalSize;
+
+        int curDispl = 0;
+        for(int i = 0; i < commSize; ++i) {
+          counts[i] = sizes[i] * factor;
+          displs[i] = curDispl;
+          curDispl += counts[i];
+        }
+      }
+
       /**
        * @brief Destroy the structure.
        */
@@ -111,6 +148,25 @@ namespace medi {
     return totalSize;
   }
 
+  /**
+   * @brief Creates a copy of the counts of a message with a different size on each rank.
+   *
+   * Used by the handles that need the counts of the user after the call returned.
+   *
+   * @param[in] counts  The size of each rank.
+   * @param[in]  ranks  The number of the ranks.
+   *
+   * @return A new array with the same counts.
+   */
+  inline int* createCountsCopy(const int* counts, int ranks) {
+    int* copy = new int[ranks];
+    for(int i = 0; i < ranks; ++i) {
+      copy[i] = counts[i];
+    }
+
+    return copy;
+  }
+
   /**
    * @brief Creates the linearized displacements of a message with a different size on each rank.
    *
@@ -153,6 +209,325 @@ namespace medi {
     }
   }
 
+#ifndef MEDI_DisplacementCacheSize
+  /**
+   * @brief Maximum number of linearized displacements that are kept for reuse.
+   */
+# define MEDI_DisplacementCacheSize 64
+#endif
+
+  /**
+   * @brief Statistics of the displacement cache.
+   */
+  struct DisplacementCacheStatistics {
+      long hits;       ///< Number of requests that were served from the cache.
+      long misses;     ///< Number of requests that created new displacements.
+      long evictions;  ///< Number of entries that were removed from the cache.
+  };
+
+  /**
+   * @brief Memoizes the linearized counts and displacements of the vector functions.
+   *
+   * The entries are identified by the original counts, the number of ranks and the scaling factor. The same entry is
+   * given to the primal call and to all handles that are recorded with the same counts, so the reverse sweep reuses
+   * the displacements from the recording. An entry is reference counted. If it is evicted while it is still used, it
+   * is deleted with the last release. The entry is stored in front of the displacements, so a release does not need
+   * a lookup.
+   *
+   * The cache keeps at most MEDI_DisplacementCacheSize entries and evicts the least recently used one.
+   */
+  struct DisplacementCache {
+
+      /**
+       * @brief One linearized set of counts and displacements.
+       */
+      struct Entry {
+          size_t hash;
+          int ranks;
+          int scale;
+          int refCount;
+          bool cached;
+          long lastUse;
+
+          /// The original counts, the scaled counts, the pointer to the entry and the displacements.
+          int* data;
+
+          inline int* getCounts() {
+            return &data[ranks];
+          }
+
+          inline int* getDispls() {
+            return &data[2 * ranks + ENTRY_SLOT];
+          }
+      };
+
+      /// Number of ints for the entry pointer in front of the displacements.
+      static const int ENTRY_SLOT = (sizeof(Entry*) + sizeof(int) - 1) / sizeof(int);
+
+      std::vector<Entry*> entries;
+      Entry* lastEntry;
+      long useCounter;
+      DisplacementCacheStatistics stats;
+
+      inline DisplacementCache() :
+        entries(),
+        lastEntry(nullptr),
+        useCounter(0),
+        stats() {}
+
+      inline ~DisplacementCache() {
+        for(Entry* entry : entries) {
+          entry->cached = false;
+          if(0 == entry->refCount) {
+            deleteEntry(entry);
+          }
+        }
+      }
+
+      /**
+       * @return The cache of this process.
+       */
+      static inline DisplacementCache& global() {
+        // not destroyed at exit, handles of static tapes may release their entries after the static destructors
+        static DisplacementCache* cache = new DisplacementCache();
+
+        return *cache;
+      }
+
+      /**
+       * @brief Get the linearized counts and displacements for the counts.
+       *
+       * The arrays must not be modified and are given back with release.
+       *
+       * @param[out] countsOut  The scaled counts.
+       * @param[out] displsOut  The linearized displacements of the scaled counts.
+       * @param[in]     counts  The size of each rank.
+       * @param[in]      ranks  The number of the ranks.
+       * @param[in]      scale  The scaling factor of the counts and displacements.
+       */
+      inline void acquire(int* &countsOut, int* &displsOut, const int* counts, int ranks, int scale) {
+        // repeated calls with the same counts are resolved without the hash
+        Entry* entry = lastEntry;
+        if(nullptr == entry || !isMatch(entry, counts, ranks, scale)) {
+          size_t hash = computeHash(counts, ranks, scale);
+
+          entry = nullptr;
+          for(Entry* cur : entries) {
+            if(cur->hash == hash && isMatch(cur, counts, ranks, scale)) {
+              entry = cur;
+              break;
+            }
+          }
+
+          if(nullptr == entry) {
+            stats.misses += 1;
+            entry = createEntry(hash, counts, ranks, scale);
+            if((size_t)MEDI_DisplacementCacheSize <= entries.size()) {
+              evictOldest();
+            }
+            entries.push_back(entry);
+          } else {
+            stats.hits += 1;
+          }
+
+          lastEntry = entry;
+        } else {
+          stats.hits += 1;
+        }
+
+        entry->refCount += 1;
+        entry->lastUse = ++useCounter;
+
+        countsOut = entry->getCounts();
+        displsOut = entry->getDispls();
+      }
+
+      /**
+       * @brief Keep the arrays from a previous acquire if they have the same scaling factor, otherwise release them and
+       * acquire new ones.
+       *
+       * @param[in,out] countsOut  The scaled counts, nullptr if nothing was acquired.
+       * @param[in,out] displsOut  The linearized displacements, nullptr if nothing was acquired.
+       * @param[in]        counts  The size of each rank. Has to be the same as for the previous acquire.
+       * @param[in]         ranks  The number of the ranks.
+       * @param[in]         scale  The scaling factor of the counts and displacements.
+       */
+      inline void update(int* &countsOut, int* &displsOut, const int* counts, int ranks, int scale) {
+        if(nullptr != displsOut) {
+          if(scale == getEntry(displsOut)->scale) {
+            stats.hits += 1;
+            return;
+          }
+          release(displsOut);
+        }
+
+        acquire(countsOut, displsOut, counts, ranks, scale);
+      }
+
+      /**
+       * @brief Give back the arrays from acquire.
+       *
+       * @param[in] displs  The displacements from acquire. Can be nullptr.
+       */
+      inline void release(const int* displs) {
+        if(nullptr == displs) {
+          return;
+        }
+
+        Entry* entry = getEntry(displs);
+        entry->refCount -= 1;
+        if(0 == entry->refCount && !entry->cached) {
+          deleteEntry(entry);
+        }
+      }
+
+    private:
+
+      static inline size_t computeHash(const int* counts, int ranks, int scale) {
+        size_t hash = 14695981039346656037ull;
+        hash = (hash ^ (size_t)ranks) * 1099511628211ull;
+        hash = (hash ^ (size_t)scale) * 1099511628211ull;
+        for(int i = 0; i < ranks; ++i) {
+          hash = (hash ^ (size_t)counts[i]) * 1099511628211ull;
+        }
+
+        return hash;
+      }
+
+      static inline bool isMatch(const Entry* entry, const int* counts, int ranks, int scale) {
+        return entry->ranks == ranks && entry->scale == scale
+               && 0 == std::memcmp(entry->data, counts, sizeof(int) * ranks);
+      }
+
+      static inline Entry* getEntry(const int* displs) {
+        Entry* entry;
+        std::memcpy(&entry, displs - ENTRY_SLOT, sizeof(Entry*));
+
+        return entry;
+      }
+
+      inline Entry* createEntry(size_t hash, const int* counts, int ranks, int scale) {
+        Entry* entry = new Entry();
+        entry->hash = hash;
+        entry->ranks = ranks;
+        entry->scale = scale;
+        entry->refCount = 0;
+        entry->cached = true;
+        entry->lastUse = 0;
+        entry->data = new int[3 * ranks + ENTRY_SLOT];
+
+        int* countsOut = entry->getCounts();
+        int* displsOut = entry->getDispls();
+        for(int i = 0; i < ranks; ++i) {
+          entry->data[i] = counts[i];
+          countsOut[i] = counts[i] * scale;
+          displsOut[i] = 0 == i ? 0 : countsOut[i - 1] + displsOut[i - 1];
+        }
+
+        std::memcpy(displsOut - ENTRY_SLOT, &entry, sizeof(Entry*));
+
+        return entry;
+      }
+
+      inline void deleteEntry(Entry* entry) {
+        if(lastEntry == entry) {
+          lastEntry = nullptr;
+        }
+        delete [] entry->data;
+        delete entry;
+      }
+
+      inline void evictOldest() {
+        size_t oldest = 0;
+        for(size_t i = 1; i < entries.size(); ++i) {
+          if(entries[i]->lastUse < entries[oldest]->lastUse) {
+            oldest = i;
+          }
+        }
+
+        Entry* entry = entries[oldest];
+        entries[oldest] = entries.back();
+        entries.pop_back();
+        stats.evictions += 1;
+
+        if(lastEntry == entry) {
+          lastEntry = nullptr;
+        }
+        entry->cached = false;
+        if(0 == entry->refCount) {
+          deleteEntry(entry);
+        }
+      }
+  };
+
+  /**
+   * @brief Get the linearized displacements of a message with a different size on each rank from the cache.
+   *
+   * The result is the same as for createLinearDisplacements. It must not be modified and is given back with
+   * releaseLinearDisplacements.
+   *
+   * @param[in] counts  The size of each rank.
+   * @param[in]  ranks  The number of the ranks.
+   *
+   * @return The displacements array that starts at 0 and increases by the counts on each rank.
+   */
+  inline int* acquireLinearDisplacements(const int* counts, int ranks) {
+    int* countsOut;
+    int* displsOut;
+    DisplacementCache::global().acquire(countsOut, displsOut, counts, ranks, 1);
+
+    return displsOut;
+  }
+
+  /**
+   * @brief Get the scaled counts and the linearized displacements from the cache.
+   *
+   * The result is the same as for createLinearDisplacementsAndCount. The arrays must not be modified and are given
+   * back with releaseLinearDisplacements.
+   *
+   * @param[out] countsOut  The generated counts.
+   * @param[out] displsOut  The generated displacements.
+   * @param[in]     counts  The size of each rank.
+   * @param[in]      ranks  The number of the ranks.
+   * @param[in]      scale  The scaling factor of the counts and displacements.
+   */
+  inline void acquireLinearDisplacementsAndCount(int* &countsOut, int* &displsOut, const int* counts, int ranks, int scale) {
+    DisplacementCache::global().acquire(countsOut, displsOut, counts, ranks, scale);
+  }
+
+  /**
+   * @brief Get the scaled counts and the linearized displacements from the cache, if the arrays are not already set
+   * for the scaling factor.
+   *
+   * Used by the handles which keep the arrays for all evaluations of the tape.
+   *
+   * @param[in,out] countsOut  The generated counts, nullptr on the first call.
+   * @param[in,out] displsOut  The generated displacements, nullptr on the first call.
+   * @param[in]        counts  The size of each rank.
+   * @param[in]         ranks  The number of the ranks.
+   * @param[in]         scale  The scaling factor of the counts and displacements.
+   */
+  inline void updateLinearDisplacementsAndCount(int* &countsOut, int* &displsOut, const int* counts, int ranks, int scale) {
+    DisplacementCache::global().update(countsOut, displsOut, counts, ranks, scale);
+  }
+
+  /**
+   * @brief Give back the displacements from acquireLinearDisplacements, acquireLinearDisplacementsAndCount or
+   * updateLinearDisplacementsAndCount.
+   *
+   * @param[in] displs  The displacements. Can be nullptr.
+   */
+  inline void releaseLinearDisplacements(const int* displs) {
+    DisplacementCache::global().release(displs);
+  }
+
+  /**
+   * @return The statistics of the displacement cache.
+   */
+  inline const DisplacementCacheStatistics& getDisplacementCacheStatistics() {
+    return DisplacementCache::global().stats;
+  }
+
   /**
    * @brief Creates the counts for a message with a different size on each rank.
    *
@@ -0,0 +1,288 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+#include "exceptions.hpp"
+#include "macros.h"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Statistics of a HandleSlab.
+   */
+  struct HandleSlabStats {
+      size_t allocations;      ///< Number of handles that have been created.
+      size_t liveHandles;      ///< Number of handles that have not been deleted.
+      size_t peakLiveHandles;  ///< Maximum of liveHandles.
+      size_t bytesReserved;    ///< Bytes of all slabs.
+
+      HandleSlabStats() :
+        allocations(0),
+        liveHandles(0),
+        peakLiveHandles(0),
+        bytesReserved(0) {}
+  };
+
+  /**
+   * @brief Slab allocator for the handles that MeDiPack records on the tape of the AD tool.
+   *
+   * The handles are placement constructed into contiguous slabs. The memory of a deleted handle is kept in a free list
+   * for its size and reused by the next handle of the same size. reset() rewinds all slabs at once, this should be done
+   * by the AD tool when the tape is reset and all handles have been deleted. If handles are still alive during the
+   * reset, the rewind is postponed until the last handle is deleted. release() gives all slabs back to the system.
+   *
+   * The handles are created with `new (slab) Handle(...)` and deleted with the usual `delete handle` of the AD tool.
+   * The owning slab is stored in front of each handle, see HandleBase::operator delete. Handles that are created
+   * without a slab are allocated on the heap.
+   *
+   * Each handle refers to its slab until it is deleted, so the slab must not be destroyed while handles are alive. The
+   * destructor aborts with an exception in this case.
+   *
+   * The slab is not thread safe. Each AD tool has its own slab, see ADToolInterface::getHandleSlab.
+   */
+  class HandleSlab {
+    private:
+
+      struct HandleHeader {
+          HandleSlab* slab;
+          size_t sizeClass;
+      };
+
+      static const size_t Alignment = alignof(std::max_align_t);
+      static const size_t HeaderSize = (sizeof(HandleHeader) + Alignment - 1) / Alignment * Alignment;
+
+      static const size_t SizeClasses = 64;
+      static const size_t SlabSize = 1 << 16;
+
+      std::vector<char*> slabs;
+      size_t curSlab;
+      size_t slabPos;
+
+      std::vector<HandleHeader*> freeLists[SizeClasses];
+
+      bool rewindPending;
+      bool releasePending;
+
+      HandleSlabStats stats;
+
+    public:
+
+      HandleSlab() :
+        slabs(),
+        curSlab(0),
+        slabPos(0),
+        freeLists(),
+        rewindPending(false),
+        releasePending(false),
+        stats() {}
+
+      ~HandleSlab() {
+        if(0 != stats.liveHandles) {
+          MEDI_EXCEPTION("The handle slab is destroyed while %d handles are alive. The tape has to be reset or deleted before the AD tool.",
+                         (int)stats.liveHandles);
+        }
+
+        freeSlabs();
+      }
+
+      HandleSlab(const HandleSlab&) = delete;
+      HandleSlab& operator=(const HandleSlab&) = delete;
+
+      /**
+       * @brief The statistics of the slab.
+       *
+       * @return The statistics.
+       */
+      const HandleSlabStats& getStats() const {
+        return stats;
+      }
+
+      /**
+       * @brief Memory for one handle.
+       *
+       * @param[in] size  The size of the handle.
+       *
+       * @return The memory for the handle.
+       */
+      void* allocate(size_t size) {
+        size_t sizeClass = (size + Alignment - 1) / Alignment;
+
+        HandleHeader* header;
+        if(sizeClass >= SizeClasses) {
+          header = createHeapHeader(size);
+          header->slab = this;
+        } else if(!freeLists[sizeClass].empty()) {
+          header = freeLists[sizeClass].back();
+          freeLists[sizeClass].pop_back();
+        } else {
+          header = createSlabHeader(sizeClass * Alignment);
+        }
+        header->sizeClass = sizeClass;
+
+        stats.allocations += 1;
+        stats.liveHandles += 1;
+        if(stats.peakLiveHandles < stats.liveHandles) {
+          stats.peakLiveHandles = stats.liveHandles;
+        }
+
+        return reinterpret_cast<char*>(header) + HeaderSize;
+      }
+
+      /**
+       * @brief Indicates that all handles of the tape have been deleted.
+       *
+       * All slabs are rewound and used again for the next tape.
+       */
+      void reset() {
+        if(0 == stats.liveHandles) {
+          rewind();
+        } else {
+          rewindPending = true;
+        }
+      }
+
+      /**
+       * @brief Give all slabs back to the system.
+       *
+       * If handles are still alive, the release is postponed until the last handle is deleted.
+       */
+      void release() {
+        if(0 == stats.liveHandles) {
+          freeSlabs();
+        } else {
+          releasePending = true;
+        }
+      }
+
+      /**
+       * @brief Memory for one handle that does not belong to a slab.
+       *
+       * @param[in] size  The size of the handle.
+       *
+       * @return The memory for the handle.
+       */
+      static void* allocateHeap(size_t size) {
+        HandleHeader* header = createHeapHeader(size);
+        header->slab = nullptr;
+        header->sizeClass = SizeClasses;
+
+        return reinterpret_cast<char*>(header) + HeaderSize;
+      }
+
+      /**
+       * @brief Give the memory of a handle back to its slab or to the heap.
+       *
+       * @param[in] ptr  Memory from allocate() or allocateHeap().
+       */
+      static void deallocate(void* ptr) {
+        if(nullptr != ptr) {
+          HandleHeader* header = reinterpret_cast<HandleHeader*>(reinterpret_cast<char*>(ptr) - HeaderSize);
+
+          if(nullptr == header->slab) {
+            ::operator delete(header);
+          } else {
+            header->slab->deallocateHeader(header);
+          }
+        }
+      }
+
+    private:
+
+      static HandleHeader* createHeapHeader(size_t size) {
+        return reinterpret_cast<HandleHeader*>(::operator new(HeaderSize + size));
+      }
+
+      HandleHeader* createSlabHeader(size_t size) {
+        size_t blockSize = HeaderSize + size;
+
+        if(curSlab == slabs.size() || slabPos + blockSize > SlabSize) {
+          if(curSlab != slabs.size()) {
+            curSlab += 1;
+          }
+          if(curSlab == slabs.size()) {
+            slabs.push_back(reinterpret_cast<char*>(::operator new(SlabSize)));
+            stats.bytesReserved += SlabSize;
+          }
+          slabPos = 0;
+        }
+
+        HandleHeader* header = reinterpret_cast<HandleHeader*>(slabs[curSlab] + slabPos);
+        header->slab = this;
+        slabPos += blockSize;
+
+        return header;
+      }
+
+      void deallocateHeader(HandleHeader* header) {
+        if(header->sizeClass >= SizeClasses) {
+          ::operator delete(header);
+        } else {
+          freeLists[header->sizeClass].push_back(header);
+        }
+
+        stats.liveHandles -= 1;
+        if(0 == stats.liveHandles) {
+          if(releasePending) {
+            freeSlabs();
+          } else if(rewindPending) {
+            rewind();
+          }
+        }
+      }
+
+      void rewind() {
+        for(size_t i = 0; i < SizeClasses; ++i) {
+          freeLists[i].clear();
+        }
+
+        curSlab = 0;
+        slabPos = 0;
+        rewindPending = false;
+      }
+
+      void freeSlabs() {
+        rewind();
+
+        for(char* slab : slabs) {
+          ::operator delete(slab);
+        }
+        slabs.clear();
+
+        releasePending = false;
+        stats.bytesReserved = 0;
+      }
+  };
+}
@@ -0,0 +1,260 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <cstdlib>
+#include <type_traits>
+
+#include "macros.h"
+#include "adjointInterface.hpp"
+
+/**
+ * @brief Global namespace for MeDiPack - Message Differentiation Package
+ */
+namespace medi {
+
+  /**
+   * @brief Compression of the index buffers in the handles into ranges of indices.
+   *
+   * Linear index AD tools register the received values with consecutive identifiers and passive values have the same
+   * identifier. The index buffers are therefore mostly made of such runs. A run is stored as the pair (start, length).
+   * A positive length describes the indices start, start + 1, ..., a negative length |length| copies of start.
+   *
+   * The buffer is only replaced by the ranges if this reduces the memory at least by half, otherwise the raw indices
+   * are kept. The number of ranges is zero for raw indices.
+   *
+   * The compression is only available for signed integral index types and can be disabled with the preprocessor macro
+   * MEDI_CompressIndices=0.
+   *
+   * @tparam     IndexType  The index type of the AD tool.
+   * @tparam  compressible  True if the indices can be compressed.
+   */
+  template<typename IndexType,
+           bool compressible = MEDI_CompressIndices && std::is_integral<IndexType>::value && std::is_signed<IndexType>::value>
+  struct IndexRanges {
+
+      /**
+       * @brief Replace the indices with the ranges if this saves enough memory.
+       *
+       * @param[in]          tool  The AD tool that created the index buffer.
+       * @param[in,out]   indices  The raw indices, replaced by the range data if compressed.
+       * @param[out]       ranges  The number of ranges, zero if the indices are not compressed.
+       * @param[in]          size  The number of indices.
+       */
+      template<typename Tool>
+      static void compress(const Tool& tool, IndexType* &indices, int &ranges, int size) {
+        ranges = 0;
+        if(nullptr == indices) {
+          return;
+        }
+
+        int maxRanges = size / 4;
+        int count = 0;
+        int pos = 0;
+        while(pos < size && count <= maxRanges) {
+          pos += std::abs(runLength(indices, pos, size));
+          count += 1;
+        }
+
+        if(pos < size || count > maxRanges) {
+          return; // compression does not pay off
+        }
+
+        IndexType* rangeData;
+        tool.createIndexTypeBuffer(rangeData, 2 * count);
+        pos = 0;
+        for(int i = 0; i < count; ++i) {
+          int length = runLength(indices, pos, size);
+          rangeData[2 * i] = indices[pos];
+          rangeData[2 * i + 1] = (IndexType)length;
+          pos += std::abs(length);
+        }
+
+        tool.deleteIndexTypeBuffer(indices);
+        indices = rangeData;
+        ranges = count;
+      }
+
+      /**
+       * @brief Write the indices described by the ranges.
+       *
+       * @param[in] rangeData  The (start, length) pairs of the ranges.
+       * @param[in]    ranges  The number of ranges.
+       * @param[out]  indices  The raw indices.
+       */
+      static void expand(const IndexType* MEDI_RESTRICT rangeData, int ranges, IndexType* MEDI_RESTRICT indices) {
+        for(int i = 0; i < ranges; ++i) {
+          IndexType start = rangeData[2 * i];
+          int length = (int)rangeData[2 * i + 1];
+          if(0 < length) {
+            for(int j = 0; j < length; ++j) {
+              indices[j] = start + (IndexType)j;
+            }
+          } else {
+            length = -length;
+            for(int j = 0; j < length; ++j) {
+              indices[j] = start;
+            }
+          }
+          indices += length;
+        }
+      }
+
+      /**
+       * @brief Get the raw indices for the access of the AD tool.
+       *
+       * @return The indices if they are not compressed, otherwise a temporary buffer that needs to be deleted with
+       *         deleteRaw().
+       */
+      template<typename Tool>
+      static const IndexType* getRaw(const Tool& tool, const IndexType* indices, int ranges, int size) {
+        if(0 == ranges) {
+          return indices;
+        }
+
+        IndexType* raw;
+        tool.createIndexTypeBuffer(raw, size);
+        expand(indices, ranges, raw);
+
+        return raw;
+      }
+
+      /**
+       * @brief Delete the buffer from getRaw() if it is a temporary one.
+       */
+      template<typename Tool>
+      static void deleteRaw(const Tool& tool, const IndexType* raw, int ranges) {
+        if(0 != ranges) {
+          IndexType* temp = const_cast<IndexType*>(raw);
+          tool.deleteIndexTypeBuffer(temp);
+        }
+      }
+
+    private:
+
+      static inline int runLength(const IndexType* indices, int pos, int size) {
+        int end = pos + 1;
+        if(end < size && indices[end] == indices[pos]) {
+          while(end < size && indices[end] == indices[pos]) {
+            end += 1;
+          }
+          return -(end - pos);
+        } else {
+          while(end < size && indices[end] == indices[end - 1] + 1) {
+            end += 1;
+          }
+          return end - pos;
+        }
+      }
+  };
+
+  /**
+   * @brief Index types that can not be compressed are always stored as raw indices.
+   */
+  template<typename IndexType>
+  struct IndexRanges<IndexType, false> {
+
+      template<typename Tool>
+      static void compress(const Tool& tool, IndexType* &indices, int &ranges, int size) {
+        MEDI_UNUSED(tool);
+        MEDI_UNUSED(indices);
+        MEDI_UNUSED(size);
+
+        ranges = 0;
+      }
+
+      template<typename Tool>
+      static const IndexType* getRaw(const Tool& tool, const IndexType* indices, int ranges, int size) {
+        MEDI_UNUSED(tool);
+        MEDI_UNUSED(ranges);
+        MEDI_UNUSED(size);
+
+        return indices;
+      }
+
+      template<typename Tool>
+      static void deleteRaw(const Tool& tool, const IndexType* raw, int ranges) {
+        MEDI_UNUSED(tool);
+        MEDI_UNUSED(raw);
+        MEDI_UNUSED(ranges);
+      }
+  };
+
+  /**
+   * @brief Compress the index buffer of a handle, see IndexRanges.
+   */
+  template<typename Tool, typename IndexType>
+  inline void compressIndices(const Tool& tool, IndexType* &indices, int &ranges, int size) {
+    IndexRanges<IndexType>::compress(tool, indices, ranges, size);
+  }
+
+  /**
+   * @brief Calls AdjointInterface::getAdjoints with the raw indices of a possibly compressed index buffer.
+   */
+  template<typename Tool, typename IndexType>
+  inline void getAdjoints(AdjointInterface* adjointInterface, const Tool& tool, const IndexType* indices, int ranges,
+                          void* adjoints, int elements) {
+    const IndexType* raw = IndexRanges<IndexType>::getRaw(tool, indices, ranges, elements);
+    adjointInterface->getAdjoints(raw, adjoints, elements);
+    IndexRanges<IndexType>::deleteRaw(tool, raw, ranges);
+  }
+
+  /**
+   * @brief Calls AdjointInterface::updateAdjoints with the raw indices of a possibly compressed index buffer.
+   */
+  template<typename Tool, typename IndexType>
+  inline void updateAdjoints(AdjointInterface* adjointInterface, const Tool& tool, const IndexType* indices, int ranges,
+                             const void* adjoints, int elements) {
+    const IndexType* raw = IndexRanges<IndexType>::getRaw(tool, indices, ranges, elements);
+    adjointInterface->updateAdjoints(raw, adjoints, elements);
+    IndexRanges<IndexType>::deleteRaw(tool, raw, ranges);
+  }
+
+  /**
+   * @brief Calls AdjointInterface::getPrimals with the raw indices of a possibly compressed index buffer.
+   */
+  template<typename Tool, typename IndexType>
+  inline void getPrimals(AdjointInterface* adjointInterface, const Tool& tool, const IndexType* indices, int ranges,
+                         const void* primals, int elements) {
+    const IndexType* raw = IndexRanges<IndexType>::getRaw(tool, indices, ranges, elements);
+    adjointInterface->getPrimals(raw, primals, elements);
+    IndexRanges<IndexType>::deleteRaw(tool, raw, ranges);
+  }
+
+  /**
+   * @brief Calls AdjointInterface::setPrimals with the raw indices of a possibly compressed index buffer.
+   */
+  template<typename Tool, typename IndexType>
+  inline void setPrimals(AdjointInterface* adjointInterface, const Tool& tool, const IndexType* indices, int ranges,
+                         const void* primals, int elements) {
+    const IndexType* raw = IndexRanges<IndexType>::getRaw(tool, indices, ranges, elements);
+    adjointInterface->setPrimals(raw, primals, elements);
+    IndexRanges<IndexType>::deleteRaw(tool, raw, ranges);
+  }
+}
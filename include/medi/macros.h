@@ -39,6 +39,7 @@
 #define MEDI_MPI_VERSION_2_2 202
 #define MEDI_MPI_VERSION_3_0 300
 #define MEDI_MPI_VERSION_3_1 301
+#define MEDI_MPI_VERSION_4_0 400
 
 
 #ifndef MEDI_MPI_TARGET
@@ -101,6 +102,26 @@
   #endif
 #endif
 
+#ifndef MEDI_CompressIndices
+  /**
+   * @brief Store the index buffers of the handles as ranges of indices if possible, see IndexRanges.
+   *
+   * It can be set with the preprocessor macro MEDI_CompressIndices=<0/1>
+   */
+  #define MEDI_CompressIndices 1
+#endif
+
+#ifndef MEDI_RESTRICT
+  #if defined(__GNUC__) || defined(__clang__) || defined(_MSC_VER)
+    /**
+     * @brief Marks a pointer that does not alias with other pointers, such that loops over it can be vectorized.
+     */
+    #define MEDI_RESTRICT __restrict
+  #else
+    #define MEDI_RESTRICT /* not supported */
+  #endif
+#endif
+
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
  */
@@ -31,6 +31,11 @@
 
 #include <mpi.h>
 
+#include <algorithm>
+#include <cstring>
+#include <functional>
+#include <vector>
+
 #include "macros.h"
 #include "typeDefinitions.h"
 
@@ -44,16 +49,325 @@ namespace medi {
   }
 
 
+  /**
+   * @brief Cached information about a communicator.
+   */
+  struct CommInfo {
+      int size;         ///< Number of ranks in the communicator, the local group for intercommunicators.
+      int rank;         ///< Rank of this process in the communicator.
+      int topology;     ///< Result of MPI_Topo_test.
+      bool isInter;     ///< True for intercommunicators.
+      int nodeSize;     ///< Number of ranks on the node of this process, -1 until getCommNodeInfo is called.
+      int nodeRank;     ///< Rank of this process on its node, -1 until getCommNodeInfo is called.
+      MPI_Comm nodeComm;  ///< Communicator of the ranks on the node, MPI_COMM_NULL until getCommNodeInfo is called.
+      int nodeCount;    ///< Number of nodes of the communicator, -1 until getCommHierarchyInfo is called.
+      MPI_Comm leaderComm;  ///< Communicator of the first ranks on each node, MPI_COMM_NULL on the other ranks.
+      std::vector<int> rankNodes;  ///< Node and rank on the node for each rank, empty until getCommHierarchyInfo is called.
+      int inDegree;     ///< Number of sources of the process topology, 0 if the communicator has no topology.
+      int outDegree;    ///< Number of destinations of the process topology, 0 if the communicator has no topology.
+      MPI_Comm transposedComm;  ///< Communicator with the transposed topology, MPI_COMM_NULL until getCommTransposed is called.
+  };
+
+  /**
+   * @brief Cache for the information about the communicators.
+   *
+   * The information is stored in an attribute of the communicator. Since an attribute lookup is not cheaper than
+   * MPI_Comm_rank, a small direct mapped table in front of the attributes resolves the communicators that are used
+   * repeatedly. The delete callback of the attribute removes the communicator from the table, so a handle that is
+   * reused for a new communicator can not see the information of a freed one.
+   */
+  struct CommInfoCache {
+
+      static const int TABLE_SIZE = 16;
+
+      struct Entry {
+          MPI_Comm comm;
+          CommInfo* info;
+      };
+
+      /**
+       * @return The table in front of the attributes.
+       */
+      static Entry* getTable() {
+        static Entry table[TABLE_SIZE];
+
+        return table;
+      }
+
+      /**
+       * @return The table entry for a communicator.
+       */
+      static Entry& getEntry(MPI_Comm comm) {
+        size_t hash = std::hash<MPI_Comm>()(comm);
+
+        // the handles of some implementations are aligned pointers
+        return getTable()[(hash ^ (hash >> 4) ^ (hash >> 8)) % TABLE_SIZE];
+      }
+
+      /**
+       * @brief Get the information from the attribute or create it.
+       */
+      static CommInfo& lookup(MPI_Comm comm) {
+        static int keyval = MPI_KEYVAL_INVALID;
+        if(MPI_KEYVAL_INVALID == keyval) {
+          MEDI_CHECK_ERROR(MPI_Comm_create_keyval(MPI_COMM_NULL_COPY_FN, deleteAttribute, &keyval, nullptr));
+        }
+
+        CommInfo* info;
+        int flag = 0;
+        MEDI_CHECK_ERROR(MPI_Comm_get_attr(comm, keyval, &info, &flag));
+        if(!flag) {
+          info = new CommInfo();
+          MEDI_CHECK_ERROR(MPI_Comm_size(comm, &info->size));
+          MEDI_CHECK_ERROR(MPI_Comm_rank(comm, &info->rank));
+          MEDI_CHECK_ERROR(MPI_Topo_test(comm, &info->topology));
+          int isInter;
+          MEDI_CHECK_ERROR(MPI_Comm_test_inter(comm, &isInter));
+          info->isInter = 0 != isInter;
+          info->nodeSize = -1;
+          info->nodeRank = -1;
+          info->nodeComm = MPI_COMM_NULL;
+          info->nodeCount = -1;
+          info->leaderComm = MPI_COMM_NULL;
+          computeDegrees(comm, *info);
+          info->transposedComm = MPI_COMM_NULL;
+
+          MEDI_CHECK_ERROR(MPI_Comm_set_attr(comm, keyval, info));
+        }
+
+        Entry& entry = getEntry(comm);
+        entry.comm = comm;
+        entry.info = info;
+
+        return *info;
+      }
+
+      /**
+       * @brief Get the number of sources and destinations of the process topology.
+       */
+      static void computeDegrees(MPI_Comm comm, CommInfo& info) {
+        info.inDegree = 0;
+        info.outDegree = 0;
+
+        if(MPI_CART == info.topology) {
+          // two neighbors per dimension, MPI_PROC_NULL neighbors are counted
+          int ndims;
+          MEDI_CHECK_ERROR(MPI_Cartdim_get(comm, &ndims));
+          info.inDegree = 2 * ndims;
+          info.outDegree = 2 * ndims;
+        } else if(MPI_GRAPH == info.topology) {
+          int neighbors;
+          MEDI_CHECK_ERROR(MPI_Graph_neighbors_count(comm, info.rank, &neighbors));
+          info.inDegree = neighbors;
+          info.outDegree = neighbors;
+        }
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+        else if(MPI_DIST_GRAPH == info.topology) {
+          int weighted;
+          MEDI_CHECK_ERROR(MPI_Dist_graph_neighbors_count(comm, &info.inDegree, &info.outDegree, &weighted));
+        }
+#endif
+      }
+
+      /**
+       * @brief Removes the communicator from the table and deletes the information.
+       */
+      static int deleteAttribute(MPI_Comm comm, int keyval, void* value, void* extraState) {
+        MEDI_UNUSED(keyval);
+        MEDI_UNUSED(extraState);
+
+        CommInfo* info = reinterpret_cast<CommInfo*>(value);
+        Entry* table = getTable();
+        for(int i = 0; i < TABLE_SIZE; ++i) {
+          if(info == table[i].info) {
+            table[i].info = nullptr;
+          }
+        }
+
+        if(MPI_COMM_NULL != info->nodeComm) {
+          MPI_Comm_free(&info->nodeComm);
+        }
+        if(MPI_COMM_NULL != info->leaderComm) {
+          MPI_Comm_free(&info->leaderComm);
+        }
+        if(MPI_COMM_NULL != info->transposedComm && comm != info->transposedComm) {
+          MPI_Comm_free(&info->transposedComm);
+        }
+        delete info;
+
+        return MPI_SUCCESS;
+      }
+  };
+
+  /**
+   * @brief The cached information about a communicator.
+   *
+   * The information is created on the first call for a communicator. The call is local.
+   *
+   * @param[in] comm  The communicator.
+   * @return The information about the communicator.
+   */
+  inline const CommInfo& getCommInfo(MPI_Comm comm) {
+    CommInfoCache::Entry& entry = CommInfoCache::getEntry(comm);
+    if(nullptr != entry.info && comm == entry.comm) {
+      return *entry.info;
+    }
+
+    return CommInfoCache::lookup(comm);
+  }
+
+  /**
+   * @brief Access to the number of ranks per node for getCommNodeInfo, 0 uses the shared memory nodes.
+   *
+   * @return Reference to the number of ranks per node.
+   */
+  inline int& globalNodeSplitSize() {
+    static int size = 0;
+
+    return size;
+  }
+
+  /**
+   * @brief Split the communicators into nodes of consecutive ranks instead of the shared memory nodes.
+   *
+   * Intended for testing the node hierarchy on one machine. Node k holds the ranks k * size to (k + 1) * size - 1.
+   * The setting applies to the communicators whose node information is created afterwards, see getCommNodeInfo, e.g.
+   * communicators that are duplicated after the call. Shared memory windows require that the ranks of a node share
+   * the memory.
+   *
+   * Needs to be called with the same arguments on all processes.
+   *
+   * @param[in] size  The number of ranks per node, 0 restores the shared memory nodes.
+   */
+  inline void setNodeSplitSize(int size) {
+    globalNodeSplitSize() = size;
+  }
+
+  /**
+   * @brief The cached information about a communicator including the node local ranks.
+   *
+   * The first call for a communicator is collective, it splits the communicator into the ranks that share the memory
+   * of a node, or into the nodes from setNodeSplitSize. Intercommunicators and MPI versions before 3.0 are treated as one
+   * rank per node.
+   *
+   * @param[in] comm  The communicator.
+   * @return The information about the communicator.
+   */
+  inline const CommInfo& getCommNodeInfo(MPI_Comm comm) {
+    CommInfo& info = const_cast<CommInfo&>(getCommInfo(comm));
+    if(-1 == info.nodeSize) {
+#if MEDI_MPI_VERSION_3_0 <= MEDI_MPI_TARGET
+      if(!info.isInter) {
+        if(0 < globalNodeSplitSize()) {
+          MEDI_CHECK_ERROR(MPI_Comm_split(comm, info.rank / globalNodeSplitSize(), info.rank, &info.nodeComm));
+        } else {
+          MEDI_CHECK_ERROR(MPI_Comm_split_type(comm, MPI_COMM_TYPE_SHARED, info.rank, MPI_INFO_NULL, &info.nodeComm));
+        }
+        MEDI_CHECK_ERROR(MPI_Comm_size(info.nodeComm, &info.nodeSize));
+        MEDI_CHECK_ERROR(MPI_Comm_rank(info.nodeComm, &info.nodeRank));
+      } else
+#endif
+      {
+        info.nodeSize = 1;
+        info.nodeRank = 0;
+      }
+    }
+
+    return info;
+  }
+
+  /**
+   * @brief The cached information about a communicator including the nodes of all ranks.
+   *
+   * The first call for a communicator is collective. It creates the node communicator, see getCommNodeInfo, and a
+   * communicator of the first ranks on each node, the node leaders. The rank of a node is its rank in the leader
+   * communicator. The node and the rank on the node of each rank are stored in CommInfo::rankNodes, two entries per
+   * rank. Without a node communicator, see getCommNodeInfo, every rank is its own node.
+   *
+   * @param[in] comm  The communicator.
+   * @return The information about the communicator.
+   */
+  inline const CommInfo& getCommHierarchyInfo(MPI_Comm comm) {
+    CommInfo& info = const_cast<CommInfo&>(getCommNodeInfo(comm));
+    if(-1 == info.nodeCount) {
+      if(MPI_COMM_NULL != info.nodeComm) {
+        int isLeader = 0 == info.nodeRank;
+        MEDI_CHECK_ERROR(MPI_Comm_split(comm, isLeader ? 0 : MPI_UNDEFINED, info.rank, &info.leaderComm));
+
+        int node[2] = {0, 0};  // node and node count
+        if(isLeader) {
+          MEDI_CHECK_ERROR(MPI_Comm_rank(info.leaderComm, &node[0]));
+          MEDI_CHECK_ERROR(MPI_Comm_size(info.leaderComm, &node[1]));
+        }
+        MEDI_CHECK_ERROR(MPI_Bcast(node, 2, MPI_INT, 0, info.nodeComm));
+        info.nodeCount = node[1];
+
+        int local[2] = {node[0], info.nodeRank};
+        info.rankNodes.resize(2 * info.size);
+        MEDI_CHECK_ERROR(MPI_Allgather(local, 2, MPI_INT, info.rankNodes.data(), 2, MPI_INT, comm));
+      } else {
+        // every rank is its own node
+        info.nodeCount = info.size;
+        info.rankNodes.assign(2 * info.size, 0);
+        for(int i = 0; i < info.size; ++i) {
+          info.rankNodes[2 * i] = i;
+        }
+      }
+    }
+
+    return info;
+  }
+
+  /**
+   * @brief The communicator with the transposed process topology.
+   *
+   * The sources of the transposed topology are the destinations of the original one and vice versa. A neighborhood
+   * collective on the transposed communicator sends the data back along the edges of the original topology, which is
+   * the reverse of a neighborhood collective.
+   *
+   * Cartesian and graph topologies are symmetric, the communicator itself is returned. For distributed graph
+   * topologies the first call for a communicator is collective, it creates the transposed graph with
+   * MPI_Dist_graph_create_adjacent. The ranks are not reordered.
+   *
+   * @param[in] comm  The communicator with a process topology.
+   * @return The communicator with the transposed topology.
+   */
+  inline MPI_Comm getCommTransposed(MPI_Comm comm) {
+    CommInfo& info = const_cast<CommInfo&>(getCommInfo(comm));
+    if(MPI_COMM_NULL == info.transposedComm) {
+#if MEDI_MPI_VERSION_2_2 <= MEDI_MPI_TARGET
+      if(MPI_DIST_GRAPH == info.topology) {
+        // the arrays have at least one element, some implementations do not accept null pointers
+        std::vector<int> sources(info.inDegree + 1);
+        std::vector<int> sourceWeights(info.inDegree + 1, 1);
+        std::vector<int> destinations(info.outDegree + 1);
+        std::vector<int> destinationWeights(info.outDegree + 1, 1);
+        MEDI_CHECK_ERROR(MPI_Dist_graph_neighbors(comm, info.inDegree, sources.data(), sourceWeights.data(),
+                                                  info.outDegree, destinations.data(), destinationWeights.data()));
+
+        // the weights are not required for the transposed communication
+        std::fill(sourceWeights.begin(), sourceWeights.end(), 1);
+        std::fill(destinationWeights.begin(), destinationWeights.end(), 1);
+        MEDI_CHECK_ERROR(MPI_Dist_graph_create_adjacent(comm, info.outDegree, destinations.data(), destinationWeights.data(),
+                                                        info.inDegree, sources.data(), sourceWeights.data(), MPI_INFO_NULL,
+                                                        0, &info.transposedComm));
+      } else
+#endif
+      {
+        info.transposedComm = comm;
+      }
+    }
+
+    return info.transposedComm;
+  }
+
   /**
    * @brief Helper function that gets the own rank number from the communicator.
    * @param[in] comm  The communicator.
    * @return The rank number of this process in the communicator.
    */
   inline int getCommRank(MPI_Comm comm) {
-    int rank;
-    MEDI_CHECK_ERROR(MPI_Comm_rank(comm, &rank));
-
-    return rank;
+    return getCommInfo(comm).rank;
   }
 
   /**
@@ -62,9 +376,76 @@ namespace medi {
    * @return The number of ranks in this communicator.
    */
   inline int getCommSize(MPI_Comm comm) {
-    int size;
-    MEDI_CHECK_ERROR(MPI_Comm_size(comm, &size));
+    return getCommInfo(comm).size;
+  }
 
-    return size;
+  /**
+   * @brief Helper function that gets the own rank number on the node. Collective on the first call, see
+   * getCommNodeInfo.
+   * @param[in] comm  The communicator.
+   * @return The rank number of this process on its node.
+   */
+  inline int getCommNodeRank(MPI_Comm comm) {
+    return getCommNodeInfo(comm).nodeRank;
+  }
+
+  /**
+   * @brief Helper function that gets the number of ranks on the node. Collective on the first call, see
+   * getCommNodeInfo.
+   * @param[in] comm  The communicator.
+   * @return The number of ranks on the node of this process.
+   */
+  inline int getCommNodeSize(MPI_Comm comm) {
+    return getCommNodeInfo(comm).nodeSize;
+  }
+
+  /**
+   * @brief Helper function that gets the number of sources of the process topology.
+   * @param[in] comm  The communicator.
+   * @return The in degree of this process, 0 if the communicator has no topology.
+   */
+  inline int getCommInDegree(MPI_Comm comm) {
+    return getCommInfo(comm).inDegree;
+  }
+
+  /**
+   * @brief Helper function that gets the number of destinations of the process topology.
+   * @param[in] comm  The communicator.
+   * @return The out degree of this process, 0 if the communicator has no topology.
+   */
+  inline int getCommOutDegree(MPI_Comm comm) {
+    return getCommInfo(comm).outDegree;
+  }
+
+  /**
+   * @brief The extent of an MPI data type.
+   *
+   * @param[in] type  The data type.
+   * @return The distance in bytes between two consecutive elements of the type.
+   */
+  inline MPI_Aint getExtent(MPI_Datatype type) {
+    MPI_Aint lowerBound;
+    MPI_Aint extent;
+    MEDI_CHECK_ERROR(MPI_Type_get_extent(type, &lowerBound, &extent));
+
+    return extent;
+  }
+
+  /**
+   * @brief Set the elements of a buffer to zero.
+   *
+   * Neighborhood collectives do not write the blocks of MPI_PROC_NULL neighbors, the receive buffers of the
+   * adjoint and tangent communication are cleared with this function before the communication.
+   *
+   * @param[out]  buf  The buffer.
+   * @param[in] count  The number of elements in the buffer.
+   * @param[in]  type  The data type of the elements, all bits zero needs to represent zero.
+   */
+  inline void setZero(void* buf, int count, MPI_Datatype type) {
+    MPI_Aint extent = getExtent(type);
+
+    if(0 < count) {
+      std::memset(buf, 0, count * extent);
+    }
   }
 }
@@ -29,6 +29,7 @@
 #pragma once
 
 #include "adjointInterface.hpp"
+#include "handleSlab.hpp"
 
 /**
  * @brief Global namespace for MeDiPack - Message Differentiation Package
@@ -63,6 +64,36 @@ namespace medi {
 
 
     virtual ~HandleBase() {}
+
+    /**
+     * @brief Handles that are created without a slab are allocated on the heap.
+     */
+    static void* operator new(size_t size) {
+      return HandleSlab::allocateHeap(size);
+    }
+
+    /**
+     * @brief Create the handle in the slab of an AD tool.
+     */
+    static void* operator new(size_t size, HandleSlab& slab) {
+      return slab.allocate(size);
+    }
+
+    /**
+     * @brief Gives the memory back to the slab or the heap, depending on how the handle was created.
+     */
+    static void operator delete(void* ptr) {
+      HandleSlab::deallocate(ptr);
+    }
+
+    /**
+     * @brief Called if the constructor of a handle that is created in a slab throws.
+     */
+    static void operator delete(void* ptr, HandleSlab& slab) {
+      MEDI_UNUSED(slab);
+
+      HandleSlab::deallocate(ptr);
+    }
   };
 
   // structures for the passive types
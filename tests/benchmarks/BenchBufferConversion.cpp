@@ -0,0 +1,170 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <medi/medi.hpp>
+#include <medi/adToolImplCommon.hpp>
+
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+
+using namespace medi;
+
+/*
+ * Converts the buffers of large messages with the methods of MpiTypeDefault. The first tool only provides the element
+ * wise methods of the StaticADToolInterface, the second one also provides array hooks for the copies of the modified
+ * buffers. The other conversions use the default kernels of ADToolBulkHooks in both cases.
+ */
+
+const int COUNT = 1000000;
+const int REPEATS = 20;
+
+struct Real {
+    double value;
+    int index;
+};
+
+template<typename Impl>
+struct BenchToolBase : public ADToolImplCommon<Impl, true, true, Real, double, double, int> {
+    typedef Real Type;
+    typedef Real ModifiedType;
+    typedef double PrimalType;
+    typedef double AdjointType;
+    typedef int IndexType;
+
+    BenchToolBase() :
+      ADToolImplCommon<Impl, true, true, Real, double, double, int>(MPI_DOUBLE, MPI_DOUBLE) {}
+
+    bool isHandleRequired() const { return true; }
+    void startAssembly(HandleBase* h) const { MEDI_UNUSED(h); }
+    void stopAssembly(HandleBase* h) const { MEDI_UNUSED(h); }
+    void addToolAction(HandleBase* h) const { MEDI_UNUSED(h); }
+    AMPI_Op convertOperator(AMPI_Op op) const { return op; }
+
+    static inline void setIntoModifyBuffer(ModifiedType& modValue, const Type& value) { modValue = value; }
+    static inline void getFromModifyBuffer(const ModifiedType& modValue, Type& value) { value = modValue; }
+    static inline IndexType getIndex(const Type& value) { return value.index; }
+    static inline PrimalType getValue(const Type& value) { return value.value; }
+    static inline void clearIndex(Type& value) { value.index = 0; }
+    static inline void createIndex(Type& value, IndexType& index) { MEDI_UNUSED(value); index = 0; }
+    static inline void registerValue(Type& value, PrimalType& oldPrimal, IndexType& index) {
+      oldPrimal = value.value;
+      index = value.index;
+    }
+};
+
+struct ElementTool : public BenchToolBase<ElementTool> {};
+
+struct BulkTool : public BenchToolBase<BulkTool> {
+    static inline void setIntoModifyBufferArray(ModifiedType* modValues, const Type* values, int count) {
+      std::memcpy(modValues, values, sizeof(Type) * count);
+    }
+
+    static inline void getFromModifyBufferArray(const ModifiedType* modValues, Type* values, int count) {
+      std::memcpy(values, modValues, sizeof(Type) * count);
+    }
+};
+
+template<typename Func>
+double bestTime(Func func) {
+  double time = 1e300;
+  for(int i = 0; i < REPEATS; ++i) {
+    double start = MPI_Wtime();
+    func();
+    time = std::min(time, MPI_Wtime() - start);
+  }
+
+  return time;
+}
+
+void printRate(const char* name, size_t bytes, double time) {
+  std::cout << "  " << name << ": " << (double)bytes / time * 1e-9 << " GB/s" << std::endl;
+}
+
+template<typename Tool>
+void runConversions(const char* toolName) {
+  typedef MpiTypeDefault<Tool> Type;
+
+  MPI_Datatype mpiType;
+  MPI_Type_contiguous(sizeof(Real), MPI_BYTE, &mpiType);
+  MPI_Type_commit(&mpiType);
+
+  Tool tool;
+  Type type(&tool, mpiType, mpiType);
+
+  Real* buf = new Real[COUNT];
+  Real* bufMod = new Real[COUNT];
+  double* primals = new double[COUNT];
+  int* indices = new int[COUNT];
+  for(int i = 0; i < COUNT; ++i) {
+    buf[i].value = i;
+    buf[i].index = i + 1;
+  }
+
+  double timeInto = bestTime([&]() { type.copyIntoModifiedBuffer(buf, 0, bufMod, 0, COUNT); });
+  double timeFrom = bestTime([&]() { type.copyFromModifiedBuffer(buf, 0, bufMod, 0, COUNT); });
+  double timeIndices = bestTime([&]() { type.getIndices(buf, 0, indices, 0, COUNT); });
+  double timeValues = bestTime([&]() { type.getValues(buf, 0, primals, 0, COUNT); });
+  double timeRegister = bestTime([&]() { type.registerValue(buf, 0, indices, primals, 0, COUNT); });
+
+  // use the results such that the conversions are not removed by the compiler
+  double check = 0.0;
+  for(int i = 0; i < COUNT; i += COUNT / 10) {
+    check += bufMod[i].value + primals[i] + indices[i];
+  }
+
+  std::cout << toolName << " (" << COUNT << " elements, check " << check << ")" << std::endl;
+  printRate("copyIntoModifiedBuffer", 2 * sizeof(Real) * COUNT, timeInto);
+  printRate("copyFromModifiedBuffer", 2 * sizeof(Real) * COUNT, timeFrom);
+  printRate("getIndices            ", (sizeof(Real) + sizeof(int)) * COUNT, timeIndices);
+  printRate("getValues             ", (sizeof(Real) + sizeof(double)) * COUNT, timeValues);
+  printRate("registerValue         ", (sizeof(Real) + sizeof(int) + sizeof(double)) * COUNT, timeRegister);
+
+  delete [] indices;
+  delete [] primals;
+  delete [] bufMod;
+  delete [] buf;
+
+  MPI_Type_free(&mpiType);
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  if(0 == rank) {
+    runConversions<ElementTool>("Element wise hooks");
+    runConversions<BulkTool>("Array hooks");
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
@@ -0,0 +1,90 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#include <medi/medi.hpp>
+
+#include <iostream>
+
+using namespace medi;
+
+/*
+ * Queries the size and rank of two communicators in turns, as the generated code does for every call. The first
+ * variant asks MPI for every query, the second one uses the cached communicator information.
+ */
+
+const int QUERIES = 10000000;
+
+template<bool useCache>
+double queryComms(MPI_Comm* comms, int& sum) {
+  double start = MPI_Wtime();
+  for(int i = 0; i < QUERIES; ++i) {
+    MPI_Comm comm = comms[i % 2];
+    int size;
+    int rank;
+    if(useCache) {
+      size = getCommSize(comm);
+      rank = getCommRank(comm);
+    } else {
+      MPI_Comm_size(comm, &size);
+      MPI_Comm_rank(comm, &rank);
+    }
+    sum += size + rank;
+  }
+
+  return MPI_Wtime() - start;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  MPI_Comm comms[2];
+  comms[0] = AMPI_COMM_WORLD;
+  AMPI_Comm_dup(AMPI_COMM_WORLD, &comms[1]);
+
+  int rank = getCommRank(AMPI_COMM_WORLD);
+
+  int sum = 0;
+  double timeMpi = queryComms<false>(comms, sum);
+  double timeCache = queryComms<true>(comms, sum);
+
+  if(0 == rank) {
+    std::cout << "Communicator queries (" << QUERIES << " size and rank pairs on two communicators)" << std::endl;
+    std::cout << "  MPI: " << QUERIES / timeMpi << " queries/s" << std::endl;
+    std::cout << "  cache: " << QUERIES / timeCache << " queries/s" << std::endl;
+    std::cout << "  speedup: " << timeMpi / timeCache << std::endl;
+    std::cout << "  node: rank " << getCommNodeRank(AMPI_COMM_WORLD) << " of " << getCommNodeSize(AMPI_COMM_WORLD)
+              << " (checksum " << sum << ")" << std::endl;
+  } else {
+    getCommNodeRank(AMPI_COMM_WORLD);
+  }
+
+  AMPI_Comm_free(&comms[1]);
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
@@ -0,0 +1,91 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#include <medi/medi.hpp>
+
+#include <iostream>
+
+using namespace medi;
+
+/*
+ * Creates the linearized counts and displacements of 64 ranks with the same counts, as a repeated Alltoallv does
+ * for every call and every evaluation of the handle. The first variant allocates new arrays, the second one uses the
+ * displacement cache.
+ */
+
+const int RANKS = 64;
+const int CALLS = 2000000;
+
+template<bool useCache>
+double createDisplacements(const int* counts, long& sum) {
+  double start = MPI_Wtime();
+  for(int i = 0; i < CALLS; ++i) {
+    int* countsOut;
+    int* displsOut;
+    if(useCache) {
+      acquireLinearDisplacementsAndCount(countsOut, displsOut, counts, RANKS, 1);
+      sum += displsOut[RANKS - 1];
+      releaseLinearDisplacements(displsOut);
+    } else {
+      createLinearDisplacementsAndCount(countsOut, displsOut, counts, RANKS, 1);
+      sum += displsOut[RANKS - 1];
+      delete [] countsOut;
+      delete [] displsOut;
+    }
+  }
+
+  return MPI_Wtime() - start;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  int counts[RANKS];
+  for(int i = 0; i < RANKS; ++i) {
+    counts[i] = i % 7 + 1;
+  }
+
+  long sum = 0;
+  double timeAlloc = createDisplacements<false>(counts, sum);
+  double timeCache = createDisplacements<true>(counts, sum);
+
+  if(0 == rank) {
+    const DisplacementCacheStatistics& stats = getDisplacementCacheStatistics();
+    std::cout << "Linear displacements (" << CALLS << " calls with " << RANKS << " ranks)" << std::endl;
+    std::cout << "  allocation: " << timeAlloc / CALLS * 1e9 << " ns/call" << std::endl;
+    std::cout << "  cache: " << timeCache / CALLS * 1e9 << " ns/call" << std::endl;
+    std::cout << "  speedup: " << timeAlloc / timeCache << std::endl;
+    std::cout << "  hits: " << stats.hits << " misses: " << stats.misses << " (checksum " << sum << ")" << std::endl;
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
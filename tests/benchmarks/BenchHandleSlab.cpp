@@ -0,0 +1,104 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <medi/medi.hpp>
+
+#include <iostream>
+#include <vector>
+
+using namespace medi;
+
+/*
+ * Records the handles of a tape with a mix of point to point and collective handles. The handles are deleted by the
+ * 'AD tool' at the tape reset. The first variant uses the heap for the handles, the second one the slab of the tool.
+ */
+
+typedef AMPI_DOUBLE_Type Type;
+
+const int HANDLES_PER_TAPE = 1000000;
+const int TAPES = 10;
+
+template<bool useSlab>
+double recordTapes(HandleSlab& slab) {
+  std::vector<HandleBase*> tape;
+  tape.reserve(HANDLES_PER_TAPE);
+
+  double start = MPI_Wtime();
+  for(int curTape = 0; curTape < TAPES; ++curTape) {
+    for(int i = 0; i < HANDLES_PER_TAPE; ++i) {
+      HandleBase* h;
+      if(0 == i % 4) {
+        if(useSlab) {
+          h = new (slab) AMPI_Alltoallv_AdjointHandle<Type, Type>();
+        } else {
+          h = new AMPI_Alltoallv_AdjointHandle<Type, Type>();
+        }
+      } else {
+        if(useSlab) {
+          h = new (slab) AMPI_Send_AdjointHandle<Type>();
+        } else {
+          h = new AMPI_Send_AdjointHandle<Type>();
+        }
+      }
+      tape.push_back(h);
+    }
+
+    for(HandleBase* h : tape) {
+      delete h;
+    }
+    tape.clear();
+    slab.reset();
+  }
+
+  return MPI_Wtime() - start;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  HandleSlab& slab = AMPI_DOUBLE->getADTool().getHandleSlab();
+
+  double timeHeap = recordTapes<false>(slab);
+  double timeSlab = recordTapes<true>(slab);
+
+  if(0 == rank) {
+    double handles = (double)HANDLES_PER_TAPE * (double)TAPES;
+    std::cout << "Handle recording (" << TAPES << " tapes with " << HANDLES_PER_TAPE << " handles)" << std::endl;
+    std::cout << "  heap: " << handles / timeHeap << " handles/s" << std::endl;
+    std::cout << "  slab: " << handles / timeSlab << " handles/s" << std::endl;
+    std::cout << "  speedup: " << timeHeap / timeSlab << std::endl;
+    std::cout << "  slab memory: " << slab.getStats().bytesReserved << " bytes" << std::endl;
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
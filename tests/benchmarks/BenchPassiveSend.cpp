@@ -0,0 +1,102 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <medi/medi.hpp>
+
+#include <algorithm>
+#include <iostream>
+
+using namespace medi;
+
+
+/*
+ * Ping pong of small messages between rank 0 and 1. The first variant uses MPI_Send and MPI_Recv, the second one
+ * AMPI_Send and AMPI_Recv with the passive type AMPI_DOUBLE. Since the traits of the passive type are known at compile
+ * time, both variants should show the same message rate.
+ */
+
+const int MESSAGES = 200000;
+const int COUNT = 4;
+const int REPEATS = 5;
+
+template<bool useAmpi>
+double pingPong(int rank) {
+  double buf[COUNT] = {};
+  int partner = 1 - rank;
+
+  double start = MPI_Wtime();
+  for(int i = 0; i < MESSAGES; ++i) {
+    if(useAmpi) {
+      if(0 == rank) {
+        AMPI_Send(buf, COUNT, AMPI_DOUBLE, partner, 0, AMPI_COMM_WORLD);
+        AMPI_Recv(buf, COUNT, AMPI_DOUBLE, partner, 0, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+      } else {
+        AMPI_Recv(buf, COUNT, AMPI_DOUBLE, partner, 0, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+        AMPI_Send(buf, COUNT, AMPI_DOUBLE, partner, 0, AMPI_COMM_WORLD);
+      }
+    } else {
+      if(0 == rank) {
+        MPI_Send(buf, COUNT, MPI_DOUBLE, partner, 0, MPI_COMM_WORLD);
+        MPI_Recv(buf, COUNT, MPI_DOUBLE, partner, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+      } else {
+        MPI_Recv(buf, COUNT, MPI_DOUBLE, partner, 0, MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+        MPI_Send(buf, COUNT, MPI_DOUBLE, partner, 0, MPI_COMM_WORLD);
+      }
+    }
+  }
+
+  return MPI_Wtime() - start;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  // take the best time of the repeats, the variants are interleaved to reduce the influence of the system noise
+  double timeMpi = 1e300;
+  double timeAmpi = 1e300;
+  if(rank < 2) {
+    for(int i = 0; i < REPEATS; ++i) {
+      timeMpi = std::min(timeMpi, pingPong<false>(rank));
+      timeAmpi = std::min(timeAmpi, pingPong<true>(rank));
+    }
+  }
+
+  if(0 == rank) {
+    std::cout << "Passive send (" << MESSAGES << " round trips with " << COUNT << " doubles)" << std::endl;
+    std::cout << "  MPI_Send:  " << MESSAGES / timeMpi << " round trips/s" << std::endl;
+    std::cout << "  AMPI_Send: " << MESSAGES / timeAmpi << " round trips/s" << std::endl;
+    std::cout << "  overhead: " << (timeAmpi / timeMpi - 1.0) * 100.0 << " %" << std::endl;
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
@@ -0,0 +1,123 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#include <medi/medi.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace medi;
+
+/*
+ * Replays the reverse communication of a tape with 32 nonblocking messages from rank 1 to rank 0 several times, as
+ * for multiple right hand sides. Each message has its own reverse request like the handles on the tape. The first
+ * variant posts new requests for every evaluation, the second one starts the persistent requests which are created
+ * in the first evaluation.
+ */
+
+const int MESSAGES = 32;
+const int EVALUATIONS = 2000;
+const int REPEATS = 5;
+
+double evaluate(int rank, bool persistent, int count, std::vector<AMPI_Request>& requests,
+                std::vector<double>& adjoints) {
+  setPersistentReverseRequests(persistent);
+  int partner = 1 - rank;
+
+  double start = MPI_Wtime();
+  for(int e = 0; e < EVALUATIONS; ++e) {
+    for(int i = 0; i < MESSAGES; ++i) {
+      if(0 == rank) {
+        irecvAdjoints(&adjoints[i * count], count, MPI_DOUBLE, partner, i, AMPI_COMM_WORLD, &requests[i]);
+      } else {
+        isendAdjoints(&adjoints[i * count], count, MPI_DOUBLE, partner, i, AMPI_COMM_WORLD, &requests[i]);
+      }
+    }
+    for(int i = 0; i < MESSAGES; ++i) {
+      waitReverse(&requests[i]);
+    }
+  }
+  double time = MPI_Wtime() - start;
+
+  setPersistentReverseRequests(false);
+  return time;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  const int counts[] = {8, 4096};
+
+  for(int c = 0; c < 2; ++c) {
+    int count = counts[c];
+    std::vector<double> adjoints(MESSAGES * count);
+    double times[2] = {1e300, 1e300};
+    bool correct = true;
+
+    if(rank < 2) {
+      // the reverse requests are kept over all evaluations, like the handles of a tape
+      std::vector<AMPI_Request> requests(MESSAGES);
+      for(int r = 0; r < REPEATS; ++r) {
+        for(int p = 0; p < 2; ++p) {
+          for(int i = 0; i < MESSAGES * count; ++i) {
+            adjoints[i] = 1 == rank ? (double)(i + r + p) : 0.0;
+          }
+          times[p] = std::min(times[p], evaluate(rank, 1 == p, count, requests, adjoints));
+          for(int i = 0; i < MESSAGES * count; ++i) {
+            correct &= adjoints[i] == (double)(i + r + p);
+          }
+        }
+      }
+
+      for(int i = 0; i < MESSAGES; ++i) {
+        requests[i].deletePersistentData();
+      }
+    }
+
+    if(0 == rank) {
+      double perMessage = 1e6 / ((double)EVALUATIONS * MESSAGES);
+      std::cout << "Reverse requests (" << MESSAGES << " messages with " << count << " doubles, " << EVALUATIONS
+                << " evaluations)" << std::endl;
+      std::cout << "  new requests:        " << times[0] * perMessage << " us/message" << std::endl;
+      std::cout << "  persistent requests: " << times[1] * perMessage << " us/message" << std::endl;
+      std::cout << "  speedup: " << times[0] / times[1] << (correct ? "" : " (wrong adjoints)") << std::endl;
+    }
+  }
+
+  if(0 == rank) {
+    const PersistentReverseStatistics& stats = getPersistentReverseStatistics();
+    std::cout << "Persistent requests created: " << stats.created << ", started: " << stats.started << std::endl;
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
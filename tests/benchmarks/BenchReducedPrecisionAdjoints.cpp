@@ -0,0 +1,108 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <medi/medi.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+using namespace medi;
+
+
+/*
+ * Exchange of the adjoints of the reverse point to point communication between rank 0 and 1 with the full, single
+ * and bfloat16 precision. The bytes on the wire are reduced by the factor two and four, the conversion error is
+ * reported by the statistics of the adjoint precision.
+ */
+
+const int COUNT = 1 << 20;
+const int MESSAGES = 20;
+const int REPEATS = 5;
+
+double exchange(int rank, AdjointPrecision precision, std::vector<double>& adjoints) {
+  setAdjointPrecision(AMPI_COMM_WORLD, precision);
+  int partner = 1 - rank;
+
+  double start = MPI_Wtime();
+  for(int i = 0; i < MESSAGES; ++i) {
+    if(0 == rank) {
+      sendAdjoints(adjoints.data(), COUNT, MPI_DOUBLE, partner, 0, AMPI_COMM_WORLD);
+    } else {
+      recvAdjoints(adjoints.data(), COUNT, MPI_DOUBLE, partner, 0, AMPI_COMM_WORLD);
+    }
+  }
+  double time = MPI_Wtime() - start;
+
+  setAdjointPrecision(AMPI_COMM_WORLD, AdjointPrecision::Default);
+  return time;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  std::vector<double> adjoints(COUNT);
+  for(int i = 0; i < COUNT; ++i) {
+    adjoints[i] = std::sin((double)i) * 1e3;
+  }
+
+  const AdjointPrecision precisions[] = {AdjointPrecision::Full, AdjointPrecision::Float, AdjointPrecision::BFloat16};
+  const char* names[] = {"full:     ", "float:    ", "bfloat16: "};
+  double times[3] = {1e300, 1e300, 1e300};
+  AdjointPrecisionStatistics stats[3];
+
+  // take the best time of the repeats, the variants are interleaved to reduce the influence of the system noise
+  if(rank < 2) {
+    for(int r = 0; r < REPEATS; ++r) {
+      for(int p = 0; p < 3; ++p) {
+        resetAdjointPrecisionStatistics();
+        times[p] = std::min(times[p], exchange(rank, precisions[p], adjoints));
+        stats[p] = getAdjointPrecisionStatistics();
+      }
+    }
+  }
+
+  if(0 == rank) {
+    double denseBytes = (double)MESSAGES * COUNT * sizeof(double);
+    std::cout << "Reduced precision adjoints (" << MESSAGES << " messages with " << COUNT << " doubles)" << std::endl;
+    for(int p = 0; p < 3; ++p) {
+      double sentBytes = denseBytes - (double)stats[p].savedBytes;
+      std::cout << "  " << names[p] << sentBytes / times[p] * 1e-9 << " GB/s on the wire, "
+                << denseBytes / times[p] * 1e-9 << " GB/s of adjoints, max rel. error " << stats[p].maxRelError
+                << std::endl;
+    }
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
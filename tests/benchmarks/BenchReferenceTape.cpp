@@ -0,0 +1,149 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <medi/medi.hpp>
+#include <medi/adToolReference.hpp>
+
+#include <algorithm>
+#include <iostream>
+#include <vector>
+
+using namespace medi;
+
+/*
+ * Measures the overhead of MeDiPack for active point to point messages with the reference AD tool. Ranks 0 and 1
+ * exchange the squares of their inputs several times with Sendrecv and sum up the received values. The time of the
+ * same exchange with doubles is compared to the recording and the reverse evaluation of the tape.
+ */
+
+typedef reference::Real Real;
+
+const int MESSAGES = 64;
+const int TAPES = 200;
+const int REPEATS = 5;
+
+double passiveExchange(int partner, int count, std::vector<double>& send, std::vector<double>& recv) {
+  double start = MPI_Wtime();
+  for(int t = 0; t < TAPES; ++t) {
+    for(int m = 0; m < MESSAGES; ++m) {
+      MPI_Sendrecv(send.data(), count, MPI_DOUBLE, partner, m, recv.data(), count, MPI_DOUBLE, partner, m,
+                   MPI_COMM_WORLD, MPI_STATUS_IGNORE);
+    }
+  }
+
+  return MPI_Wtime() - start;
+}
+
+void activeExchange(reference::Tool* tool, int rank, int count, double& recordTime, double& reverseTime,
+                    bool& correct) {
+  int partner = 1 - rank;
+  reference::Tape& tape = Real::getGlobalTape();
+  std::vector<Real> x(count), send(count), recv(count);
+
+  recordTime = 0.0;
+  reverseTime = 0.0;
+  for(int t = 0; t < TAPES; ++t) {
+    double start = MPI_Wtime();
+    for(int i = 0; i < count; ++i) {
+      x[i] = 1.0 + rank + i;
+      tape.registerInput(x[i]);
+      send[i] = x[i] * x[i];
+    }
+
+    Real y = 0.0;
+    for(int m = 0; m < MESSAGES; ++m) {
+      AMPI_Sendrecv(send.data(), count, tool->MPI_TYPE, partner, m, recv.data(), count, tool->MPI_TYPE, partner, m,
+                    AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+      for(int i = 0; i < count; ++i) {
+        y += recv[i];
+      }
+    }
+    tape.registerOutput(y);
+    double middle = MPI_Wtime();
+
+    tape.gradient(y.getGradientData()) = 1.0;
+    tape.evaluate();
+    double end = MPI_Wtime();
+
+    // the partner receives each square in every message
+    for(int i = 0; i < count; ++i) {
+      correct &= tape.gradient(x[i].getGradientData()) == 2.0 * MESSAGES * x[i].getValue();
+    }
+    tape.reset();
+
+    recordTime += middle - start;
+    reverseTime += end - middle;
+  }
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  reference::Tool* tool = new reference::Tool();
+  Real::getGlobalTape().setActive();
+
+  const int counts[] = {1, 1024};
+
+  for(int c = 0; c < 2; ++c) {
+    int count = counts[c];
+    double times[3] = {1e300, 1e300, 1e300};
+    bool correct = true;
+
+    if(rank < 2) {
+      std::vector<double> send(count, 1.0), recv(count);
+      for(int r = 0; r < REPEATS; ++r) {
+        double recordTime;
+        double reverseTime;
+        times[0] = std::min(times[0], passiveExchange(1 - rank, count, send, recv));
+        activeExchange(tool, rank, count, recordTime, reverseTime, correct);
+        times[1] = std::min(times[1], recordTime);
+        times[2] = std::min(times[2], reverseTime);
+      }
+    }
+
+    if(0 == rank) {
+      double perMessage = 1e6 / ((double)TAPES * MESSAGES);
+      std::cout << "Reference tape Sendrecv (" << MESSAGES << " messages with " << count << " values, " << TAPES
+                << " tapes)" << std::endl;
+      std::cout << "  MPI doubles: " << times[0] * perMessage << " us/message" << std::endl;
+      std::cout << "  record:      " << times[1] * perMessage << " us/message" << std::endl;
+      std::cout << "  reverse:     " << times[2] * perMessage << " us/message"
+                << (correct ? "" : " (wrong adjoints)") << std::endl;
+    }
+  }
+
+  Real::getGlobalTape().setPassive();
+  delete tool;
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
@@ -0,0 +1,120 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#include <medi/medi.hpp>
+
+#include <iostream>
+#include <vector>
+
+using namespace medi;
+
+/*
+ * Polls 1000 outstanding receives with Testsome, none of them completes during the polling. The first variant calls
+ * MPI_Testsome on a plain MPI_Request array and is the lower bound. The second one converts the requests into a new
+ * array for every call, the third one is AMPI_Testsome which uses the conversion buffer.
+ */
+
+const int REQUESTS = 1000;
+const int POLLS = 50000;
+
+enum class Variant {
+  Mpi,
+  Allocation,
+  Buffer
+};
+
+template<Variant variant>
+double pollRequests(std::vector<AMPI_Request>& requests) {
+  std::vector<int> indices(REQUESTS);
+  std::vector<MPI_Request> plain(REQUESTS);
+  for(int j = 0; j < REQUESTS; ++j) {
+    plain[j] = requests[j].request;
+  }
+  int outcount = 0;
+
+  double start = MPI_Wtime();
+  for(int i = 0; i < POLLS; ++i) {
+    if(Variant::Mpi == variant) {
+      MPI_Testsome(REQUESTS, plain.data(), &outcount, indices.data(), MPI_STATUSES_IGNORE);
+    } else if(Variant::Buffer == variant) {
+      AMPI_Testsome(REQUESTS, requests.data(), &outcount, indices.data(), AMPI_STATUSES_IGNORE);
+    } else {
+      MPI_Request* array = new MPI_Request[REQUESTS];
+      for(int j = 0; j < REQUESTS; ++j) {
+        array[j] = requests[j].request;
+      }
+      MPI_Testsome(REQUESTS, array, &outcount, indices.data(), MPI_STATUSES_IGNORE);
+      delete [] array;
+    }
+  }
+
+  return MPI_Wtime() - start;
+}
+
+int main(int nargs, char** args) {
+  AMPI_Init(&nargs, &args);
+
+  int rank;
+  AMPI_Comm_rank(AMPI_COMM_WORLD, &rank);
+
+  std::vector<int> buffer(REQUESTS);
+  std::vector<AMPI_Request> requests(REQUESTS);
+
+  double timeMpi = 0.0;
+  double timeAlloc = 0.0;
+  double timeBuffer = 0.0;
+  if(0 == rank) {
+    for(int i = 0; i < REQUESTS; ++i) {
+      AMPI_Irecv(&buffer[i], 1, AMPI_INT, 1, i, AMPI_COMM_WORLD, &requests[i]);
+    }
+
+    timeMpi = pollRequests<Variant::Mpi>(requests);
+    timeAlloc = pollRequests<Variant::Allocation>(requests);
+    timeBuffer = pollRequests<Variant::Buffer>(requests);
+  }
+
+  AMPI_Barrier(AMPI_COMM_WORLD);
+
+  if(0 == rank) {
+    AMPI_Waitall(REQUESTS, requests.data(), AMPI_STATUSES_IGNORE);
+
+    std::cout << "Testsome polling (" << REQUESTS << " outstanding requests, " << POLLS << " polls)" << std::endl;
+    std::cout << "  MPI: " << timeMpi / POLLS * 1e6 << " us/poll" << std::endl;
+    std::cout << "  allocation: " << timeAlloc / POLLS * 1e6 << " us/poll" << std::endl;
+    std::cout << "  buffer: " << timeBuffer / POLLS * 1e6 << " us/poll" << std::endl;
+    std::cout << "  conversion overhead: allocation " << (timeAlloc - timeMpi) / POLLS * 1e6 << " us/poll, buffer "
+              << (timeBuffer - timeMpi) / POLLS * 1e6 << " us/poll" << std::endl;
+  } else {
+    for(int i = 0; i < REQUESTS; ++i) {
+      AMPI_Send(&buffer[i], 1, AMPI_INT, 0, i, AMPI_COMM_WORLD);
+    }
+  }
+
+  AMPI_Finalize();
+}
+
+#include <medi/medi.cpp>
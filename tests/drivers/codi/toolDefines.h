@@ -52,6 +52,7 @@ typedef CODI_TYPE NUMBER;
 
 #define TOOL_TYPE CoDiMpiTypes<NUMBER>
 #define TOOL codiTypes
+#define AD_TOOL_TYPE TOOL_TYPE::Tool
 
 extern TOOL_TYPE* codiTypes;
 
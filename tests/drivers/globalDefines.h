@@ -26,17 +26,22 @@
  * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
  */
 
+// The number of processes of the test, the tests in the directories ranks<n> define it before the tool is included.
+#ifndef TEST_RANKS
+# define TEST_RANKS 2
+#endif
+
 #define POINTS(number) \
   int getEvalPointsCount() {return number;} \
-  extern double points[number][2][in_count]; \
+  extern double points[number][TEST_RANKS][in_count]; \
   double getEvalPoint(int point, int rank, int col) { return points[point][rank][col]; } \
-  double points[number][2][in_count]
+  double points[number][TEST_RANKS][in_count]
 
 #define SEEDS(number) \
   int getEvalSeedCount() {return number;} \
-  extern double seeds[number][2][out_count]; \
+  extern double seeds[number][TEST_RANKS][out_count]; \
   double getEvalSeed(int point, int rank, int col) { return seeds[point][rank][col]; } \
-  double seeds[number][2][out_count]
+  double seeds[number][TEST_RANKS][out_count]
 
 #define IN(number) \
   const int in_count = number; \
@@ -0,0 +1,70 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <medi/medi.hpp>
+#include <medi/adToolReference.hpp>
+
+typedef medi::reference::Real NUMBER;
+
+#ifndef VECTOR
+# define VECTOR 0
+#endif
+
+#ifndef UNTYPED
+# define UNTYPED 0
+#endif
+
+#ifndef FORWARD_TAPE
+# define FORWARD_TAPE 0
+#endif
+
+#ifndef PRIMAL_TAPE
+# define PRIMAL_TAPE 0
+#endif
+
+#ifndef MODIFIED_BUFFER
+# define MODIFIED_BUFFER false
+#endif
+
+#define TOOL_TYPE medi::reference::ToolImpl<MODIFIED_BUFFER>
+#define TOOL referenceTool
+#define AD_TOOL_TYPE TOOL_TYPE
+
+extern TOOL_TYPE* referenceTool;
+
+#include "../globalDefines.h"
+
+#if UNTYPED
+  #undef mpiNumberType
+  #undef mpiNumberIntType
+
+  #define mpiNumberType ((medi::MpiTypeInterface*)TOOL->MPI_TYPE)
+  #define mpiNumberIntType ((medi::MpiTypeInterface*)TOOL->MPI_INT_TYPE)
+#endif
@@ -0,0 +1,63 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {101.0, 102.0, 103.0, 104.0, 105.0, 106.0, 107.0, 108.0, 109.0, 110.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  // rank 0 sends to rank 1 and to itself, rank 1 sends only to rank 0
+  int sources[2][2] = {{0, 1}, {0, -1}};
+  int destinations[2][2] = {{1, 0}, {0, -1}};
+  int degrees[2] = {2, 1};
+  AMPI_Comm comm;
+  medi::AMPI_Dist_graph_create_adjacent(AMPI_COMM_WORLD, degrees[world_rank], sources[world_rank], MPI_UNWEIGHTED,
+                                        degrees[world_rank], destinations[world_rank], MPI_UNWEIGHTED, AMPI_INFO_NULL, 0,
+                                        &comm);
+
+  // rank 1 receives only one block
+  if(1 == world_rank) {
+    for(int i = 5; i < 10; ++i) {
+      y[i] = x[i];
+    }
+  }
+
+  medi::AMPI_Neighbor_allgather(x, 5, mpiNumberType, y, 5, mpiNumberType, comm);
+
+  for(int i = 0; i < 10; ++i) {
+    y[i] *= x[i];
+  }
+}
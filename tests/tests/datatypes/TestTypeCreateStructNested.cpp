@@ -0,0 +1,109 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+#include <cstddef>
+
+IN(12)
+OUT(12)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0, 21.0, 22.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0, 11.0, 12.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0, 21.0, 22.0}}};
+
+struct Inner {
+  NUMBER x;
+  char c;
+  NUMBER y;
+};
+
+struct Outer {
+  int a;
+  Inner in[2];
+  NUMBER g;
+};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+
+  int innerLength[3] = {1, 1, 1};
+  AMPI_Aint innerOffsets[3] = {offsetof(Inner, x), offsetof(Inner, c), offsetof(Inner, y)};
+  const medi::AMPI_Datatype innerTypes[3] = {mpiNumberType, medi::AMPI_CHAR, mpiNumberType};
+  medi::AMPI_Datatype innerType;
+  medi::AMPI_Type_create_struct(3, innerLength, innerOffsets, innerTypes, &innerType);
+
+  int outerLength[3] = {1, 2, 1};
+  AMPI_Aint outerOffsets[3] = {offsetof(Outer, a), offsetof(Outer, in), offsetof(Outer, g)};
+  const medi::AMPI_Datatype outerTypes[3] = {medi::AMPI_INT, innerType, mpiNumberType};
+  medi::AMPI_Datatype outerType;
+  medi::AMPI_Type_create_struct(3, outerLength, outerOffsets, outerTypes, &outerType);
+  medi::AMPI_Type_commit(&outerType);
+
+  medi::AMPI_Datatype contType;
+  medi::AMPI_Type_create_contiguous(3, mpiNumberType, &contType);
+  medi::AMPI_Type_commit(&contType);
+
+  Outer data[2];
+  NUMBER cont[2][3];
+
+  if(world_rank == 0) {
+    size_t offset = 0;
+    for(int i = 0; i < 2; ++i) {
+      data[i].a = i + 1;
+      data[i].in[0].x = x[offset++];
+      data[i].in[0].c = 'a';
+      data[i].in[0].y = x[offset++];
+      data[i].in[1].x = x[offset++] * x[0];
+      data[i].in[1].c = 'b';
+      data[i].in[1].y = x[offset++];
+      data[i].g = x[offset++];
+    }
+    for(int i = 0; i < 2; ++i) {
+      cont[i][0] = x[10 + i];
+      cont[i][1] = x[10 + i] * x[1];
+      cont[i][2] = x[i];
+    }
+    medi::AMPI_Send(data, 2, outerType, 1, 42, AMPI_COMM_WORLD);
+    medi::AMPI_Send(&cont[0][0], 2, contType, 1, 43, AMPI_COMM_WORLD);
+  } else {
+    medi::AMPI_Recv(data, 2, outerType, 0, 42, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+    medi::AMPI_Recv(&cont[0][0], 2, contType, 0, 43, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+
+    size_t offset = 0;
+    for(int i = 0; i < 2; ++i) {
+      y[offset++] = data[i].in[0].x;
+      y[offset++] = data[i].in[0].y;
+      y[offset++] = data[i].in[1].x;
+      y[offset++] = data[i].in[1].y * (double)data[i].a;
+      y[offset++] = data[i].g * (double)(data[i].in[1].c - 'a' + 1);
+    }
+    y[10] = cont[0][0] + cont[1][2];
+    y[11] = cont[1][1] * cont[0][1] + cont[1][0];
+  }
+
+  // We do not free the types here since they are required for the reverse evaluation
+}
@@ -0,0 +1,61 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <toolDefines.h>
+
+/*
+ * A sum operator with a specialized adjoint handling. Reductions with this operator use the global MPI reductions
+ * instead of the gather and local reduce of the default operators.
+ */
+
+inline void unmodifiedAdd(NUMBER* invec, NUMBER* inoutvec, int* len, MPI_Datatype* datatype) {
+  MEDI_UNUSED(datatype);
+
+  for(int i = 0; i < *len; ++i) {
+    inoutvec[i] += invec[i];
+  }
+}
+
+inline void modifiedAdd(AD_TOOL_TYPE::ModifiedType* invec, AD_TOOL_TYPE::ModifiedType* inoutvec, int* len, MPI_Datatype* datatype) {
+  MEDI_UNUSED(datatype);
+
+  for(int i = 0; i < *len; ++i) {
+    AD_TOOL_TYPE::modifyDependency(invec[i], inoutvec[i]);
+    AD_TOOL_TYPE::setPrimalToMod(inoutvec[i], AD_TOOL_TYPE::getPrimalFromMod(invec[i]) + AD_TOOL_TYPE::getPrimalFromMod(inoutvec[i]));
+  }
+}
+
+inline void createAdjointSumOperator(medi::AMPI_Op* op) {
+  medi::AMPI_Op_create(false, false,
+                       (MPI_User_function*)unmodifiedAdd, 1,
+                       (MPI_User_function*)modifiedAdd, 1,
+                       medi::noPreAdjointOperation, medi::noPostAdjointOperation,
+                       op);
+}
@@ -0,0 +1,69 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  medi::setReverseAggregation(true);
+
+  // one message per element with different tags, the receives are started in the reverse order
+  int partner = 1 - world_rank;
+  NUMBER send[10];
+  NUMBER recv[10];
+  medi::AMPI_Request requests[20];
+  for(int i = 0; i < 10; ++i) {
+    send[i] = x[i] * (double)(i + 1);
+    medi::AMPI_Isend(&send[i], 1, mpiNumberType, partner, i, AMPI_COMM_WORLD, &requests[i]);
+  }
+  for(int i = 9; i >= 0; --i) {
+    medi::AMPI_Irecv(&recv[i], 1, mpiNumberType, partner, i, AMPI_COMM_WORLD, &requests[10 + i]);
+  }
+  medi::AMPI_Waitall(20, requests, AMPI_STATUSES_IGNORE);
+
+  // a blocking exchange with the same tag goes through the same transfers
+  NUMBER pair[2];
+  NUMBER pairRecv[2];
+  pair[0] = x[0] * x[1];
+  pair[1] = x[2];
+  medi::AMPI_Sendrecv(pair, 2, mpiNumberType, partner, 0, pairRecv, 2, mpiNumberType, partner, 0, AMPI_COMM_WORLD,
+                      AMPI_STATUS_IGNORE);
+
+  for(int i = 0; i < 10; ++i) {
+    y[i] = recv[i] * x[i] + pairRecv[i % 2];
+  }
+}
@@ -0,0 +1,71 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+#include <toolDefines.h>
+
+IN(10)
+OUT(10)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0, 7.0, 8.0, 9.0, 10.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0, 17.0, 18.0, 19.0, 20.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  medi::setPersistentReverseRequests(true);
+
+  int partner = 1 - world_rank;
+  NUMBER send[10];
+  NUMBER recv[10];
+  medi::AMPI_Request requests[2];
+  for(int i = 0; i < 10; ++i) {
+    send[i] = x[i] * (double)(i + 1);
+  }
+  medi::AMPI_Isend(send, 10, mpiNumberType, partner, 42, AMPI_COMM_WORLD, &requests[0]);
+  medi::AMPI_Irecv(recv, 10, mpiNumberType, partner, 42, AMPI_COMM_WORLD, &requests[1]);
+  medi::AMPI_Waitall(2, requests, AMPI_STATUSES_IGNORE);
+
+  // each start of the persistent primal requests creates new handles with their own reverse requests
+  NUMBER sendInit[5];
+  NUMBER recvInit[5];
+  medi::AMPI_Send_init(sendInit, 5, mpiNumberType, partner, 43, AMPI_COMM_WORLD, &requests[0]);
+  medi::AMPI_Recv_init(recvInit, 5, mpiNumberType, partner, 43, AMPI_COMM_WORLD, &requests[1]);
+  for(int j = 0; j < 2; ++j) {
+    for(int i = 0; i < 5; ++i) {
+      sendInit[i] = recv[5 * j + i] * x[5 * j + i];
+    }
+    medi::AMPI_Startall(2, requests);
+    medi::AMPI_Waitall(2, requests, AMPI_STATUSES_IGNORE);
+    for(int i = 0; i < 5; ++i) {
+      y[5 * j + i] = recvInit[i] + recv[5 * j + i];
+    }
+  }
+  medi::AMPI_Request_free(&requests[0]);
+  medi::AMPI_Request_free(&requests[1]);
+}
@@ -0,0 +1,66 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#define TEST_RANKS 3
+#include <toolDefines.h>
+
+IN(5)
+OUT(5)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0}, {2.0, 3.0, 4.0, 5.0, 6.0}, {3.0, 4.0, 5.0, 6.0, 7.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0}, {10.0, 20.0, 30.0, 40.0, 50.0}, {100.0, 200.0, 300.0, 400.0, 500.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  medi::setLocalReduceAlgorithm(medi::LocalReduceAlgorithm::Tree);
+
+  // a user message with the tag of the tree reduction is in flight during the reduction
+  NUMBER sendbuf[5];
+  medi::AMPI_Request request;
+  if(0 == world_rank) {
+    for(int i = 0; i < 5; ++i) {
+      sendbuf[i] = 2.0 * x[i];
+    }
+    medi::AMPI_Isend(sendbuf, 5, mpiNumberType, 1, MEDI_TreeReduceTag, AMPI_COMM_WORLD, &request);
+  }
+
+  medi::AMPI_Allreduce(x, y, 5, mpiNumberType, medi::AMPI_PROD, AMPI_COMM_WORLD);
+
+  if(0 == world_rank) {
+    medi::AMPI_Wait(&request, AMPI_STATUS_IGNORE);
+  } else if(1 == world_rank) {
+    NUMBER recvbuf[5];
+    medi::AMPI_Recv(recvbuf, 5, mpiNumberType, 0, MEDI_TreeReduceTag, AMPI_COMM_WORLD, AMPI_STATUS_IGNORE);
+    for(int i = 0; i < 5; ++i) {
+      y[i] += recvbuf[i];
+    }
+  }
+}
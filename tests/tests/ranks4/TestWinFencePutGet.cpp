@@ -0,0 +1,71 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#define TEST_RANKS 4
+#include <toolDefines.h>
+#include "nodeHierarchy.h"
+
+IN(6)
+OUT(6)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0}, {21.0, 22.0, 23.0, 24.0, 25.0, 26.0}, {31.0, 32.0, 33.0, 34.0, 35.0, 36.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, {10.0, 20.0, 30.0, 40.0, 50.0, 60.0}, {100.0, 200.0, 300.0, 400.0, 500.0, 600.0}, {1000.0, 2000.0, 3000.0, 4000.0, 5000.0, 6000.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  AMPI_Comm comm = createTwoNodeComm();
+
+  int rank;
+  medi::AMPI_Comm_rank(comm, &rank);
+
+  int neighbor = rank ^ 1;       // on the same node
+  int next = (rank + 1) % 4;     // on the same node for the even ranks
+  int remote = (rank + 2) % 4;   // on the other node
+
+  NUMBER buf[4];
+  for(int i = 0; i < 4; ++i) {
+    buf[i] = x[i];
+  }
+
+  AMPI_Win win;
+  medi::AMPI_Win_create(buf, 4 * sizeof(NUMBER), sizeof(NUMBER), mpiNumberType, AMPI_INFO_NULL, comm, &win);
+
+  if(!medi::isWinTargetDirect(win, neighbor) || medi::isWinTargetDirect(win, remote)) {
+    MEDI_EXCEPTION("Only the ranks on the same node are accessed directly.");
+  }
+
+  medi::AMPI_Win_fence(0, win);
+  medi::AMPI_Put(&x[4], 2, mpiNumberType, next, 0, 2, mpiNumberType, win);
+  medi::AMPI_Get(&y[0], 1, mpiNumberType, neighbor, 2, 1, mpiNumberType, win);
+  medi::AMPI_Get(&y[1], 1, mpiNumberType, remote, 3, 1, mpiNumberType, win);
+  medi::AMPI_Win_fence(0, win);
+
+  for(int i = 0; i < 4; ++i) {
+    y[i + 2] = 2.0 * buf[i];
+  }
+
+  medi::AMPI_Win_free(&win);
+}
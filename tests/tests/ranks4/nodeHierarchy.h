@@ -0,0 +1,59 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#pragma once
+
+#include <toolDefines.h>
+
+/*
+ * Duplicate of MPI_COMM_WORLD with two nodes of two ranks each. The node information is created for the duplicate, so
+ * the split applies to it and to its duplicate for the replay.
+ */
+inline AMPI_Comm createTwoNodeComm() {
+  medi::setNodeSplitSize(2);
+
+  AMPI_Comm comm;
+  medi::AMPI_Comm_dup(AMPI_COMM_WORLD, &comm);
+
+  return comm;
+}
+
+/*
+ * Two nodes with the node hierarchy for all message sizes.
+ */
+inline AMPI_Comm createNodeHierarchyComm() {
+  medi::setCollectiveHierarchy(medi::CollectiveHierarchy::Node);
+
+  AMPI_Comm comm = createTwoNodeComm();
+
+  if(!medi::isCollectiveHierarchyUsed(comm, 1, MPI_DOUBLE)) {
+    MEDI_EXCEPTION("The node hierarchy is not used.");
+  }
+
+  return comm;
+}
@@ -0,0 +1,62 @@
+/*
+ * MeDiPack, a Message Differentiation Package
+ *
+ * Copyright (C) 2017-2020 Chair for Scientific Computing (SciComp), TU Kaiserslautern
+ * Homepage: http://www.scicomp.uni-kl.de
+ * Contact:  Prof. Nicolas R. Gauger (codi@scicomp.uni-kl.de)
+ *
+ * Lead developers: Max Sagebaum (SciComp, TU Kaiserslautern)
+ *
+ * This file is part of MeDiPack (http://www.scicomp.uni-kl.de/software/codi).
+ *
+ * MeDiPack is free software: you can redistribute it and/or
+ * modify it under the terms of the GNU General Public License
+ * as published by the Free Software Foundation, either version 3 of the
+ * License, or (at your option) any later version.
+ *
+ * MeDiPack is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty
+ * of MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.
+ *
+ * See the GNU General Public License for more details.
+ * You should have received a copy of the GNU
+ * General Public License along with MeDiPack.
+ * If not, see <http://www.gnu.org/licenses/>.
+ *
+ * Authors: Max Sagebaum, Tim Albring (SciComp, TU Kaiserslautern)
+ */
+
+#include <toolDefines.h>
+
+IN(6)
+OUT(6)
+POINTS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0}}};
+SEEDS(1) = {{{1.0, 2.0, 3.0, 4.0, 5.0, 6.0}, {11.0, 12.0, 13.0, 14.0, 15.0, 16.0}}};
+
+void func(NUMBER* x, NUMBER* y) {
+  int world_rank;
+  medi::AMPI_Comm_rank(AMPI_COMM_WORLD, &world_rank);
+  int world_size;
+  medi::AMPI_Comm_size(AMPI_COMM_WORLD, &world_size);
+
+  int other = (world_rank + 1) % world_size;
+
+  NUMBER buf[4];
+  for(int i = 0; i < 4; ++i) {
+    buf[i] = x[i];
+  }
+
+  AMPI_Win win;
+  medi::AMPI_Win_create(buf, 4 * sizeof(NUMBER), sizeof(NUMBER), mpiNumberType, AMPI_INFO_NULL, AMPI_COMM_WORLD, &win);
+
+  medi::AMPI_Win_fence(0, win);
+  medi::AMPI_Put(&x[4], 2, mpiNumberType, other, 0, 2, mpiNumberType, win);
+  medi::AMPI_Get(y, 2, mpiNumberType, other, 2, 2, mpiNumberType, win);
+  medi::AMPI_Win_fence(0, win);
+
+  for(int i = 0; i < 4; ++i) {
+    y[i + 2] = 2.0 * buf[i];
+  }
+
+  medi::AMPI_Win_free(&win);
+}